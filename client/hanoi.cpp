@@ -14,10 +14,11 @@ void Hanoi::updateSelectedPeg(int delta) {
     updateSelectionVisuals();
 }
 
-int Hanoi::parseDiscSize(const std::string& name) {
+int Hanoi::parseDiscSize(std::string_view name) {
     // Disco1 = grande, Disco7 = piccolo
-    if (name.rfind("Disco", 0) != 0) return 0;
-    int n = std::atoi(name.c_str() + 5);
+    if (name.substr(0, 5) != "Disco") return 0;
+    int n = 0;
+    std::from_chars(name.data() + 5, name.data() + name.size(), n);
     if (n <= 0) return 0;
     return 8 - n; // Disco1 -> 7 (grande), Disco7 -> 1 (piccolo)
 }
@@ -27,7 +28,7 @@ void Hanoi::placeDisc(DiscState& disc, int pegIdx, int stackIdx) {
     pos.y = baseLevelY + stackStepY * static_cast<float>(stackIdx);
     glm::mat4 m = disc.baseTransform;
     m[3] = glm::vec4(pos, 1.0f); // sostituisce solo la traslazione, mantiene scala/rotazione
-    disc.node->setM(m);
+    if (Node* node = disc.node.get()) node->setM(m);
 }
 
 void Hanoi::updateHeldDiscVisual(float t) {
@@ -40,7 +41,7 @@ void Hanoi::updateHeldDiscVisual(float t) {
     pos.y = baseLevelY + stackStepY * static_cast<float>(topIdx) + lift + bob;
     glm::mat4 m = heldDisc->baseTransform;
     m[3] = glm::vec4(pos, 1.0f);
-    heldDisc->node->setM(m);
+    if (Node* node = heldDisc->node.get()) node->setM(m);
 }
 
 void Hanoi::buildCameraPresets() {
@@ -55,13 +56,17 @@ void Hanoi::buildCameraPresets() {
     camPresets[3] = center + glm::vec3(-dist, dist * 0.3f, -dist);   // isometrica opposta
 }
 
-void Hanoi::applyCameraPreset(int idx) {
-    if (idx < 0 || idx >= (int)camPresets.size()) return;
+glm::mat4 Hanoi::getCameraPresetMatrix(int idx) const {
+    if (idx < 0 || idx >= (int)camPresets.size()) return glm::mat4(1.0f);
     glm::vec3 pos = camPresets[idx];
     glm::vec3 up = (idx == 2) ? glm::vec3(0, 0, -1) : glm::vec3(0, 1, 0); // top-down senza rollare
     glm::mat4 view = glm::lookAt(pos, camTargetCenter, up);
-    glm::mat4 world = glm::inverse(view);
-    camera->setM(world);
+    return glm::inverse(view);
+}
+
+void Hanoi::applyCameraPreset(int idx) {
+    if (idx < 0 || idx >= (int)camPresets.size()) return;
+    camera->setM(getCameraPresetMatrix(idx));
 }
 
 void Hanoi::updateSelectionVisuals() {
@@ -72,20 +77,20 @@ void Hanoi::updateSelectionVisuals() {
     glm::vec3 pegPos = pegPositions[selectedPeg];
 
     // 1. Sposta la Luce (Spot001)
-    if (selectionSpot) {
-        glm::mat4 m = selectionSpot->getM();
+    if (Node* spot = selectionSpot.get()) {
+        glm::mat4 m = spot->getM();
         // Modifichiamo solo X e Z, lasciando Y (altezza) invariata
         m[3][0] = pegPos.x;
         m[3][2] = pegPos.z;
-        selectionSpot->setM(m);
+        spot->setM(m);
     }
 
     // 2. Sposta la Piramide (Pyramid001)
-    if (selectionPyramid) {
-        glm::mat4 m = selectionPyramid->getM();
+    if (Node* pyramid = selectionPyramid.get()) {
+        glm::mat4 m = pyramid->getM();
         m[3][0] = pegPos.x;
         m[3][2] = pegPos.z;
-        selectionPyramid->setM(m);
+        pyramid->setM(m);
     }
 }
 
@@ -115,11 +120,10 @@ void Hanoi::initHanoiState(Node* root) {
 
     // Trova dischi
     std::vector<DiscState> discs;
-    for (int i = 1; i <= 7; ++i) {
-        std::string name = "Disco" + std::to_string(i);
-        Node* d = root->findByName(name);
-        if (!d) continue;
-        DiscState ds{ d, parseDiscSize(name), d->getM() };
+    for (Node* d : root->findMatching("Disco?")) {
+        int size = parseDiscSize(d->getName());
+        if (size <= 0) continue;
+        DiscState ds{ Handle<Node>(d), size, d->getM() };
         discs.push_back(ds);
     }
 
@@ -182,8 +186,8 @@ void Hanoi::initHanoiState(Node* root) {
     selectedPeg = pegMax;
     heldDisc.reset();
 
-    selectionSpot = root->findByName("Spot001");
-    selectionPyramid = root->findByName("Pyramid001");
+    selectionSpot = Handle<Node>(root->findByName("Spot001"));
+    selectionPyramid = Handle<Node>(root->findByName("Pyramid001"));
 
     // Aggiorna subito la posizione iniziale
     updateSelectionVisuals();
@@ -242,43 +246,49 @@ void Hanoi::specialCallback(int key, int x, int y) {
     }
 }
 
-void Hanoi::checkBoundaries() {
-    if (!camera) return;
+void Hanoi::clickNode(Node* node) {
+    if (isWon || !node) return;
 
-    float y_lower_bound = 5.0f;
-    glm::mat4 mat = camera->getM();
-    glm::vec3 pos = glm::vec3(mat[3]);
-    bool collision = false;
+    // Solo pioli e dischi: il resto della scena non cambia la selezione
+    std::string_view name = node->getName();
+    if (name.substr(0, 4) != "Palo" && name.substr(0, 5) != "Disco") return;
 
-    if (pos.x > MAP_LIMIT) {
-        pos.x = MAP_LIMIT;
-        collision = true;
-    }
-    else if (pos.x < -MAP_LIMIT) {
-        pos.x = -MAP_LIMIT;
-        collision = true;
+    // Piolo piu' vicino (XZ) all'oggetto cliccato: un disco sta sempre sopra il proprio piolo
+    glm::vec3 pos = glm::vec3(node->getWorldFinalMatrix()[3]);
+    int bestPeg = 0;
+    float bestDist = std::numeric_limits<float>::max();
+    for (int p = 0; p < 3; ++p) {
+        float dist = glm::length(glm::vec2(pos.x - pegPositions[p].x, pos.z - pegPositions[p].z));
+        if (dist < bestDist) {
+            bestDist = dist;
+            bestPeg = p;
+        }
     }
 
-    if (pos.y > MAP_LIMIT) {
-        pos.y = MAP_LIMIT;
-        collision = true;
-    }
-    else if (pos.y < y_lower_bound) {
-        pos.y = y_lower_bound;
-        collision = true;
-    }
+    selectedPeg = bestPeg;
+    updateSelectionVisuals();
+    if (heldDisc.has_value()) dropDisc();
+    else pickupDisc();
+}
 
-    if (pos.z > MAP_LIMIT) {
-        pos.z = MAP_LIMIT;
-        collision = true;
-    }
-    else if (pos.z < -MAP_LIMIT) {
-        pos.z = -MAP_LIMIT;
-        collision = true;
+void Hanoi::checkBoundaries(const BoundingBox& sceneBounds) {
+    if (!camera) return;
+
+    float y_lower_bound = 5.0f;
+    glm::vec3 lower(-MAP_LIMIT, y_lower_bound, -MAP_LIMIT);
+    glm::vec3 upper(MAP_LIMIT);
+    if (!sceneBounds.isEmpty()) {
+        lower = sceneBounds.getMin() - glm::vec3(CAMERA_MARGIN);
+        upper = sceneBounds.getMax() + glm::vec3(CAMERA_MARGIN);
+        lower.y = y_lower_bound;
     }
 
-    if (collision) {
-        mat[3][0] = pos.x; mat[3][1] = pos.y; mat[3][2] = pos.z;
+    glm::mat4 mat = camera->getM();
+    glm::vec3 pos = glm::vec3(mat[3]);
+    glm::vec3 clamped = glm::clamp(pos, lower, upper);
+
+    if (clamped != pos) {
+        mat[3][0] = clamped.x; mat[3][1] = clamped.y; mat[3][2] = clamped.z;
         camera->setM(mat);
     }
 }
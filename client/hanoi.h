@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <optional>
 #include <iostream>
 #include <algorithm>
@@ -11,17 +13,22 @@
 
 #include "ovoReader.h"
 #include "engine.h"
+#include "handle.h"
+#include "boundingBox.h"
 
 
 // Costanti
-const float MAP_LIMIT = 50.0f; 
+const float MAP_LIMIT = 50.0f; // limiti della camera se la scena non ha mesh
+const float CAMERA_MARGIN = 30.0f; // distanza massima della camera dalla scatola della scena
 const int KEY_LEFT = 100;      
 const int KEY_RIGHT = 102;
 const int KEY_UP = 101;
 const int KEY_DOWN = 103;
+const int MOUSE_LEFT_BUTTON = 0;
+const int MOUSE_DOWN = 0;
 
 struct DiscState {
-    Node* node;
+    Handle<Node> node; // diventa nullo se la scena viene distrutta
     int sizeRank;
     glm::mat4 baseTransform;
 };
@@ -44,8 +51,11 @@ public:
     void initHanoiState(Node* root);
     void updateHeldDiscVisual(float t);
     void specialCallback(int key, int x, int y);
-    void checkBoundaries();
+    void clickNode(Node* node); // oggetto colpito dal click del mouse
+    void checkBoundaries(const BoundingBox& sceneBounds);
     void applyCameraPreset(int idx);
+    glm::mat4 getCameraPresetMatrix(int idx) const; // matrice mondo della camera del preset
+    int getNumCameraPresets() const { return (int)camPresets.size(); }
 
     // Getters / Setters utili
     bool isGameWon() const { return isWon; }
@@ -75,8 +85,8 @@ private:
     float baseLevelY = 0.0f;
     float stackStepY = 0.0f;
 
-    Node* selectionSpot = nullptr;
-    Node* selectionPyramid = nullptr;
+    Handle<Node> selectionSpot;
+    Handle<Node> selectionPyramid;
 
     std::vector<glm::vec3> camPresets;
 
@@ -87,7 +97,7 @@ private:
 
     // Metodi di logica interna
     void updateSelectedPeg(int delta);
-    int parseDiscSize(const std::string& name);
+    int parseDiscSize(std::string_view name);
     void placeDisc(DiscState& disc, int pegIdx, int stackIdx);
     void buildCameraPresets();
     void updateSelectionVisuals();
@@ -10,6 +10,11 @@
 #include "omnidirectionalLight.h"
 #include "ovoReader.h"
 #include "perspectiveCamera.h"
+#include "commandBuffer.h"
+#include "transformHierarchy.h"
+#include "scene.h"
+#include "handle.h"
+#include "bvh.h"
 
 #include "hanoi.h"
 
@@ -23,16 +28,16 @@
 #include <cmath>
 #include <array>
 #include <iomanip>
+#include <chrono>
 
 // --- GLOBALI ---
 Eng::Base* engine;
 Camera* camera;
 List* list;
-List* reflectionList = nullptr;
-std::vector<Node*> reflectionNodesCache;
 Node* root;
+Scene* scene = nullptr; // possiede tutti gli oggetti caricati da tavolo.ovo
 OvoReader ovoreader{};
-Node* tavoloNode;
+Handle<Node> tavoloNode;
 
 // Istanza della logica di gioco
 Hanoi* hanoiGame = nullptr;
@@ -40,15 +45,105 @@ Hanoi* hanoiGame = nullptr;
 glm::mat4 mainCameraHome{ 1.0f };
 bool isRotationMode = false; // false = MUOVI, true = RUOTA
 bool isPresetView = false;   // true quando si è in una delle telecamere fisse
+// Anteprime dei preset sopra la vista principale (stessa lista del frame, un culling per vista)
+const int numPreviews = 4;
+PerspectiveCamera* previewCameras[numPreviews] = {};
+bool showPreviews = false;
+
+// Cattura di un frame per misurare il solo invio dei comandi
+CommandBuffer frameCapture;
+bool captureRequested = false;
+
+// Matrici mondo della scena aggiornate in blocco (i nodi restano l'interfaccia per muoverli)
+TransformHierarchy sceneTransforms;
+Bvh sceneBvh; // mesh della scena, per il picking e i limiti della camera
+bool useIdPicking = false; // true = picking letto dal buffer degli id sulla GPU
+FramePacer::Mode framePacing = FramePacer::Mode::ON_DEMAND; // a scena ferma non si ridisegna
+
+// Salva il frame catturato e ne misura la riproduzione con entrambi i backend
+void reportFrameCapture() {
+   const int runs = 100;
+   frameCapture.detach();
+   frameCapture.save("frame.ecmd");
+
+   std::cout << "[Capture] " << frameCapture.getNumCommands() << " comandi, "
+             << frameCapture.getNumMeshes() << " mesh, " << frameCapture.getSizeInBytes() << " byte -> frame.ecmd" << std::endl;
+
+   const CommandBuffer::Backend backends[] = { CommandBuffer::Backend::IMMEDIATE, CommandBuffer::Backend::VERTEX_ARRAY };
+   const char* names[] = { "immediate", "vertex array" };
+   for (int b = 0; b < 2; b++) {
+      CommandBuffer::Stats stats;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; i++) stats = frameCapture.replay(backends[b]);
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "[Capture] " << names[b] << ": " << std::fixed << std::setprecision(3)
+                << elapsed.count() / runs << " ms/frame (" << stats.drawCalls << " draw, "
+                << stats.triangles << " triangoli)" << std::endl;
+   }
+}
+
+// ==== HUD ====
+// Righe del menu e messaggi creati una volta: a ogni frame si aggiornano solo le righe che cambiano
+Hud::TextHandle modeText, pickingText, pacingText, pipelineText, previewText, winText, restartText;
+
+void createHud() {
+    Hud& hud = engine->getHud();
+    const char* menu[] = {
+        "",
+        "[M] Cambia Modalita' | [P] Camera principale | [ESC] Esci",
+        "Freccia SX/DX: cambia piolo",
+        "Freccia SU: prendi disco",
+        "Freccia GIU: lascia",
+        "Click: prendi/lascia sul piolo",
+        "",
+        "[R] Reset | [U] Undo | [Y] Redo",
+        "[1-4] Camera Presets | [C] Cattura frame",
+        "[O] Profiler | [T] Salva trace (profiler_trace.json)",
+        "",
+        "",
+        "",
+    };
+    const int numLines = sizeof(menu) / sizeof(menu[0]);
+    Hud::TextHandle lines[numLines];
+    for (int i = 0; i < numLines; i++)
+        lines[i] = hud.createText(menu[i], 0.0f, -12.0f * (i + 1), Hud::Anchor::TOP_LEFT);
+    modeText = lines[0];
+    pickingText = lines[6];
+    pacingText = lines[numLines - 3];
+    pipelineText = lines[numLines - 2];
+    previewText = lines[numLines - 1];
+
+    // Vittoria: nascosta finche' la partita non e' vinta
+    winText = hud.createText("HAI VINTO!", 0.0f, 0.0f, Hud::Anchor::CENTER, TextRenderer::Font::TIMES_ROMAN_24,
+                             glm::vec4(0.2f, 1.0f, 0.2f, 1.0f)); // Verde Lime
+    restartText = hud.createText("Premi [R] per ricominciare", 0.0f, -30.0f, Hud::Anchor::CENTER, TextRenderer::Font::TIMES_ROMAN_24);
+    hud.setVisible(winText, false);
+    hud.setVisible(restartText, false);
+}
 
-void drawCenteredText(std::string text, float yOffset, float r, float g, float b) {
-    int winW = engine->getWindowWidth();
-    int winH = engine->getWindowHeight();
-    int textWidth = engine->getTextWidth(text);
+// setText() e setVisible() non fanno nulla se il valore non cambia
+void updateHud() {
+    Hud& hud = engine->getHud();
+    hud.setText(modeText, isRotationMode ? "MODALITA': ROTAZIONE (WASD)" : "MODALITA': MOVIMENTO (WASD)");
 
-    float x = (winW - textWidth) / 2.0f;
-    float y = (winH / 2.0f) + yOffset;
-    engine->addString(x, y, text, r, g, b);
+    if (!engine->isIdPickingSupported())
+        hud.setText(pickingText, "[I] Picking: raggio (GPU non disponibile)");
+    else
+        hud.setText(pickingText, useIdPicking ? "[I] Picking: buffer degli id (GPU)" : "[I] Picking: raggio");
+
+    switch (engine->getFramePacing()) {
+    case FramePacer::Mode::CONTINUOUS: hud.setText(pacingText, "[F] Frame: continui"); break;
+    case FramePacer::Mode::VSYNC:      hud.setText(pacingText, "[F] Frame: vsync"); break;
+    case FramePacer::Mode::FIXED_FPS:  hud.setText(pacingText, "[F] Frame: max 30 FPS"); break;
+    case FramePacer::Mode::ON_DEMAND:  hud.setText(pacingText, "[F] Frame: su richiesta"); break;
+    }
+
+    hud.setText(pipelineText, engine->isPipelined() ? "[G] Pipeline: simulazione in parallelo" : "[G] Pipeline: disattivata");
+    hud.setText(previewText, showPreviews ? "[V] Anteprime camere: visibili" : "[V] Anteprime camere: nascoste");
+
+    bool won = hanoiGame && hanoiGame->isGameWon();
+    hud.setVisible(winText, won);
+    hud.setVisible(restartText, won);
 }
 
 void specialCallback(int key, int x, int y) {
@@ -58,79 +153,134 @@ void specialCallback(int key, int x, int y) {
     }
 }
 
-glm::mat4 getReflectionMatrix(float planeHeight) {
-   glm::mat4 mat(1.0f);
-   // 1. Sposta al piano
-   mat = glm::translate(mat, glm::vec3(0.0f, planeHeight, 0.0f));
-   // 2. Specchia l'asse Y
-   mat = glm::scale(mat, glm::vec3(1.0f, -1.0f, 1.0f));
-   // 3. Sposta indietro
-   mat = glm::translate(mat, glm::vec3(0.0f, -planeHeight, 0.0f));
+void mouseCallback(int button, int state, int x, int y) {
+    if (!hanoiGame || button != MOUSE_LEFT_BUTTON || state != MOUSE_DOWN) return;
+
+    // Click su un piolo o su un disco: lo seleziona e prende o posa il disco
+    if (useIdPicking && engine->requestPick(x, y, [](Node* node) {
+            if (hanoiGame && node) hanoiGame->clickNode(node);
+            engine->postRedisplay();
+        })) {
+        engine->postRedisplay();
+        return;
+    }
+    Bvh::PickHit hit;
+    if (engine->pick(sceneBvh, x, y, hit)) {
+        hanoiGame->clickNode(hit.mesh);
+    }
+    engine->postRedisplay();
+}
+
+// Dichiara il piano del tavolo come specchio: l'engine riflette da solo gli oggetti sopra di esso
+void setupTableReflection(Node* sceneRoot) {
+   const float tableHeight = 16.5f;
 
-   return mat;
+   Mesh* table = dynamic_cast<Mesh*>(sceneRoot->findByName("base_tavolo"));
+   if (!table) return;
+
+   // Piano y = tableHeight espresso nello spazio locale del tavolo
+   glm::vec4 worldPlane(0.0f, 1.0f, 0.0f, -tableHeight);
+   table->setReflectionPlane(glm::transpose(table->getWorldFinalMatrix()) * worldPlane);
 }
 
+// Fase dell'oscillazione del disco in mano, avanzata a passo fisso (0.5 ogni 1/60 di secondo)
+float discPhase = 0.0f;
+float previousDiscPhase = 0.0f;
 
-void displayCallback() {
-    static float angle = 0.0f;
-    angle += 0.5f;
+void updateCallback(double step) {
+    previousDiscPhase = discPhase;
+    discPhase += 30.0f * (float)step;
+}
+
+// Scena del frame: in modalita' pipeline gira sul thread di simulazione, un frame in anticipo
+void buildScene(List& target) {
+    // Stato interpolato tra gli ultimi due passi: il moto resta fluido a qualunque FPS
+    float angle = previousDiscPhase + (discPhase - previousDiscPhase) * engine->getInterpolationAlpha();
 
     // Aggiorna animazione disco in mano (hover + bobbing)
     if (hanoiGame) {
         hanoiGame->updateHeldDiscVisual(angle);
     }
+    // Le mesh spostate (es. il disco in mano) aggiornano le proprie foglie
+    sceneBvh.refit();
 
-    // Preparazione lista di rendering
-    list->clear();
-    list->pass(root, glm::mat4(1.0f));
+    // Nodi e matrici mondo dagli array della gerarchia (aggiornati in blocco), divisi tra i
+    // thread del pool del motore quando la scena e' abbastanza grande
+    target.passParallel(sceneTransforms);
+}
 
-    engine->setRenderList(list);
-    engine->setMainCamera(camera);
+// Mostra o nasconde le anteprime dei preset, in colonna sul lato destro della finestra
+void setPreviews(bool show) {
+    showPreviews = show;
+    engine->clearViews();
+    if (!show || !hanoiGame) return;
+    for (int i = 0; i < numPreviews && i < hanoiGame->getNumCameraPresets(); i++) {
+        previewCameras[i]->setM(hanoiGame->getCameraPresetMatrix(i));
+        engine->addView(previewCameras[i], 0.8f, 0.01f + 0.2f * i, 0.19f, 0.19f);
+    }
+}
 
-    engine->clearScreenText();
+// Asse di movimento da una coppia di tasti: +1, -1 o 0
+float keyAxis(unsigned char positive, unsigned char negative) {
+    const InputQueue& input = engine->getInput();
+    return (input.isKeyDown(positive) || input.wasKeyPressed(positive) ? 1.0f : 0.0f)
+         - (input.isKeyDown(negative) || input.wasKeyPressed(negative) ? 1.0f : 0.0f);
+}
 
-    // ==== MENU ====
-    if (isRotationMode)
-        engine->addToScreenText("MODALITA': ROTAZIONE (WASD)");
-    else
-        engine->addToScreenText("MODALITA': MOVIMENTO (WASD)");
-
-    engine->addToScreenText("[M] Cambia Modalita' | [P] Camera principale | [ESC] Esci");
-    engine->addToScreenText("Freccia SX/DX: cambia piolo");
-    engine->addToScreenText("Freccia SU: prendi disco");
-    engine->addToScreenText("Freccia GIU: lascia");
-    engine->addToScreenText("[R] Reset | [U] Undo | [Y] Redo");
-    engine->addToScreenText("[1-4] Camera Presets");
-
-    // ==== VITTORIA ====
-    if (hanoiGame && hanoiGame->isGameWon()) {
-        drawCenteredText("HAI VINTO!", 0.0f, 0.2f, 1.0f, 0.2f); // Verde Lime
-        drawCenteredText("Premi [R] per ricominciare", -30.0f, 1.0f, 1.0f, 1.0f); // Bianco
+// Movimento / rotazione (WASD, QE) dallo stato dei tasti: un solo passo per frame, proporzionale
+// al tempo del frame invece che alla frequenza di ripetizione della tastiera. Restituisce true se
+// un tasto di movimento e' premuto
+bool moveCamera() {
+    const float moveSpeed = 30.0f; // unita' al secondo
+    const float rotSpeed = 60.0f;  // gradi al secondo
+    if (isPresetView) return false;
+
+    glm::vec3 axis(keyAxis('d', 'a'), keyAxis('q', 'e'), keyAxis('s', 'w'));
+    if (axis == glm::vec3(0.0f)) return false;
+
+    // Ripartendo da fermi il frame dura zero: il primo passo vale un frame a 60 FPS
+    float dt = (float)engine->getFrameTime();
+    if (dt <= 0.0f) dt = 1.0f / 60.0f;
+    if (isRotationMode) {
+        if (axis.z != 0.0f) camera->rotate(-axis.z * rotSpeed * dt, glm::vec3(1, 0, 0));
+        if (axis.x != 0.0f) camera->rotate(-axis.x * rotSpeed * dt, glm::vec3(0, 1, 0));
+        if (axis.y != 0.0f) camera->rotate(axis.y * rotSpeed * dt, glm::vec3(0, 0, 1));
+    } else {
+        camera->translate(axis * moveSpeed * dt);
+        // Evita alla camera di poter uscire dalla scena
+        if (hanoiGame) hanoiGame->checkBoundaries(sceneBvh.getBounds());
     }
+    return true;
+}
 
-    if(reflectionList) {
-       reflectionList->clear();
-
-       float tableHeight = 16.5f;
-       glm::mat4 reflectMat = getReflectionMatrix(tableHeight);
+void displayCallback() {
+    // Il disco in mano oscilla e i tasti di movimento premuti spostano la camera: servono frame anche senza input
+    bool moving = moveCamera();
+    engine->setAnimating(moving || (hanoiGame && hanoiGame->hasHeldDisc()));
+    engine->setMainCamera(camera);
+    updateHud();
 
-       // USIAMO LA CACHE 
-       for (Node* node : reflectionNodesCache) {
-          if (node) {
-             reflectionList->pass(node, reflectMat);
-          }
-       }
+    // In pipeline la lista arriva gia' pronta da buildScene()
+    if (engine->isPipelined()) return;
 
-       engine->setReflectionList(reflectionList);
+    // Il frame precedente e' stato registrato: lo si analizza e si smette di registrare
+    if (list->getCommandBuffer()) {
+        list->setCommandBuffer(nullptr);
+        reportFrameCapture();
+    }
+    if (captureRequested) {
+        captureRequested = false;
+        list->setCommandBuffer(&frameCapture);
+        engine->postRedisplay(); // la cattura si conclude al frame successivo
     }
 
-    engine->postRedisplay();
+    // Preparazione lista di rendering
+    list->clear();
+    buildScene(*list);
+    engine->setRenderList(list);
 }
 
 void keyboardCallback(unsigned char key, int x, int y) {
-    float moveSpeed = 1.0f;
-    float rotSpeed = 2.0f;
-
     switch (key) {
     case 'm': case 'M':
         isRotationMode = !isRotationMode;
@@ -144,38 +294,6 @@ void keyboardCallback(unsigned char key, int x, int y) {
         std::cout << "Camera principale attiva (mobile)" << std::endl;
         break;
 
-        // --- MOVIMENTO / ROTAZIONE (WASD) ---
-    case 'w':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(rotSpeed, glm::vec3(1, 0, 0));
-        else                camera->translate(glm::vec3(0, 0, -moveSpeed));
-        break;
-    case 's':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(-rotSpeed, glm::vec3(1, 0, 0));
-        else                camera->translate(glm::vec3(0, 0, moveSpeed));
-        break;
-    case 'a':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(rotSpeed, glm::vec3(0, 1, 0));
-        else                camera->translate(glm::vec3(-moveSpeed, 0, 0));
-        break;
-    case 'd':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(-rotSpeed, glm::vec3(0, 1, 0));
-        else                camera->translate(glm::vec3(moveSpeed, 0, 0));
-        break;
-    case 'q':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(rotSpeed, glm::vec3(0, 0, 1));
-        else                camera->translate(glm::vec3(0, moveSpeed, 0));
-        break;
-    case 'e':
-        if (isPresetView) break;
-        if (isRotationMode) camera->rotate(-rotSpeed, glm::vec3(0, 0, 1));
-        else                camera->translate(glm::vec3(0, -moveSpeed, 0));
-        break;
-
         // --- TELECAMERE FISSE ---
     case '1': if (hanoiGame) hanoiGame->applyCameraPreset(0); isPresetView = true; break;
     case '2': if (hanoiGame) hanoiGame->applyCameraPreset(1); isPresetView = true; break;
@@ -186,18 +304,26 @@ void keyboardCallback(unsigned char key, int x, int y) {
     {
         std::cout << "[GAME] Ricaricamento livello..." << std::endl;
 
-        // Pulizia vecchia scena
-        if (root) {
-            root->removeChild(camera);
-            delete root;
-            root = nullptr;
+        // Una cattura in corso punta alle mesh che stanno per essere distrutte
+        if (list->getCommandBuffer()) {
+            list->setCommandBuffer(nullptr);
+            frameCapture.clear();
         }
 
+        // Pulizia vecchia scena: nodi, mesh, materiali e texture vengono liberati in blocco
+        // (la camera, che non appartiene alla scena, viene solo staccata)
+        delete scene;
+        scene = nullptr;
+        root = nullptr;
+        // In pipeline la lista gia' costruita punta ancora ai nodi appena distrutti
+        engine->invalidateSnapshot();
+
         // Caricamento nuova scena
-        tavoloNode = ovoreader.readFile("tavolo.ovo", "texture/");
+        scene = ovoreader.loadScene("tavolo.ovo", "texture/");
+        tavoloNode = Handle<Node>(scene ? scene->getRoot() : nullptr);
 
         if (tavoloNode) {
-            root = tavoloNode;
+            root = tavoloNode.get();
             root->addChild(camera);
 
 
@@ -210,32 +336,10 @@ void keyboardCallback(unsigned char key, int x, int y) {
             hanoiGame = new Hanoi(camera, engine);
             hanoiGame->initHanoiState(root);
 
-            reflectionNodesCache.clear();
-
-            // Cache Base
-            Node* baseNode = root->findByName("Base");
-            if (baseNode) reflectionNodesCache.push_back(baseNode);
-
-            // Cache Pali
-            for (int i = 1; i <= 3; i++) {
-               Node* palo = root->findByName("Palo" + std::to_string(i));
-               if (palo) reflectionNodesCache.push_back(palo);
-            }
-
-            // Cache Dischi
-            for (int i = 1; i <= 7; i++) {
-               Node* disco = root->findByName("Disco" + std::to_string(i));
-               if (disco) reflectionNodesCache.push_back(disco);
-            }
-
-            // Cache Luci
-            for (int i = 1; i <= 5; i++) {
-               Node* luce = root->findByName("Omni00" + std::to_string(i));
-               if (luce) reflectionNodesCache.push_back(luce);
-            }
-
-
-
+            setupTableReflection(root);
+            sceneTransforms.build(root);
+            sceneBvh.build(root);
+            setPreviews(showPreviews);
         }
         else {
             std::cerr << "[ERROR] Impossibile ricaricare il file .ovo!" << std::endl;
@@ -256,16 +360,54 @@ void keyboardCallback(unsigned char key, int x, int y) {
         }
         break;
 
+    case 'c': case 'C':
+        // La cattura registra la lista del client, che in pipeline non viene disegnata
+        if (engine->isPipelined())
+            std::cout << "[Capture] Disattiva la pipeline ([G]) per catturare un frame" << std::endl;
+        else
+            captureRequested = true;
+        break;
+
+    case 'g': case 'G':
+        engine->setPipelined(!engine->isPipelined());
+        break;
+
+    case 'v': case 'V':
+        setPreviews(!showPreviews);
+        break;
+
+    case 'i': case 'I':
+        useIdPicking = !useIdPicking;
+        break;
+
+    case 'o': case 'O':
+        engine->setProfiling(!engine->isProfiling());
+        break;
+    case 't': case 'T':
+        if (engine->saveProfilerTrace("profiler_trace.json"))
+            std::cout << "[Profiler] Trace salvata in profiler_trace.json (chrome://tracing)" << std::endl;
+        break;
+
+    case 'f': case 'F':
+        // Su richiesta -> continui -> vsync -> 30 FPS -> su richiesta
+        switch (engine->getFramePacing()) {
+        case FramePacer::Mode::ON_DEMAND:  framePacing = FramePacer::Mode::CONTINUOUS; break;
+        case FramePacer::Mode::CONTINUOUS: framePacing = FramePacer::Mode::VSYNC; break;
+        case FramePacer::Mode::VSYNC:      framePacing = FramePacer::Mode::FIXED_FPS; break;
+        default:                           framePacing = FramePacer::Mode::ON_DEMAND; break;
+        }
+        engine->setFramePacing(framePacing, 30.0f);
+        break;
+
     case 27:
+        // free() salva anche le statistiche dei tempi di frame richieste con --stats
+        delete scene;
+        scene = nullptr;
+        engine->free();
         if (hanoiGame) delete hanoiGame;
         exit(0);
         break;
     }
-
-    // Evita alla camera di poter uscire dalla scena
-    if (!isRotationMode && hanoiGame) {
-        hanoiGame->checkBoundaries();
-    }
     engine->postRedisplay();
 }
 
@@ -275,6 +417,9 @@ void reshapeCallback(int width, int height) {
     if (pCam) {
         pCam->setAspectRatio((float)width, (float)height);
     }
+    // I riquadri delle anteprime hanno le stesse proporzioni della finestra
+    for (PerspectiveCamera* preview : previewCameras)
+        if (preview) preview->setAspectRatio((float)width, (float)height);
 }
 
 // per debuggare 
@@ -301,19 +446,56 @@ void printSceneGraphWithPosition(Node* node, int level = 0) {
 int main(int argc, char* argv[]) {
     // --- INIZIO ---
 
+    // --headless <frame> [prefisso]: disegna i frame senza finestra e li salva (benchmark e confronti su CI)
+    int headlessFrames = 0;
+    std::string dumpPrefix;
+    if (argc >= 3 && std::string(argv[1]) == "--headless") {
+        headlessFrames = std::max(1, std::atoi(argv[2]));
+        if (argc >= 4 && std::string(argv[3]).rfind("--", 0) != 0) dumpPrefix = argv[3];
+    }
+    // --stats <file>: all'uscita salva min, media, percentili e massimo dei tempi di frame (JSON)
+    // --pipelined: simulazione e costruzione della lista su un thread separato dal rendering
+    // --previews: anteprime dei quattro preset sopra la vista principale
+    std::string statsPath;
+    bool pipelined = false;
+    bool previews = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--stats" && i + 1 < argc) statsPath = argv[i + 1];
+        if (std::string(argv[i]) == "--pipelined") pipelined = true;
+        if (std::string(argv[i]) == "--previews") previews = true;
+    }
+
     engine = &Eng::Base::getInstance();
     if (!engine->init(argc, argv)) return -1;
+    if (!statsPath.empty()) engine->setFrameTimeReport(statsPath);
 
-    engine->createWindow(800, 600, 100, 100, "Tower of Hanoi");
+    if (headlessFrames > 0) {
+        if (!engine->createOffscreen(800, 600)) {
+            std::cerr << "Errore: contesto fuori schermo non disponibile" << std::endl;
+            return -1;
+        }
+    }
+    else {
+        engine->createWindow(800, 600, 100, 100, "Tower of Hanoi");
+    }
     engine->enableFPS();
+    createHud();
+    engine->setFramePacing(framePacing, 30.0f);
+    // La riflessione del tavolo resta dentro il suo piano
+    engine->setReflectionMode(Eng::ReflectionMode::STENCIL);
 
 
 
     // Setup Callback
     engine->setKeyboardCallback(keyboardCallback);
     engine->setSpecialCallback(specialCallback);
+    engine->setMouseCallback(mouseCallback);
     engine->setDisplayCallback(displayCallback);
+    engine->setUpdateCallback(updateCallback);
+    engine->setBuildCallback(buildScene);
     engine->setReshapeCallback(reshapeCallback);
+    // Input consegnato una volta per frame: i movimenti leggono lo stato dei tasti
+    engine->setInputQueued(true);
 
     camera = new PerspectiveCamera("MainCam", 45.0f, 800.0f / 600.0f, 1.0f, 5000.0f);
    // --- SETUP VISTA FRONTALE ---
@@ -322,20 +504,22 @@ int main(int argc, char* argv[]) {
     camera->translate(glm::vec3(0.0f, 50.0f, 50.0f));
     camera->rotate(-25.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     mainCameraHome = camera->getM(); // salva posizione iniziale della camera mobile
+    for (PerspectiveCamera*& preview : previewCameras)
+        preview = new PerspectiveCamera("PreviewCam", 45.0f, 800.0f / 600.0f, 1.0f, 5000.0f);
 
     list = new List();
-    reflectionList = new List();
     root = new Node("Root");
 
-    tavoloNode = ovoreader.readFile("tavolo.ovo", "texture/");
+    scene = ovoreader.loadScene("tavolo.ovo", "texture/");
+    tavoloNode = Handle<Node>(scene ? scene->getRoot() : nullptr);
 
     if (tavoloNode) {
         std::cout << "OVO caricato con successo! Aggiungo alla scena." << std::endl;
-        root = tavoloNode;
+        root = tavoloNode.get();
         root->addChild(camera);
 
 
-        root = tavoloNode;
+        root = tavoloNode.get();
         //Node* target = root->findByName("Spot001.Target");
         //root->removeChild(root->findByName("Omni001"));
 
@@ -370,30 +554,11 @@ int main(int argc, char* argv[]) {
         hanoiGame = new Hanoi(camera, engine);
         // Dalla root percorre il grafo
         hanoiGame->initHanoiState(root);
-        reflectionNodesCache.clear();
-
-        // Torre riflessa
-        // Cache Base
-        Node* baseNode = root->findByName("Base");
-        if (baseNode) reflectionNodesCache.push_back(baseNode);
-
-        // Cache Pali
-        for (int i = 1; i <= 3; i++) {
-           Node* palo = root->findByName("Palo" + std::to_string(i));
-           if (palo) reflectionNodesCache.push_back(palo);
-        }
-
-        // Cache Dischi
-        for (int i = 1; i <= 7; i++) {
-           Node* disco = root->findByName("Disco" + std::to_string(i));
-           if (disco) reflectionNodesCache.push_back(disco);
-        }
 
-        // Cache Luci
-        for (int i = 1; i <= 5; i++) {
-           Node* luce = root->findByName("Omni00" + std::to_string(i));
-           if (luce) reflectionNodesCache.push_back(luce);
-        }
+        // Torre riflessa sul piano del tavolo
+        setupTableReflection(root);
+        sceneTransforms.build(root);
+        sceneBvh.build(root);
 
         std::cout << "\n--- STRUTTURA SCENA ---" << std::endl;
         printSceneGraphWithPosition(root);
@@ -404,10 +569,28 @@ int main(int argc, char* argv[]) {
         std::cerr << "Errore critico: impossibile caricare tavolo.ovo" << std::endl;
     }
 
+    setPreviews(previews);
+    if (pipelined) engine->setPipelined(true);
 
 
+    if (headlessFrames > 0) {
+        engine->setProfiling(true);
+        auto start = std::chrono::steady_clock::now();
+        engine->renderOffscreen(headlessFrames, 1.0 / 60.0, dumpPrefix);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "[Headless] " << headlessFrames << " frame in " << elapsed.count() << " ms ("
+                  << elapsed.count() / headlessFrames << " ms/frame)" << std::endl;
+        // Accanto alle immagini, la trace dei frame per cercare i picchi
+        if (!dumpPrefix.empty()) engine->saveProfilerTrace(dumpPrefix + "trace.json");
+    }
+    else {
+        engine->update();
+    }
 
-    engine->update();
+    // Le texture della scena vanno liberate finche' il contesto OpenGL esiste (e nessun thread usa la scena)
+    engine->setPipelined(false);
+    delete scene;
+    scene = nullptr;
     engine->free();
 
     // Cleanup
@@ -415,5 +598,6 @@ int main(int argc, char* argv[]) {
     delete list;
 
     delete camera;
+    for (PerspectiveCamera* preview : previewCameras) delete preview;
     return 0;
 }
@@ -0,0 +1,108 @@
+#include "arena.h"
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @file arena.cpp
+ * @brief Implementazione della classe Arena.
+ */
+
+namespace {
+   constexpr size_t HEADER_ALIGN = alignof(std::max_align_t);
+
+   size_t alignUp(size_t value, size_t alignment) {
+      return (value + alignment - 1) & ~(alignment - 1);
+   }
+}
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize) {}
+
+Arena::~Arena() { release(); }
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+   const size_t header = alignUp(sizeof(Block), HEADER_ALIGN);
+
+   if (blocks) {
+      uintptr_t base = reinterpret_cast<uintptr_t>(blocks) + header;
+      size_t offset = alignUp(base + blocks->used, alignment) - base;
+      if (offset + bytes <= blocks->size) {
+         bytesUsed += offset + bytes - blocks->used;
+         blocks->used = offset + bytes;
+         return reinterpret_cast<void*>(base + offset);
+      }
+   }
+
+   // Nuovo blocco: abbastanza grande anche per richieste oltre la dimensione standard
+   size_t capacity = bytes + alignment > blockSize ? bytes + alignment : blockSize;
+   Block* block = static_cast<Block*>(std::malloc(header + capacity));
+   if (!block) throw std::bad_alloc();
+   block->size = capacity;
+   block->used = 0;
+
+   // Un blocco dedicato a una richiesta grande non sostituisce quello corrente, che puo' avere ancora spazio
+   if (blocks && capacity > blockSize) {
+      block->next = blocks->next;
+      blocks->next = block;
+   }
+   else {
+      block->next = blocks;
+      blocks = block;
+   }
+   numBlocks++;
+
+   uintptr_t base = reinterpret_cast<uintptr_t>(block) + header;
+   size_t offset = alignUp(base, alignment) - base;
+   block->used = offset + bytes;
+   bytesUsed += block->used;
+   return reinterpret_cast<void*>(base + offset);
+}
+
+void Arena::do_deallocate(void*, size_t, size_t) {
+   // La memoria viene restituita solo da release()
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+   return this == &other;
+}
+
+void Arena::registerFinalizer(void* object, void (*destroy)(void*)) {
+   Finalizer* finalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+   finalizer->destroy = destroy;
+   finalizer->object = object;
+   finalizer->next = finalizers;
+   finalizers = finalizer;
+   numObjects++;
+}
+
+void Arena::release() {
+   // Prima tutti i distruttori (possono ancora usare memoria dell'arena), poi i blocchi
+   while (finalizers) {
+      Finalizer* finalizer = finalizers;
+      finalizers = finalizer->next;
+      finalizer->destroy(finalizer->object);
+   }
+   while (blocks) {
+      Block* next = blocks->next;
+      std::free(blocks);
+      blocks = next;
+   }
+   bytesUsed = 0;
+   numBlocks = 0;
+   numObjects = 0;
+}
+
+bool Arena::owns(const void* pointer) const {
+   const size_t header = alignUp(sizeof(Block), HEADER_ALIGN);
+   uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+   for (const Block* block = blocks; block; block = block->next) {
+      uintptr_t base = reinterpret_cast<uintptr_t>(block) + header;
+      if (address >= base && address < base + block->size) return true;
+   }
+   return false;
+}
+
+size_t Arena::getBytesUsed() const { return bytesUsed; }
+
+size_t Arena::getNumBlocks() const { return numBlocks; }
+
+size_t Arena::getNumObjects() const { return numObjects; }
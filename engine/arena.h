@@ -0,0 +1,111 @@
+/**
+ * @file arena.h
+ * @brief Allocatore a blocchi con rilascio in un'unica operazione.
+ */
+#pragma once
+#include "libConfig.h"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class Arena
+ * @brief Alloca memoria avanzando un puntatore all'interno di grandi blocchi e la restituisce tutta insieme.
+ *
+ * Gli oggetti creati con create() sono contigui in ordine di creazione; quelli con distruttore non banale
+ * vengono registrati e distrutti da release() in ordine inverso, prima di liberare i blocchi.
+ * La deallocazione dei singoli oggetti non restituisce memoria: l'arena e' pensata per dati che
+ * vivono e muoiono insieme, come una scena caricata da file.
+ *
+ * Deriva da std::pmr::memory_resource, quindi i contenitori std::pmr (es. i vertici di una Mesh)
+ * possono usarla direttamente.
+ */
+class ENG_API Arena : public std::pmr::memory_resource {
+public:
+   /**
+    * @brief Costruisce un'arena vuota.
+    * @param blockSize Dimensione dei blocchi richiesti al sistema (le richieste piu' grandi ricevono un blocco dedicato).
+    */
+   explicit Arena(size_t blockSize = 64 * 1024);
+
+   /**
+    * @brief Distruttore: equivale a release().
+    */
+   ~Arena() override;
+
+   Arena(const Arena&) = delete;
+   Arena& operator=(const Arena&) = delete;
+
+   /**
+    * @brief Costruisce un oggetto nell'arena.
+    * @return Puntatore all'oggetto, valido fino a release(). Non va mai passato a delete.
+    */
+   template <class T, class... Args>
+   T* create(Args&&... args) {
+      void* memory = allocate(sizeof(T), alignof(T));
+      T* object = new (memory) T(std::forward<Args>(args)...);
+      if constexpr (!std::is_trivially_destructible_v<T>)
+         registerFinalizer(object, [](void* p) { static_cast<T*>(p)->~T(); });
+      return object;
+   }
+
+   /**
+    * @brief Distrugge gli oggetti creati (in ordine inverso di creazione) e libera tutti i blocchi.
+    */
+   void release();
+
+   /**
+    * @brief Verifica se un indirizzo appartiene a uno dei blocchi dell'arena.
+    */
+   bool owns(const void* pointer) const;
+
+   /**
+    * @brief Restituisce i byte assegnati finora (compresi gli allineamenti).
+    */
+   size_t getBytesUsed() const;
+
+   /**
+    * @brief Restituisce il numero di blocchi richiesti al sistema.
+    */
+   size_t getNumBlocks() const;
+
+   /**
+    * @brief Restituisce il numero di oggetti che verranno distrutti da release().
+    */
+   size_t getNumObjects() const;
+
+protected:
+   void* do_allocate(size_t bytes, size_t alignment) override;
+   void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+   /** @brief Intestazione di un blocco: i dati seguono immediatamente. */
+   struct Block {
+      Block* next;
+      size_t size;
+      size_t used;
+   };
+
+   /** @brief Distruttore da chiamare al rilascio, in lista dal piu' recente. */
+   struct Finalizer {
+      void (*destroy)(void*);
+      void* object;
+      Finalizer* next;
+   };
+
+   /** @brief Registra il distruttore di un oggetto appena creato. */
+   void registerFinalizer(void* object, void (*destroy)(void*));
+
+   /** @brief Dimensione predefinita dei blocchi. */
+   size_t blockSize;
+   /** @brief Blocco corrente (in testa alla lista). */
+   Block* blocks = nullptr;
+   /** @brief Distruttori registrati, dal piu' recente. */
+   Finalizer* finalizers = nullptr;
+   size_t bytesUsed = 0;
+   size_t numBlocks = 0;
+   size_t numObjects = 0;
+};
@@ -0,0 +1,84 @@
+/**
+ * @file bitmapFont.h
+ * @brief Font bitmap incorporati nel motore (caratteri ASCII stampabili).
+ */
+#pragma once
+#include "libConfig.h"
+#include <string>
+
+/**
+ * @class BitmapFont
+ * @brief Glifi monocromatici e metriche di un font bitmap, senza dipendenze da GLUT o da un contesto.
+ *
+ * I dati sono quelli dei font GLUT_BITMAP_8_BY_13 e GLUT_BITMAP_TIMES_ROMAN_24 di freeglut, quindi il
+ * testo ha lo stesso aspetto e le stesse larghezze di glutBitmapString(). Ogni glifo e' memorizzato per
+ * righe dal basso, (larghezza + 7) / 8 byte per riga con il bit piu' significativo a sinistra; il
+ * glifo va disegnato spostato di (getOriginX(), getOriginY()) rispetto alla posizione della penna, che
+ * poi avanza di getAdvance(). I caratteri fuori da 32..126 non hanno glifo e non fanno avanzare.
+ */
+class ENG_API BitmapFont {
+public:
+   /** @brief Primo carattere con glifo (spazio). */
+   static constexpr int FIRST_CHAR = 32;
+   /** @brief Numero di caratteri con glifo (32..126). */
+   static constexpr int NUM_CHARS = 95;
+
+   /**
+    * @brief Font a spaziatura fissa 8x13 (GLUT_BITMAP_8_BY_13).
+    */
+   static const BitmapFont& fixed8x13();
+
+   /**
+    * @brief Font proporzionale Times Roman 24 (GLUT_BITMAP_TIMES_ROMAN_24).
+    */
+   static const BitmapFont& timesRoman24();
+
+   /**
+    * @brief Altezza in pixel di tutti i glifi.
+    */
+   int getHeight() const;
+
+   /**
+    * @brief Spostamento orizzontale del glifo a sinistra della penna.
+    */
+   int getOriginX() const;
+
+   /**
+    * @brief Spostamento verticale del glifo sotto la linea di base.
+    */
+   int getOriginY() const;
+
+   /**
+    * @brief Indica se il carattere ha un glifo.
+    */
+   bool hasGlyph(unsigned char c) const;
+
+   /**
+    * @brief Larghezza del glifo e avanzamento della penna in pixel (0 senza glifo).
+    */
+   int getAdvance(unsigned char c) const;
+
+   /**
+    * @brief Indica se un pixel del glifo e' acceso.
+    * @param c Carattere.
+    * @param x Colonna da sinistra.
+    * @param y Riga dal basso.
+    */
+   bool getPixel(unsigned char c, int x, int y) const;
+
+   /**
+    * @brief Larghezza in pixel di una stringa (come glutBitmapLength()).
+    */
+   int getTextWidth(const std::string& text) const;
+
+private:
+   BitmapFont(int height, int originX, int originY, const unsigned char* widths, const unsigned char* bits);
+
+   int height;
+   int originX;
+   int originY;
+   const unsigned char* widths;
+   const unsigned char* bits;
+   /** @brief Inizio di ogni glifo in bits. */
+   unsigned int offsets[NUM_CHARS];
+};
@@ -0,0 +1,91 @@
+#include "boundingBox.h"
+#include <cmath>
+#include <limits>
+
+/**
+ * @file boundingBox.cpp
+ * @brief Implementazione della classe BoundingBox.
+ */
+
+BoundingBox::BoundingBox()
+   : min(std::numeric_limits<float>::max()), max(-std::numeric_limits<float>::max())
+{
+}
+
+BoundingBox::BoundingBox(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+bool BoundingBox::isEmpty() const {
+   return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+void BoundingBox::expand(const glm::vec3& point) {
+   min = glm::min(min, point);
+   max = glm::max(max, point);
+}
+
+void BoundingBox::expand(const BoundingBox& other) {
+   if (other.isEmpty()) return;
+   min = glm::min(min, other.min);
+   max = glm::max(max, other.max);
+}
+
+const glm::vec3& BoundingBox::getMin() const { return min; }
+const glm::vec3& BoundingBox::getMax() const { return max; }
+glm::vec3 BoundingBox::getCenter() const { return (min + max) * 0.5f; }
+glm::vec3 BoundingBox::getExtent() const { return (max - min) * 0.5f; }
+
+BoundingBox BoundingBox::transformed(const glm::mat4& matrix) const {
+   if (isEmpty()) return *this;
+
+   // Metodo di Arvo: il centro si trasforma normalmente, le semi-dimensioni con |M|
+   glm::vec3 center = glm::vec3(matrix * glm::vec4(getCenter(), 1.0f));
+   glm::vec3 extent = getExtent();
+   glm::vec3 newExtent(0.0f);
+   for (int col = 0; col < 3; col++) {
+      newExtent += glm::abs(glm::vec3(matrix[col])) * extent[col];
+   }
+   return BoundingBox(center - newExtent, center + newExtent);
+}
+
+bool BoundingBox::contains(const BoundingBox& other) const {
+   return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+}
+
+bool BoundingBox::overlaps(const BoundingBox& other) const {
+   return glm::all(glm::lessThanEqual(min, other.max)) && glm::all(glm::greaterThanEqual(max, other.min));
+}
+
+float BoundingBox::getSurfaceArea() const {
+   if (isEmpty()) return 0.0f;
+   glm::vec3 size = max - min;
+   return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+glm::vec3 BoundingBox::inverseDirection(const glm::vec3& direction) {
+   glm::vec3 safe;
+   for (int i = 0; i < 3; i++) {
+      safe[i] = std::abs(direction[i]) > 1e-20f ? direction[i] : std::copysign(1e-20f, direction[i]);
+   }
+   return 1.0f / safe;
+}
+
+bool BoundingBox::intersectsRay(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance) const {
+   glm::vec3 t0 = (min - origin) * inverseDirection;
+   glm::vec3 t1 = (max - origin) * inverseDirection;
+   glm::vec3 tNear = glm::min(t0, t1);
+   glm::vec3 tFar = glm::max(t0, t1);
+   float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+   float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, maxDistance));
+   if (enter > exit) return false;
+   distance = enter;
+   return true;
+}
+
+float BoundingBox::minPlaneDistance(const glm::vec4& plane) const {
+   // Vertice "negativo": quello piu' lontano nella direzione opposta alla normale
+   glm::vec3 n(plane);
+   glm::vec3 p(n.x >= 0.0f ? min.x : max.x,
+               n.y >= 0.0f ? min.y : max.y,
+               n.z >= 0.0f ? min.z : max.z);
+   return glm::dot(n, p) + plane.w;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file boundingBox.h
+ * @brief Definizione del volume di contenimento allineato agli assi (AABB).
+ */
+#pragma once
+#include "libConfig.h"
+#include <glm/glm.hpp>
+
+/**
+ * @class BoundingBox
+ * @brief Scatola di contenimento allineata agli assi, usata per culling e interrogazioni spaziali.
+ */
+class ENG_API BoundingBox {
+public:
+   /**
+    * @brief Costruisce una scatola vuota (min > max).
+    */
+   BoundingBox();
+
+   /**
+    * @brief Costruisce una scatola dai due angoli estremi.
+    * @param min Angolo minimo.
+    * @param max Angolo massimo.
+    */
+   BoundingBox(const glm::vec3& min, const glm::vec3& max);
+
+   /**
+    * @brief Indica se la scatola non contiene alcun punto.
+    */
+   bool isEmpty() const;
+
+   /**
+    * @brief Estende la scatola per includere un punto.
+    * @param point Punto da includere.
+    */
+   void expand(const glm::vec3& point);
+
+   /**
+    * @brief Estende la scatola per includere un'altra scatola.
+    * @param other Scatola da includere.
+    */
+   void expand(const BoundingBox& other);
+
+   /**
+    * @brief Restituisce l'angolo minimo.
+    */
+   const glm::vec3& getMin() const;
+
+   /**
+    * @brief Restituisce l'angolo massimo.
+    */
+   const glm::vec3& getMax() const;
+
+   /**
+    * @brief Restituisce il centro della scatola.
+    */
+   glm::vec3 getCenter() const;
+
+   /**
+    * @brief Restituisce le semi-dimensioni della scatola.
+    */
+   glm::vec3 getExtent() const;
+
+   /**
+    * @brief Calcola la scatola (allineata agli assi) che contiene questa scatola trasformata.
+    * @param matrix Matrice di trasformazione (es. World Matrix).
+    * @return Scatola trasformata.
+    */
+   BoundingBox transformed(const glm::mat4& matrix) const;
+
+   /**
+    * @brief Verifica se la scatola contiene interamente un'altra scatola.
+    */
+   bool contains(const BoundingBox& other) const;
+
+   /**
+    * @brief Verifica se la scatola si sovrappone a un'altra scatola (anche solo sul bordo).
+    */
+   bool overlaps(const BoundingBox& other) const;
+
+   /**
+    * @brief Restituisce l'area della superficie (0 per una scatola vuota).
+    */
+   float getSurfaceArea() const;
+
+   /**
+    * @brief Restituisce l'inverso componente per componente di una direzione, per intersectsRay().
+    *
+    * Le componenti nulle sono sostituite da un valore minimo con segno: un raggio parallelo a una
+    * faccia e con l'origine sul suo piano darebbe altrimenti 0 * infinito = NaN nel test delle lastre.
+    */
+   static glm::vec3 inverseDirection(const glm::vec3& direction);
+
+   /**
+    * @brief Interseca un raggio con la scatola (metodo delle lastre).
+    * @param origin Origine del raggio.
+    * @param inverseDirection Inverso della direzione, calcolato con inverseDirection().
+    * @param maxDistance Distanza massima lungo il raggio.
+    * @param distance Distanza di ingresso (0 se l'origine e' interna).
+    * @return True se il raggio entra nella scatola entro maxDistance.
+    */
+   bool intersectsRay(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance) const;
+
+   /**
+    * @brief Restituisce la minima distanza con segno dei vertici della scatola da un piano.
+    * @param plane Piano normalizzato (a, b, c, d) con a*x + b*y + c*z + d = 0.
+    * @return Distanza minima: positiva se l'intera scatola si trova dal lato della normale.
+    */
+   float minPlaneDistance(const glm::vec4& plane) const;
+
+private:
+   /** @brief Angolo minimo. */
+   glm::vec3 min;
+   /** @brief Angolo massimo. */
+   glm::vec3 max;
+};
@@ -0,0 +1,460 @@
+#include "bvh.h"
+#include "mesh.h"
+#include "frustum.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @file bvh.cpp
+ * @brief Implementazione della classe Bvh.
+ */
+
+namespace {
+
+   BoundingBox merge(const BoundingBox& a, const BoundingBox& b) {
+      BoundingBox result = a;
+      result.expand(b);
+      return result;
+   }
+
+   /** @brief Profondita' massima dello stack di visita (l'albero e' bilanciato). */
+   constexpr int STACK_SIZE = 256;
+
+}
+
+Bvh::Bvh(float margin) : margin(margin) {}
+
+BoundingBox Bvh::worldBox(Mesh* mesh) {
+   return mesh->getBoundingBox().transformed(mesh->getWorldFinalMatrix());
+}
+
+void Bvh::build(Node* node) {
+   clear();
+   if (!node) return;
+
+   std::vector<Node*> stack{ node };
+   while (!stack.empty()) {
+      Node* current = stack.back();
+      stack.pop_back();
+      if (Mesh* mesh = dynamic_cast<Mesh*>(current)) insert(mesh);
+      for (unsigned int i = 0; i < current->getNumChildren(); i++) {
+         stack.push_back(current->getChild(i));
+      }
+   }
+}
+
+void Bvh::clear() {
+   nodes.clear();
+   leaves.clear();
+   root = NULL_NODE;
+   freeList = NULL_NODE;
+}
+
+int Bvh::allocateNode() {
+   int index;
+   if (freeList != NULL_NODE) {
+      index = freeList;
+      freeList = nodes[index].parent;
+      nodes[index] = TreeNode();
+   }
+   else {
+      index = (int)nodes.size();
+      nodes.emplace_back();
+   }
+   nodes[index].height = 0;
+   return index;
+}
+
+void Bvh::freeNode(int index) {
+   nodes[index] = TreeNode();
+   nodes[index].parent = freeList;
+   freeList = index;
+}
+
+int Bvh::insert(Mesh* mesh) {
+   BoundingBox tight = worldBox(mesh);
+   if (tight.isEmpty()) return NULL_NODE;
+
+   // La gerarchia dei triangoli viene preparata subito, cosi' il primo pick non ne paga la costruzione
+   mesh->getTriangleBvh();
+
+   int leaf = allocateNode();
+   TreeNode& node = nodes[leaf];
+   node.mesh = Handle<Mesh>(mesh);
+   node.tight = tight;
+   node.box = BoundingBox(tight.getMin() - glm::vec3(margin), tight.getMax() + glm::vec3(margin));
+   node.slot = (int)leaves.size();
+   leaves.push_back(leaf);
+   insertLeaf(leaf);
+   return leaf;
+}
+
+void Bvh::remove(int leaf) {
+   if (leaf < 0 || leaf >= (int)nodes.size() || !nodes[leaf].isLeaf() || nodes[leaf].height != 0) return;
+   destroyLeaf(leaf);
+}
+
+void Bvh::destroyLeaf(int leaf) {
+   removeLeaf(leaf);
+
+   // Rimozione dall'elenco delle foglie spostando l'ultima nel buco
+   int slot = nodes[leaf].slot;
+   int last = leaves.back();
+   leaves[slot] = last;
+   nodes[last].slot = slot;
+   leaves.pop_back();
+
+   freeNode(leaf);
+}
+
+unsigned int Bvh::refit() {
+   unsigned int changed = 0;
+   // All'indietro: destroyLeaf() sposta nel buco solo foglie gia' visitate
+   for (int i = (int)leaves.size() - 1; i >= 0; i--) {
+      int leaf = leaves[i];
+      TreeNode& node = nodes[leaf];
+      Mesh* mesh = node.mesh.get();
+      if (!mesh) {
+         destroyLeaf(leaf);
+         changed++;
+         continue;
+      }
+
+      node.tight = worldBox(mesh);
+      if (node.box.contains(node.tight)) continue;
+
+      removeLeaf(leaf);
+      nodes[leaf].box = BoundingBox(nodes[leaf].tight.getMin() - glm::vec3(margin),
+                                    nodes[leaf].tight.getMax() + glm::vec3(margin));
+      insertLeaf(leaf);
+      changed++;
+   }
+   return changed;
+}
+
+void Bvh::insertLeaf(int leaf) {
+   nodes[leaf].parent = NULL_NODE;
+   if (root == NULL_NODE) {
+      root = leaf;
+      return;
+   }
+
+   // Discesa verso il fratello che rende minimo l'aumento di superficie (euristica di Catto)
+   const BoundingBox leafBox = nodes[leaf].box;
+   int index = root;
+   while (!nodes[index].isLeaf()) {
+      const TreeNode& current = nodes[index];
+      float area = current.box.getSurfaceArea();
+      float combinedArea = merge(current.box, leafBox).getSurfaceArea();
+
+      // Costo di creare qui un nuovo genitore, e costo ereditato da ogni discesa
+      float cost = 2.0f * combinedArea;
+      float inheritance = 2.0f * (combinedArea - area);
+
+      auto descendCost = [&](int child) {
+         const TreeNode& c = nodes[child];
+         float enlarged = merge(c.box, leafBox).getSurfaceArea();
+         return (c.isLeaf() ? enlarged : enlarged - c.box.getSurfaceArea()) + inheritance;
+      };
+      float costLeft = descendCost(current.left);
+      float costRight = descendCost(current.right);
+
+      if (cost < costLeft && cost < costRight) break;
+      index = costLeft < costRight ? current.left : current.right;
+   }
+
+   int sibling = index;
+   int oldParent = nodes[sibling].parent;
+   int newParent = allocateNode();
+   nodes[newParent].parent = oldParent;
+   nodes[newParent].box = merge(leafBox, nodes[sibling].box);
+   nodes[newParent].height = nodes[sibling].height + 1;
+   nodes[newParent].left = sibling;
+   nodes[newParent].right = leaf;
+   nodes[sibling].parent = newParent;
+   nodes[leaf].parent = newParent;
+
+   if (oldParent != NULL_NODE) {
+      if (nodes[oldParent].left == sibling) nodes[oldParent].left = newParent;
+      else nodes[oldParent].right = newParent;
+   }
+   else {
+      root = newParent;
+   }
+
+   fixUpwards(oldParent);
+}
+
+void Bvh::removeLeaf(int leaf) {
+   if (leaf == root) {
+      root = NULL_NODE;
+      return;
+   }
+
+   int parent = nodes[leaf].parent;
+   int grandParent = nodes[parent].parent;
+   int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+   if (grandParent != NULL_NODE) {
+      if (nodes[grandParent].left == parent) nodes[grandParent].left = sibling;
+      else nodes[grandParent].right = sibling;
+      nodes[sibling].parent = grandParent;
+      freeNode(parent);
+      fixUpwards(grandParent);
+   }
+   else {
+      root = sibling;
+      nodes[sibling].parent = NULL_NODE;
+      freeNode(parent);
+   }
+   nodes[leaf].parent = NULL_NODE;
+}
+
+void Bvh::fixUpwards(int index) {
+   while (index != NULL_NODE) {
+      index = balance(index);
+      TreeNode& node = nodes[index];
+      const TreeNode& left = nodes[node.left];
+      const TreeNode& right = nodes[node.right];
+      node.height = 1 + std::max(left.height, right.height);
+      node.box = merge(left.box, right.box);
+      index = node.parent;
+   }
+}
+
+int Bvh::balance(int iA) {
+   TreeNode& A = nodes[iA];
+   if (A.isLeaf() || A.height < 2) return iA;
+
+   int iB = A.left;
+   int iC = A.right;
+   TreeNode& B = nodes[iB];
+   TreeNode& C = nodes[iC];
+   int difference = C.height - B.height;
+
+   // Il nodo che sale prende il posto di A presso il genitore
+   auto replaceInParent = [&](int newChild) {
+      int parent = nodes[newChild].parent;
+      if (parent == NULL_NODE) root = newChild;
+      else if (nodes[parent].left == iA) nodes[parent].left = newChild;
+      else nodes[parent].right = newChild;
+   };
+
+   if (difference > 1) {
+      // C sale
+      int iF = C.left;
+      int iG = C.right;
+      TreeNode& F = nodes[iF];
+      TreeNode& G = nodes[iG];
+
+      C.left = iA;
+      C.parent = A.parent;
+      A.parent = iC;
+      replaceInParent(iC);
+
+      if (F.height > G.height) {
+         C.right = iF;
+         A.right = iG;
+         G.parent = iA;
+         A.box = merge(B.box, G.box);
+         C.box = merge(A.box, F.box);
+         A.height = 1 + std::max(B.height, G.height);
+         C.height = 1 + std::max(A.height, F.height);
+      }
+      else {
+         C.right = iG;
+         A.right = iF;
+         F.parent = iA;
+         A.box = merge(B.box, F.box);
+         C.box = merge(A.box, G.box);
+         A.height = 1 + std::max(B.height, F.height);
+         C.height = 1 + std::max(A.height, G.height);
+      }
+      return iC;
+   }
+
+   if (difference < -1) {
+      // B sale
+      int iD = B.left;
+      int iE = B.right;
+      TreeNode& D = nodes[iD];
+      TreeNode& E = nodes[iE];
+
+      B.left = iA;
+      B.parent = A.parent;
+      A.parent = iB;
+      replaceInParent(iB);
+
+      if (D.height > E.height) {
+         B.right = iD;
+         A.left = iE;
+         E.parent = iA;
+         A.box = merge(C.box, E.box);
+         B.box = merge(A.box, D.box);
+         A.height = 1 + std::max(C.height, E.height);
+         B.height = 1 + std::max(A.height, D.height);
+      }
+      else {
+         B.right = iE;
+         A.left = iD;
+         D.parent = iA;
+         A.box = merge(C.box, D.box);
+         B.box = merge(A.box, E.box);
+         A.height = 1 + std::max(C.height, D.height);
+         B.height = 1 + std::max(A.height, E.height);
+      }
+      return iB;
+   }
+
+   return iA;
+}
+
+template <class LeafTest>
+void Bvh::traverseRay(const glm::vec3& origin, const glm::vec3& direction, float best, LeafTest&& leafTest) const {
+   if (root == NULL_NODE) return;
+
+   glm::vec3 inverseDirection = BoundingBox::inverseDirection(direction);
+   float distance;
+   if (!nodes[root].box.intersectsRay(origin, inverseDirection, best, distance)) return;
+
+   // Visita in profondita' dal figlio piu' vicino, scartando i rami oltre il colpo migliore
+   std::pair<int, float> stack[STACK_SIZE];
+   int top = 0;
+   stack[top++] = { root, distance };
+   while (top > 0) {
+      auto [index, entry] = stack[--top];
+      if (entry > best) continue;
+
+      const TreeNode& node = nodes[index];
+      if (node.isLeaf()) {
+         if (node.tight.intersectsRay(origin, inverseDirection, best, distance)) leafTest(node, distance, best);
+         continue;
+      }
+
+      float leftDistance, rightDistance;
+      bool hitLeft = nodes[node.left].box.intersectsRay(origin, inverseDirection, best, leftDistance);
+      bool hitRight = nodes[node.right].box.intersectsRay(origin, inverseDirection, best, rightDistance);
+      if (hitLeft && hitRight) {
+         // Il piu' lontano va sotto, cosi' il piu' vicino viene visitato per primo
+         if (leftDistance < rightDistance) {
+            stack[top++] = { node.right, rightDistance };
+            stack[top++] = { node.left, leftDistance };
+         }
+         else {
+            stack[top++] = { node.left, leftDistance };
+            stack[top++] = { node.right, rightDistance };
+         }
+      }
+      else if (hitLeft) stack[top++] = { node.left, leftDistance };
+      else if (hitRight) stack[top++] = { node.right, rightDistance };
+   }
+}
+
+bool Bvh::raycast(const glm::vec3& origin, const glm::vec3& direction, RayHit& hit, float maxDistance) const {
+   hit = RayHit();
+   traverseRay(origin, direction, maxDistance, [&](const TreeNode& leaf, float entry, float& best) {
+      Mesh* mesh = leaf.mesh.get();
+      if (!mesh) return;
+      best = entry;
+      hit.mesh = mesh;
+      hit.distance = entry;
+   });
+   return hit.mesh != nullptr;
+}
+
+bool Bvh::pick(const glm::vec3& origin, const glm::vec3& direction, PickHit& hit, float maxDistance) const {
+   hit = PickHit();
+   traverseRay(origin, direction, maxDistance, [&](const TreeNode& leaf, float, float& best) {
+      Mesh* mesh = leaf.mesh.get();
+      float distance;
+      unsigned int face;
+      if (!mesh || !mesh->raycast(origin, direction, best, distance, face)) return;
+      best = distance;
+      hit.mesh = mesh;
+      hit.distance = distance;
+      hit.face = face;
+   });
+   if (!hit.mesh) return false;
+   hit.point = origin + direction * hit.distance;
+   return true;
+}
+
+void Bvh::query(const Frustum& frustum, std::vector<Mesh*>& out) const {
+   if (root == NULL_NODE) return;
+
+   int stack[STACK_SIZE];
+   int top = 0;
+   stack[top++] = root;
+   while (top > 0) {
+      const TreeNode& node = nodes[stack[--top]];
+      if (node.isLeaf()) {
+         Mesh* mesh = node.mesh.get();
+         if (mesh && frustum.intersects(node.tight)) out.push_back(mesh);
+         continue;
+      }
+      if (!frustum.intersects(node.box)) continue;
+      stack[top++] = node.left;
+      stack[top++] = node.right;
+   }
+}
+
+void Bvh::query(const BoundingBox& box, std::vector<Mesh*>& out) const {
+   if (root == NULL_NODE || box.isEmpty()) return;
+
+   int stack[STACK_SIZE];
+   int top = 0;
+   stack[top++] = root;
+   while (top > 0) {
+      const TreeNode& node = nodes[stack[--top]];
+      if (node.isLeaf()) {
+         Mesh* mesh = node.mesh.get();
+         if (mesh && node.tight.overlaps(box)) out.push_back(mesh);
+         continue;
+      }
+      if (!node.box.overlaps(box)) continue;
+      stack[top++] = node.left;
+      stack[top++] = node.right;
+   }
+}
+
+BoundingBox Bvh::getBounds() const {
+   BoundingBox bounds;
+   for (int leaf : leaves) {
+      if (nodes[leaf].mesh.isValid()) bounds.expand(nodes[leaf].tight);
+   }
+   return bounds;
+}
+
+const BoundingBox& Bvh::getLeafBox(int leaf) const { return nodes[leaf].tight; }
+
+unsigned int Bvh::getNumLeaves() const { return (unsigned int)leaves.size(); }
+
+int Bvh::getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+bool Bvh::validate() const {
+   if (root == NULL_NODE) return leaves.empty();
+   if (nodes[root].parent != NULL_NODE) return false;
+
+   unsigned int numLeaves = 0;
+   std::vector<int> stack{ root };
+   while (!stack.empty()) {
+      int index = stack.back();
+      stack.pop_back();
+      const TreeNode& node = nodes[index];
+
+      if (node.isLeaf()) {
+         if (node.height != 0 || node.slot < 0 || node.slot >= (int)leaves.size() || leaves[node.slot] != index) return false;
+         numLeaves++;
+         continue;
+      }
+
+      const TreeNode& left = nodes[node.left];
+      const TreeNode& right = nodes[node.right];
+      if (left.parent != index || right.parent != index) return false;
+      if (node.height != 1 + std::max(left.height, right.height)) return false;
+      if (!node.box.contains(left.box) || !node.box.contains(right.box)) return false;
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+   }
+   return numLeaves == leaves.size();
+}
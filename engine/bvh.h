@@ -0,0 +1,208 @@
+/**
+ * @file bvh.h
+ * @brief Gerarchia di volumi di contenimento (BVH) sulle mesh della scena.
+ */
+#pragma once
+#include "libConfig.h"
+#include "boundingBox.h"
+#include "handle.h"
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
+class Node;
+class Mesh;
+class Frustum;
+
+/**
+ * @class Bvh
+ * @brief Albero dinamico di AABB sulle scatole nello spazio mondo delle mesh.
+ *
+ * Ogni foglia conserva la scatola esatta della mesh e una scatola "grassa", allargata di un margine:
+ * refit() ricalcola le scatole esatte e reinserisce solo le foglie uscite dalla propria scatola grassa,
+ * quindi gli oggetti fermi o che si muovono poco non toccano l'albero. L'inserimento sceglie il
+ * fratello che minimizza l'aumento di superficie e gli antenati vengono ribilanciati con rotazioni,
+ * cosi' l'altezza resta logaritmica e le interrogazioni visitano solo i rami utili.
+ *
+ * Le mesh sono referenziate con un Handle: quelle distrutte vengono ignorate dalle interrogazioni
+ * e rimosse al refit() successivo.
+ */
+class ENG_API Bvh {
+public:
+   /** @brief Identificativo di foglia non valido. */
+   static constexpr int NULL_NODE = -1;
+
+   /**
+    * @struct RayHit
+    * @brief Risultato di un'interrogazione con un raggio.
+    */
+   struct RayHit {
+      /** @brief Mesh colpita. */
+      Mesh* mesh = nullptr;
+      /** @brief Distanza lungo il raggio del punto di ingresso nella scatola della mesh. */
+      float distance = std::numeric_limits<float>::max();
+   };
+
+   /**
+    * @struct PickHit
+    * @brief Risultato del picking sui triangoli.
+    */
+   struct PickHit {
+      /** @brief Mesh colpita. */
+      Mesh* mesh = nullptr;
+      /** @brief Punto colpito nello spazio mondo. */
+      glm::vec3 point{ 0.0f };
+      /** @brief Distanza lungo il raggio del punto colpito. */
+      float distance = std::numeric_limits<float>::max();
+      /** @brief Faccia colpita della mesh. */
+      unsigned int face = 0;
+   };
+
+   /**
+    * @brief Costruisce un albero vuoto.
+    * @param margin Margine (in unita' mondo) di cui vengono allargate le scatole delle foglie.
+    */
+   explicit Bvh(float margin = 0.5f);
+
+   /**
+    * @brief Svuota l'albero e inserisce tutte le mesh del sottoalbero (le mesh senza vertici sono ignorate).
+    * @param root Radice del grafo di scena.
+    */
+   void build(Node* root);
+
+   /**
+    * @brief Rimuove tutte le foglie.
+    */
+   void clear();
+
+   /**
+    * @brief Inserisce una mesh nella posizione attuale.
+    * @return Identificativo della foglia, o NULL_NODE se la mesh non ha vertici.
+    */
+   int insert(Mesh* mesh);
+
+   /**
+    * @brief Rimuove una foglia restituita da insert().
+    */
+   void remove(int leaf);
+
+   /**
+    * @brief Aggiorna l'albero dopo lo spostamento delle mesh.
+    * @return Numero di foglie reinserite (o rimosse perche' la mesh e' stata distrutta).
+    */
+   unsigned int refit();
+
+   /**
+    * @brief Cerca la mesh piu' vicina la cui scatola e' attraversata da un raggio.
+    * @param origin Origine del raggio nello spazio mondo.
+    * @param direction Direzione del raggio (le distanze sono in multipli della sua lunghezza).
+    * @param hit Mesh colpita e distanza.
+    * @param maxDistance Distanza massima considerata.
+    * @return True se una mesh e' stata colpita.
+    */
+   bool raycast(const glm::vec3& origin, const glm::vec3& direction, RayHit& hit,
+                float maxDistance = std::numeric_limits<float>::max()) const;
+
+   /**
+    * @brief Cerca il triangolo piu' vicino attraversato da un raggio.
+    *
+    * Le scatole delle mesh scartano quasi tutta la scena; solo le mesh la cui scatola e' piu' vicina
+    * del miglior colpo trovato vengono provate sui triangoli, con la loro TriangleBvh.
+    * @param origin Origine del raggio nello spazio mondo.
+    * @param direction Direzione del raggio (le distanze sono in multipli della sua lunghezza).
+    * @param hit Mesh, punto, distanza e faccia colpiti.
+    * @param maxDistance Distanza massima considerata.
+    * @return True se un triangolo e' stato colpito.
+    */
+   bool pick(const glm::vec3& origin, const glm::vec3& direction, PickHit& hit,
+             float maxDistance = std::numeric_limits<float>::max()) const;
+
+   /**
+    * @brief Raccoglie le mesh la cui scatola e' almeno in parte dentro un frustum (nello spazio mondo).
+    */
+   void query(const Frustum& frustum, std::vector<Mesh*>& out) const;
+
+   /**
+    * @brief Raccoglie le mesh la cui scatola si sovrappone a una scatola nello spazio mondo.
+    */
+   void query(const BoundingBox& box, std::vector<Mesh*>& out) const;
+
+   /**
+    * @brief Restituisce la scatola che contiene tutte le mesh (vuota se l'albero e' vuoto).
+    */
+   BoundingBox getBounds() const;
+
+   /**
+    * @brief Restituisce la scatola esatta di una foglia nello spazio mondo.
+    */
+   const BoundingBox& getLeafBox(int leaf) const;
+
+   /**
+    * @brief Restituisce il numero di mesh nell'albero.
+    */
+   unsigned int getNumLeaves() const;
+
+   /**
+    * @brief Restituisce l'altezza dell'albero (0 se vuoto o con una sola foglia).
+    */
+   int getHeight() const;
+
+   /**
+    * @brief Verifica la coerenza di collegamenti, altezze e scatole (per test e debug).
+    */
+   bool validate() const;
+
+private:
+   /**
+    * @struct TreeNode
+    * @brief Nodo dell'albero: foglia (con mesh) o interno (con due figli).
+    */
+   struct TreeNode {
+      /** @brief Scatola grassa per le foglie, unione dei figli per i nodi interni. */
+      BoundingBox box;
+      /** @brief Scatola esatta della mesh (solo foglie). */
+      BoundingBox tight;
+      /** @brief Mesh della foglia. */
+      Handle<Mesh> mesh;
+      /** @brief Genitore, o prossimo nodo libero se il nodo non e' in uso. */
+      int parent = NULL_NODE;
+      int left = NULL_NODE;
+      int right = NULL_NODE;
+      /** @brief 0 per le foglie, -1 per i nodi liberi. */
+      int height = -1;
+      /** @brief Posizione nell'elenco delle foglie (solo foglie). */
+      int slot = NULL_NODE;
+
+      bool isLeaf() const { return left == NULL_NODE; }
+   };
+
+   /**
+    * @brief Visita le foglie attraversate da un raggio dalla piu' vicina, scartando quelle oltre best.
+    * @param leafTest Chiamata per ogni foglia raggiunta come leafTest(foglia, ingresso, best); puo' ridurre best.
+    */
+   template <class LeafTest>
+   void traverseRay(const glm::vec3& origin, const glm::vec3& direction, float best, LeafTest&& leafTest) const;
+
+   /** @brief Calcola la scatola di una mesh nello spazio mondo. */
+   static BoundingBox worldBox(Mesh* mesh);
+
+   int allocateNode();
+   void freeNode(int index);
+   void insertLeaf(int leaf);
+   void removeLeaf(int leaf);
+   /** @brief Ricalcola altezze e scatole risalendo da un nodo, ribilanciando lungo il percorso. */
+   void fixUpwards(int index);
+   /** @brief Esegue una rotazione sul nodo se i figli sono sbilanciati; restituisce la nuova radice del sottoalbero. */
+   int balance(int index);
+   /** @brief Rimuove una foglia e la restituisce alla lista libera. */
+   void destroyLeaf(int leaf);
+
+   /** @brief Margine di allargamento delle foglie. */
+   float margin;
+   /** @brief Pool dei nodi (gli indici restano stabili). */
+   std::vector<TreeNode> nodes;
+   /** @brief Foglie in uso, visitate da refit(). */
+   std::vector<int> leaves;
+   int root = NULL_NODE;
+   int freeList = NULL_NODE;
+};
@@ -5,7 +5,7 @@
  * @file camera.cpp
  * @brief Implementazione delle classe Camera.
  */
-Camera::Camera(const std::string& name) : Node(name), projectionMatrix(glm::mat4(1.0f)) {}
+Camera::Camera(std::string_view name) : Node(name), projectionMatrix(glm::mat4(1.0f)) {}
 
 Camera::~Camera() {}
 
@@ -22,3 +22,16 @@ glm::mat4 Camera::getInvCameraMatrix() const {
      // L'inversa di questa matrice sposta il mondo rispetto alla camera (View Matrix)
    return glm::inverse(this->getWorldFinalMatrix());
 }
+
+void Camera::getRay(float x, float y, float width, float height, glm::vec3& origin, glm::vec3& direction) const {
+   // Centro del pixel in coordinate normalizzate, con la Y rivolta verso l'alto
+   float ndcX = 2.0f * (x + 0.5f) / width - 1.0f;
+   float ndcY = 1.0f - 2.0f * (y + 0.5f) / height;
+
+   // Vale per ogni proiezione: prospettica (raggi divergenti) e ortografica (raggi paralleli)
+   glm::mat4 clipToWorld = glm::inverse(projectionMatrix * getInvCameraMatrix());
+   glm::vec4 nearPoint = clipToWorld * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+   glm::vec4 farPoint = clipToWorld * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+   origin = glm::vec3(nearPoint) / nearPoint.w;
+   direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - origin);
+}
@@ -21,7 +21,7 @@ public:
      * @brief Costruttore della camera base.
      * @param name Il nome del nodo camera all'interno del grafo della scena.
      */
-    Camera(const std::string& name);
+    Camera(std::string_view name);
 
     /**
      * @brief Distruttore virtuale.
@@ -41,6 +41,17 @@ public:
      */
     glm::mat4 getInvCameraMatrix() const;
 
+    /**
+     * @brief Calcola il raggio nello spazio mondo che passa per un punto della finestra.
+     * @param x Coordinata X in pixel (da sinistra).
+     * @param y Coordinata Y in pixel (dall'alto, come negli eventi GLUT).
+     * @param width Larghezza della finestra in pixel.
+     * @param height Altezza della finestra in pixel.
+     * @param origin Punto sul piano vicino.
+     * @param direction Direzione normalizzata verso il piano lontano.
+     */
+    void getRay(float x, float y, float width, float height, glm::vec3& origin, glm::vec3& direction) const;
+
     /**
      * @brief Imposta manualmente una matrice di proiezione generica.
      * @param projectionMatrix La nuova matrice di proiezione.
@@ -0,0 +1,619 @@
+#include "commandBuffer.h"
+#include "mesh.h"
+#include "material.h"
+#include "texture.h"
+#include "stateCache.h"
+#include <GL/freeglut.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/**
+ * @file commandBuffer.cpp
+ * @brief Implementazione della classe CommandBuffer.
+ */
+
+enum class CommandBuffer::Op : uint32_t {
+   LOAD_PROJECTION, ///< 16 float
+   LOAD_MODELVIEW,  ///< 16 float
+   SET_MATERIAL,    ///< indice materiale (-1 = nessuno)
+   DRAW_MESH,       ///< indice mesh
+   SET_LIGHT,       ///< slot + 21 float (Light::Parameters)
+   DISABLE_LIGHT,   ///< slot
+   ENABLE,          ///< capability
+   DISABLE,         ///< capability
+   DEPTH_MASK,      ///< 0/1
+   COLOR_MASK,      ///< 0/1
+   BLEND_FUNC,      ///< src, dst
+   FRONT_FACE,      ///< modo
+   STENCIL_FUNC,    ///< func, ref, mask
+   STENCIL_OP,      ///< sfail, dpfail, dppass
+   CLIP_PLANE,      ///< piano + 4 float
+   SCISSOR,         ///< x, y, w, h
+   CLEAR            ///< maschera
+};
+
+namespace {
+   /** @brief Identificativo e versione del formato su disco. */
+   const char FILE_MAGIC[4] = { 'E', 'C', 'M', 'D' };
+   constexpr uint32_t FILE_VERSION = 1;
+
+   /** @brief Lettore sequenziale del flusso di comandi (un flusso troncato restituisce zeri). */
+   struct Reader {
+      const std::vector<uint32_t>& words;
+      size_t pc = 0;
+
+      uint32_t word() {
+         uint32_t value = pc < words.size() ? words[pc] : 0;
+         pc++;
+         return value;
+      }
+      int integer() { return (int)word(); }
+      float real() {
+         uint32_t bits = word();
+         float value;
+         std::memcpy(&value, &bits, sizeof(float));
+         return value;
+      }
+      glm::mat4 matrix() {
+         glm::mat4 m;
+         float* dst = glm::value_ptr(m);
+         for (int i = 0; i < 16; i++) dst[i] = real();
+         return m;
+      }
+      glm::vec4 vec4() {
+         glm::vec4 v;
+         for (int i = 0; i < 4; i++) v[i] = real();
+         return v;
+      }
+   };
+
+   template <typename T>
+   void writeValue(std::ofstream& out, const T& value) {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <typename T>
+   void writeArray(std::ofstream& out, const std::vector<T>& values) {
+      if (!values.empty()) out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+   }
+
+   template <typename T>
+   bool readValue(std::ifstream& in, T& value) {
+      return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+   }
+
+   /** @brief Byte ancora da leggere nel file. */
+   uint64_t remainingBytes(std::ifstream& in) {
+      std::streampos current = in.tellg();
+      in.seekg(0, std::ios::end);
+      std::streampos end = in.tellg();
+      in.seekg(current);
+      return (current < 0 || end < current) ? 0 : (uint64_t)(end - current);
+   }
+
+   /** @brief Un conteggio letto dal file e' plausibile solo se i suoi elementi (almeno @p minBytes l'uno) ci stanno. */
+   bool fits(std::ifstream& in, uint64_t count, uint64_t minBytes) {
+      return count * minBytes <= remainingBytes(in);
+   }
+
+   template <typename T>
+   bool readArray(std::ifstream& in, std::vector<T>& values, size_t count) {
+      // Nessuna allocazione per conteggi che il file non puo' contenere
+      if (!fits(in, count, sizeof(T))) return false;
+      values.resize(count);
+      if (count == 0) return true;
+      return (bool)in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+   }
+}
+
+CommandBuffer::CommandBuffer() {}
+
+CommandBuffer::~CommandBuffer() {}
+
+void CommandBuffer::clear() {
+   words.clear();
+   numCommands = 0;
+   textures.clear();
+   materials.clear();
+   meshes.clear();
+   materialIndex.clear();
+   meshIndex.clear();
+}
+
+void CommandBuffer::push(Op op) {
+   words.push_back((uint32_t)op);
+   numCommands++;
+}
+
+void CommandBuffer::pushWord(uint32_t value) { words.push_back(value); }
+
+void CommandBuffer::pushFloat(float value) {
+   uint32_t bits;
+   std::memcpy(&bits, &value, sizeof(float));
+   words.push_back(bits);
+}
+
+void CommandBuffer::pushVec(const float* values, int count) {
+   for (int i = 0; i < count; i++) pushFloat(values[i]);
+}
+
+int CommandBuffer::textureIndex(unsigned int glId, const std::string& path) {
+   for (size_t i = 0; i < textures.size(); i++)
+      if (textures[i].glId == glId && textures[i].path == path) return (int)i;
+   textures.push_back({ glId, path });
+   return (int)textures.size() - 1;
+}
+
+// --- REGISTRAZIONE ---
+
+void CommandBuffer::loadProjection(const glm::mat4& matrix) {
+   push(Op::LOAD_PROJECTION);
+   pushVec(glm::value_ptr(matrix), 16);
+}
+
+void CommandBuffer::loadModelView(const glm::mat4& matrix) {
+   push(Op::LOAD_MODELVIEW);
+   pushVec(glm::value_ptr(matrix), 16);
+}
+
+void CommandBuffer::setMaterial(const Material* material) {
+   int index = -1;
+   if (material) {
+      auto it = materialIndex.find(material);
+      if (it != materialIndex.end()) {
+         index = it->second;
+      }
+      else {
+         // Stessi valori inviati da Material::render()
+         float alpha = material->getTransparency();
+         MaterialData data;
+         data.emission = glm::vec4(material->getEmissione(), alpha);
+         data.ambient = glm::vec4(material->getAmbient(), alpha);
+         data.diffuse = glm::vec4(material->getDiffuse(), alpha);
+         data.specular = glm::vec4(material->getSpecular(), alpha);
+         data.shininess = material->getShininess();
+         if (Texture* texture = material->getTexture())
+            data.texture = textureIndex(texture->getTexId(), texture->getFilePath());
+
+         index = (int)materials.size();
+         materials.push_back(data);
+         materialIndex[material] = index;
+      }
+   }
+   push(Op::SET_MATERIAL);
+   pushWord((uint32_t)index);
+}
+
+void CommandBuffer::drawMesh(const Mesh* mesh) {
+   int index;
+   auto it = meshIndex.find(mesh);
+   if (it != meshIndex.end()) {
+      index = it->second;
+   }
+   else {
+      MeshData data;
+      data.source = mesh;
+      index = (int)meshes.size();
+      meshes.push_back(std::move(data));
+      meshIndex[mesh] = index;
+   }
+   push(Op::DRAW_MESH);
+   pushWord((uint32_t)index);
+}
+
+void CommandBuffer::setLight(int slot, const Light::Parameters& p) {
+   push(Op::SET_LIGHT);
+   pushWord((uint32_t)slot);
+   pushVec(glm::value_ptr(p.ambient), 4);
+   pushVec(glm::value_ptr(p.diffuse), 4);
+   pushVec(glm::value_ptr(p.specular), 4);
+   pushVec(glm::value_ptr(p.position), 4);
+   pushVec(glm::value_ptr(p.spotDirection), 3);
+   pushFloat(p.spotCutoff);
+   pushFloat(p.spotExponent);
+}
+
+void CommandBuffer::disableLight(int slot) {
+   push(Op::DISABLE_LIGHT);
+   pushWord((uint32_t)slot);
+}
+
+void CommandBuffer::enable(unsigned int cap) {
+   push(Op::ENABLE);
+   pushWord(cap);
+}
+
+void CommandBuffer::disable(unsigned int cap) {
+   push(Op::DISABLE);
+   pushWord(cap);
+}
+
+void CommandBuffer::depthMask(bool enabled) {
+   push(Op::DEPTH_MASK);
+   pushWord(enabled ? 1 : 0);
+}
+
+void CommandBuffer::colorMask(bool enabled) {
+   push(Op::COLOR_MASK);
+   pushWord(enabled ? 1 : 0);
+}
+
+void CommandBuffer::blendFunc(unsigned int src, unsigned int dst) {
+   push(Op::BLEND_FUNC);
+   pushWord(src);
+   pushWord(dst);
+}
+
+void CommandBuffer::frontFace(unsigned int mode) {
+   push(Op::FRONT_FACE);
+   pushWord(mode);
+}
+
+void CommandBuffer::stencilFunc(unsigned int func, int ref, unsigned int mask) {
+   push(Op::STENCIL_FUNC);
+   pushWord(func);
+   pushWord((uint32_t)ref);
+   pushWord(mask);
+}
+
+void CommandBuffer::stencilOp(unsigned int sfail, unsigned int dpfail, unsigned int dppass) {
+   push(Op::STENCIL_OP);
+   pushWord(sfail);
+   pushWord(dpfail);
+   pushWord(dppass);
+}
+
+void CommandBuffer::clipPlane(int plane, const glm::vec4& equation) {
+   push(Op::CLIP_PLANE);
+   pushWord((uint32_t)plane);
+   pushVec(glm::value_ptr(equation), 4);
+}
+
+void CommandBuffer::scissor(int x, int y, int width, int height) {
+   push(Op::SCISSOR);
+   pushWord((uint32_t)x);
+   pushWord((uint32_t)y);
+   pushWord((uint32_t)width);
+   pushWord((uint32_t)height);
+}
+
+void CommandBuffer::clearBuffers(unsigned int mask) {
+   push(Op::CLEAR);
+   pushWord(mask);
+}
+
+// --- RIPRODUZIONE ---
+
+void CommandBuffer::extractGeometry(MeshData& data) {
+   if (!data.source || data.numCorners > 0) return;
+
+   const auto& vertices = data.source->get_all_vertices();
+   const auto& normals = data.source->get_all_normals();
+   const auto& uvs = data.source->get_all_texture_coords();
+   bool hasNormals = !vertices.empty() && normals.size() >= vertices.size();
+   bool hasUVs = !vertices.empty() && uvs.size() >= vertices.size();
+
+   // Stesso ordine (e stessi indici scartati) di Mesh::renderGeometry()
+   for (const auto& face : data.source->get_face_vertices()) {
+      for (unsigned int idx : face) {
+         if (idx >= vertices.size()) continue;
+         data.positions.push_back(vertices[idx]);
+         if (hasNormals) data.normals.push_back(normals[idx]);
+         if (hasUVs) data.uvs.push_back(uvs[idx]);
+      }
+   }
+   data.numCorners = (unsigned int)data.positions.size();
+}
+
+void CommandBuffer::detach() {
+   for (MeshData& data : meshes) {
+      extractGeometry(data);
+      data.source = nullptr;
+   }
+   meshIndex.clear();
+}
+
+void CommandBuffer::drawGeometry(MeshData& data, Backend backend) {
+   if (backend == Backend::IMMEDIATE) {
+      if (data.source) {
+         const_cast<Mesh*>(data.source)->renderGeometry();
+         return;
+      }
+      glBegin(GL_TRIANGLES);
+      for (unsigned int i = 0; i < data.numCorners; i++) {
+         if (!data.normals.empty()) glNormal3fv(glm::value_ptr(data.normals[i]));
+         if (!data.uvs.empty()) glTexCoord2fv(glm::value_ptr(data.uvs[i]));
+         glVertex3fv(glm::value_ptr(data.positions[i]));
+      }
+      glEnd();
+      return;
+   }
+
+   extractGeometry(data);
+   if (data.numCorners == 0) return;
+
+   glVertexPointer(3, GL_FLOAT, 0, data.positions.data());
+   if (!data.normals.empty()) {
+      glEnableClientState(GL_NORMAL_ARRAY);
+      glNormalPointer(GL_FLOAT, 0, data.normals.data());
+   }
+   if (!data.uvs.empty()) {
+      glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+      glTexCoordPointer(2, GL_FLOAT, 0, data.uvs.data());
+   }
+   glDrawArrays(GL_TRIANGLES, 0, (GLsizei)data.numCorners);
+   glDisableClientState(GL_NORMAL_ARRAY);
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+CommandBuffer::Stats CommandBuffer::replay(Backend backend) {
+   Stats stats;
+   Reader in{ words };
+
+   if (backend == Backend::VERTEX_ARRAY) glEnableClientState(GL_VERTEX_ARRAY);
+
+   while (in.pc < words.size()) {
+      Op op = (Op)in.word();
+      stats.commands++;
+
+      switch (op) {
+      case Op::LOAD_PROJECTION: {
+         glm::mat4 m = in.matrix();
+         glMatrixMode(GL_PROJECTION);
+         glLoadMatrixf(glm::value_ptr(m));
+         glMatrixMode(GL_MODELVIEW);
+         break;
+      }
+      case Op::LOAD_MODELVIEW: {
+         glm::mat4 m = in.matrix();
+         glMatrixMode(GL_MODELVIEW);
+         glLoadMatrixf(glm::value_ptr(m));
+         break;
+      }
+      case Op::SET_MATERIAL: {
+         int index = in.integer();
+         if (index < 0 || index >= (int)materials.size()) {
+            // Come Mesh::render() senza materiale
+            StateCache::disable(GL_LIGHTING);
+            StateCache::disable(GL_TEXTURE_2D);
+            glColor3f(1.0f, 1.0f, 1.0f);
+            break;
+         }
+         const MaterialData& m = materials[index];
+         StateCache::enable(GL_LIGHTING);
+         StateCache::material(GL_AMBIENT, m.ambient);
+         StateCache::material(GL_DIFFUSE, m.diffuse);
+         StateCache::material(GL_SPECULAR, m.specular);
+         StateCache::material(GL_EMISSION, m.emission);
+         StateCache::materialShininess(m.shininess);
+         if (m.texture >= 0) {
+            StateCache::enable(GL_TEXTURE_2D);
+            StateCache::texEnvMode(GL_MODULATE);
+            StateCache::bindTexture2D(textures[m.texture].glId);
+         }
+         else {
+            StateCache::disable(GL_TEXTURE_2D);
+         }
+         break;
+      }
+      case Op::DRAW_MESH: {
+         int index = in.integer();
+         if (index < 0 || index >= (int)meshes.size()) break;
+         MeshData& data = meshes[index];
+         drawGeometry(data, backend);
+         stats.drawCalls++;
+         if (data.source && data.numCorners == 0) {
+            // Geometria non ancora copiata: conta i triangoli dalla mesh
+            for (const auto& face : data.source->get_face_vertices())
+               stats.triangles += (unsigned int)face.size() / 3;
+         }
+         else {
+            stats.triangles += data.numCorners / 3;
+         }
+         break;
+      }
+      case Op::SET_LIGHT: {
+         int slot = in.integer();
+         Light::Parameters p;
+         p.ambient = in.vec4();
+         p.diffuse = in.vec4();
+         p.specular = in.vec4();
+         p.position = in.vec4();
+         for (int i = 0; i < 3; i++) p.spotDirection[i] = in.real();
+         p.spotCutoff = in.real();
+         p.spotExponent = in.real();
+         Light::apply(GL_LIGHT0 + slot, p);
+         break;
+      }
+      case Op::DISABLE_LIGHT:
+         StateCache::disable(GL_LIGHT0 + in.integer());
+         break;
+      case Op::ENABLE:
+         StateCache::enable(in.word());
+         break;
+      case Op::DISABLE:
+         StateCache::disable(in.word());
+         break;
+      case Op::DEPTH_MASK:
+         StateCache::depthMask(in.word() != 0);
+         break;
+      case Op::COLOR_MASK:
+         StateCache::colorMask(in.word() != 0);
+         break;
+      case Op::BLEND_FUNC: {
+         unsigned int src = in.word();
+         StateCache::blendFunc(src, in.word());
+         break;
+      }
+      case Op::FRONT_FACE:
+         StateCache::frontFace(in.word());
+         break;
+      case Op::STENCIL_FUNC: {
+         unsigned int func = in.word();
+         int ref = in.integer();
+         StateCache::stencilFunc(func, ref, in.word());
+         break;
+      }
+      case Op::STENCIL_OP: {
+         unsigned int sfail = in.word();
+         unsigned int dpfail = in.word();
+         StateCache::stencilOp(sfail, dpfail, in.word());
+         break;
+      }
+      case Op::CLIP_PLANE: {
+         int plane = in.integer();
+         glm::vec4 eq = in.vec4();
+         GLdouble equation[4] = { eq.x, eq.y, eq.z, eq.w };
+         glClipPlane(GL_CLIP_PLANE0 + plane, equation);
+         break;
+      }
+      case Op::SCISSOR: {
+         int x = in.integer();
+         int y = in.integer();
+         int w = in.integer();
+         glScissor(x, y, w, in.integer());
+         break;
+      }
+      case Op::CLEAR: {
+         unsigned int mask = in.word();
+         if (mask & GL_STENCIL_BUFFER_BIT) glClearStencil(0);
+         glClear(mask);
+         break;
+      }
+      default:
+         std::cout << "[CommandBuffer] Error: unknown command " << (uint32_t)op << ", replay stopped" << std::endl;
+         in.pc = words.size();
+         break;
+      }
+   }
+
+   if (backend == Backend::VERTEX_ARRAY) glDisableClientState(GL_VERTEX_ARRAY);
+   return stats;
+}
+
+// --- SERIALIZZAZIONE ---
+
+bool CommandBuffer::save(const std::string& path) {
+   std::ofstream out(path, std::ios::binary);
+   if (!out) {
+      std::cout << "[CommandBuffer] Error: cannot write " << path << std::endl;
+      return false;
+   }
+
+   out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+   writeValue(out, FILE_VERSION);
+
+   writeValue(out, (uint32_t)textures.size());
+   for (const TextureData& t : textures) {
+      writeValue(out, (uint32_t)t.path.size());
+      out.write(t.path.data(), t.path.size());
+   }
+
+   writeValue(out, (uint32_t)materials.size());
+   for (const MaterialData& m : materials) {
+      writeValue(out, m.emission);
+      writeValue(out, m.ambient);
+      writeValue(out, m.diffuse);
+      writeValue(out, m.specular);
+      writeValue(out, m.shininess);
+      writeValue(out, (int32_t)m.texture);
+   }
+
+   writeValue(out, (uint32_t)meshes.size());
+   for (MeshData& m : meshes) {
+      extractGeometry(m);
+      writeValue(out, (uint32_t)m.numCorners);
+      writeValue(out, (uint8_t)(m.normals.empty() ? 0 : 1));
+      writeValue(out, (uint8_t)(m.uvs.empty() ? 0 : 1));
+      writeArray(out, m.positions);
+      writeArray(out, m.normals);
+      writeArray(out, m.uvs);
+   }
+
+   writeValue(out, numCommands);
+   writeValue(out, (uint32_t)words.size());
+   writeArray(out, words);
+
+   if (!out) {
+      std::cout << "[CommandBuffer] Error: write failed for " << path << std::endl;
+      return false;
+   }
+   return true;
+}
+
+bool CommandBuffer::load(const std::string& path) {
+   std::ifstream in(path, std::ios::binary);
+   if (!in) {
+      std::cout << "[CommandBuffer] Error: cannot open " << path << std::endl;
+      return false;
+   }
+
+   auto fail = [&](const char* reason) {
+      std::cout << "[CommandBuffer] Error: " << reason << " in " << path << std::endl;
+      clear();
+      return false;
+   };
+
+   char magic[4];
+   uint32_t version = 0;
+   if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0)
+      return fail("not a command buffer file");
+   if (!readValue(in, version) || version != FILE_VERSION)
+      return fail("unsupported version");
+
+   clear();
+
+   uint32_t count = 0;
+   // Prima di ogni resize() il conteggio va confrontato con i byte rimasti: un file corrotto
+   // deve fallire qui e non con una bad_alloc
+   if (!readValue(in, count) || !fits(in, count, sizeof(uint32_t))) return fail("truncated texture table");
+   textures.resize(count);
+   for (TextureData& t : textures) {
+      uint32_t length = 0;
+      if (!readValue(in, length) || !fits(in, length, 1)) return fail("truncated texture table");
+      t.path.resize(length);
+      if (length > 0 && !in.read(&t.path[0], length)) return fail("truncated texture table");
+      t.glId = 0; // le texture non vengono ricaricate
+   }
+
+   const uint64_t materialBytes = 4 * sizeof(glm::vec4) + sizeof(float) + sizeof(int32_t);
+   if (!readValue(in, count) || !fits(in, count, materialBytes)) return fail("truncated material table");
+   materials.resize(count);
+   for (MaterialData& m : materials) {
+      int32_t texture = -1;
+      if (!readValue(in, m.emission) || !readValue(in, m.ambient) || !readValue(in, m.diffuse) ||
+          !readValue(in, m.specular) || !readValue(in, m.shininess) || !readValue(in, texture))
+         return fail("truncated material table");
+      if (texture >= (int32_t)textures.size()) return fail("invalid texture index");
+      m.texture = texture;
+   }
+
+   const uint64_t meshHeaderBytes = sizeof(uint32_t) + 2 * sizeof(uint8_t);
+   if (!readValue(in, count) || !fits(in, count, meshHeaderBytes)) return fail("truncated mesh table");
+   meshes.resize(count);
+   for (MeshData& m : meshes) {
+      uint32_t corners = 0;
+      uint8_t hasNormals = 0, hasUVs = 0;
+      if (!readValue(in, corners) || !readValue(in, hasNormals) || !readValue(in, hasUVs))
+         return fail("truncated mesh table");
+      m.numCorners = corners;
+      if (!readArray(in, m.positions, corners) ||
+          !readArray(in, m.normals, hasNormals ? corners : 0) ||
+          !readArray(in, m.uvs, hasUVs ? corners : 0))
+         return fail("truncated mesh geometry");
+   }
+
+   uint32_t commands = 0;
+   if (!readValue(in, commands) || !readValue(in, count) || !readArray(in, words, count))
+      return fail("truncated command stream");
+   numCommands = commands;
+   return true;
+}
+
+unsigned int CommandBuffer::getNumCommands() const { return numCommands; }
+
+unsigned int CommandBuffer::getNumMeshes() const { return (unsigned int)meshes.size(); }
+
+size_t CommandBuffer::getSizeInBytes() const { return words.size() * sizeof(uint32_t); }
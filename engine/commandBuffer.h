@@ -0,0 +1,209 @@
+/**
+ * @file commandBuffer.h
+ * @brief Flusso di comandi di rendering registrabile, riproducibile e salvabile su disco.
+ */
+#pragma once
+#include "libConfig.h"
+#include "light.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Mesh;
+class Material;
+
+/**
+ * @class CommandBuffer
+ * @brief Registra in forma compatta i comandi inviati dalla List (matrici, materiali, texture,
+ * luci, stato e disegni) per riprodurli in seguito senza visitare il grafo di scena.
+ *
+ * Permette di misurare il solo costo di invio dei comandi di un frame catturato, di ripeterlo
+ * quante volte si vuole e di confrontare backend diversi sullo stesso lavoro. Finche' il buffer
+ * contiene riferimenti a mesh vive (registrazione), le mesh non vanno distrutte: detach() copia la
+ * geometria nel buffer, che da quel momento e' autosufficiente come uno caricato con load().
+ */
+class ENG_API CommandBuffer {
+public:
+   /**
+    * @brief Modalita' con cui la geometria viene inviata durante la riproduzione.
+    */
+   enum class Backend : int {
+      IMMEDIATE,   ///< glBegin/glEnd, come Mesh::renderGeometry()
+      VERTEX_ARRAY ///< Array di vertici lato client e glDrawArrays
+   };
+
+   /**
+    * @struct Stats
+    * @brief Contatori di una riproduzione.
+    */
+   struct Stats {
+      /** @brief Comandi eseguiti. */
+      unsigned int commands = 0;
+      /** @brief Mesh disegnate. */
+      unsigned int drawCalls = 0;
+      /** @brief Triangoli inviati. */
+      unsigned int triangles = 0;
+   };
+
+   /**
+    * @brief Costruisce un buffer vuoto.
+    */
+   CommandBuffer();
+
+   /**
+    * @brief Distruttore della classe.
+    */
+   ~CommandBuffer();
+
+   /**
+    * @brief Svuota il buffer (comandi e tabelle di mesh, materiali e texture).
+    */
+   void clear();
+
+   // --- REGISTRAZIONE ---
+
+   /** @brief Registra il caricamento della matrice di proiezione. */
+   void loadProjection(const glm::mat4& matrix);
+   /** @brief Registra il caricamento della matrice ModelView. */
+   void loadModelView(const glm::mat4& matrix);
+   /**
+    * @brief Registra l'attivazione di un materiale (e della sua texture).
+    * @param material Materiale da attivare; nullptr equivale a una mesh senza materiale.
+    */
+   void setMaterial(const Material* material);
+   /**
+    * @brief Registra il disegno della geometria di una mesh (senza materiale).
+    * @param mesh Mesh da disegnare; deve restare viva fino a detach() o clear().
+    */
+   void drawMesh(const Mesh* mesh);
+   /**
+    * @brief Registra la configurazione di uno slot luce.
+    * @param slot Indice dello slot (0 = GL_LIGHT0).
+    * @param parameters Parametri della luce, gia' relativi alla ModelView corrente.
+    */
+   void setLight(int slot, const Light::Parameters& parameters);
+   /** @brief Registra lo spegnimento di uno slot luce. */
+   void disableLight(int slot);
+   /** @brief Registra un glEnable. */
+   void enable(unsigned int cap);
+   /** @brief Registra un glDisable. */
+   void disable(unsigned int cap);
+   /** @brief Registra un glDepthMask. */
+   void depthMask(bool enabled);
+   /** @brief Registra un glColorMask su tutti i canali. */
+   void colorMask(bool enabled);
+   /** @brief Registra un glBlendFunc. */
+   void blendFunc(unsigned int src, unsigned int dst);
+   /** @brief Registra un glFrontFace. */
+   void frontFace(unsigned int mode);
+   /** @brief Registra un glStencilFunc. */
+   void stencilFunc(unsigned int func, int ref, unsigned int mask);
+   /** @brief Registra un glStencilOp. */
+   void stencilOp(unsigned int sfail, unsigned int dpfail, unsigned int dppass);
+   /**
+    * @brief Registra un piano di clipping (relativo alla ModelView corrente).
+    * @param plane Indice del piano (0 = GL_CLIP_PLANE0).
+    * @param equation Coefficienti (a, b, c, d) del piano.
+    */
+   void clipPlane(int plane, const glm::vec4& equation);
+   /** @brief Registra il rettangolo di scissor. */
+   void scissor(int x, int y, int width, int height);
+   /**
+    * @brief Registra la pulizia dei buffer indicati (colore, profondita', stencil a 0).
+    * @param mask Maschera di bit GL_*_BUFFER_BIT.
+    */
+   void clearBuffers(unsigned int mask);
+
+   // --- RIPRODUZIONE E SERIALIZZAZIONE ---
+
+   /**
+    * @brief Esegue tutti i comandi registrati.
+    * @param backend Modalita' di invio della geometria.
+    * @return Contatori della riproduzione.
+    */
+   Stats replay(Backend backend = Backend::IMMEDIATE);
+
+   /**
+    * @brief Copia nel buffer la geometria delle mesh registrate, che da quel momento possono essere distrutte.
+    */
+   void detach();
+
+   /**
+    * @brief Salva su file comandi, materiali, geometria e percorsi delle texture.
+    * @param path Percorso del file di destinazione.
+    * @return True se il salvataggio ha successo.
+    */
+   bool save(const std::string& path);
+
+   /**
+    * @brief Carica un buffer salvato con save(), sostituendo il contenuto corrente.
+    * @note Le texture non vengono ricaricate: in riproduzione viene collegata la texture 0.
+    * @param path Percorso del file da leggere.
+    * @return True se il caricamento ha successo.
+    */
+   bool load(const std::string& path);
+
+   /**
+    * @brief Restituisce il numero di comandi registrati.
+    */
+   unsigned int getNumCommands() const;
+
+   /**
+    * @brief Restituisce il numero di mesh distinte referenziate dal buffer.
+    */
+   unsigned int getNumMeshes() const;
+
+   /**
+    * @brief Restituisce la dimensione in byte del flusso di comandi (tabelle escluse).
+    */
+   size_t getSizeInBytes() const;
+
+private:
+   /** @brief Codici dei comandi. */
+   enum class Op : uint32_t;
+
+   /** @brief Texture referenziata dal buffer. */
+   struct TextureData {
+      unsigned int glId = 0;
+      std::string path;
+   };
+
+   /** @brief Materiale copiato al momento della registrazione. */
+   struct MaterialData {
+      glm::vec4 emission, ambient, diffuse, specular;
+      float shininess = 0.0f;
+      int texture = -1;
+   };
+
+   /** @brief Geometria di una mesh, espansa in triangoli. */
+   struct MeshData {
+      const Mesh* source = nullptr;
+      unsigned int numCorners = 0;
+      std::vector<glm::vec3> positions;
+      std::vector<glm::vec3> normals;
+      std::vector<glm::vec2> uvs;
+   };
+
+   void push(Op op);
+   void pushWord(uint32_t value);
+   void pushFloat(float value);
+   void pushVec(const float* values, int count);
+   int textureIndex(unsigned int glId, const std::string& path);
+   static void extractGeometry(MeshData& data);
+   void drawGeometry(MeshData& data, Backend backend);
+
+   /** @brief Flusso dei comandi: codice seguito dagli argomenti, tutti a 32 bit. */
+   std::vector<uint32_t> words;
+   /** @brief Numero di comandi nel flusso. */
+   unsigned int numCommands = 0;
+
+   std::vector<TextureData> textures;
+   std::vector<MaterialData> materials;
+   std::vector<MeshData> meshes;
+
+   /** @brief Indici nelle tabelle degli oggetti gia' incontrati durante la registrazione. */
+   std::unordered_map<const void*, int> materialIndex;
+   std::unordered_map<const void*, int> meshIndex;
+};
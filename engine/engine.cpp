@@ -1,10 +1,19 @@
 #include "engine.h"
 #include <iostream>   
+#include <algorithm>
 #include <GL/freeglut.h>
 #include "FreeImage.h"
 #include <glm/gtc/type_ptr.hpp>
 #include "orthographicCamera.h"
 #include "perspectiveCamera.h"
+#include "stateCache.h"
+#include "commandBuffer.h"
+#include "profiler.h"
+#include "textRenderer.h"
+#include "tripleBuffer.h"
+#include <atomic>
+#include <thread>
+#include <cstdio>
 
 
 struct TextRequest {
@@ -13,14 +22,29 @@ struct TextRequest {
     float r, g, b;
 };
 
+/**
+ * @brief Vista aggiuntiva: camera e riquadro in frazioni della finestra.
+ */
+struct ViewRequest {
+    Camera* camera;
+    float x, y, width, height;
+};
+
 struct Eng::Base::Reserved
 {
     bool initFlag = false;
+    int argc = 0;
+    char** argv = nullptr;
+
+    // -- CONTESTO SENZA FINESTRA --
+    OffscreenContext offscreen;
 
     // --- DATI SCENA ---
     Camera* currentCamera = nullptr;
     List* currentList = nullptr;
     List* reflectionList = nullptr;
+    Eng::ReflectionMode reflectionMode = Eng::ReflectionMode::FULL_SCREEN;
+    bool hasStencil = false;
 
     // --- CAMERA UI (Ortografica) ---
     std::unique_ptr<OrthographicCamera> uiCamera;
@@ -31,6 +55,7 @@ struct Eng::Base::Reserved
 
     // -- FPS -- 
     bool show_fps = false;
+    bool showProfiler = false;
     float fps = 0.0f;
     int frameCounter = 0;
     std::chrono::time_point<std::chrono::steady_clock> lastTime = std::chrono::steady_clock::now();
@@ -44,10 +69,145 @@ struct Eng::Base::Reserved
     Eng::ReshapeCallback  clientReshapeCb = nullptr;
     Eng::KeyboardCallback clientKeyboardCb = nullptr;
     Eng::SpecialCallback  clientSpecialCb = nullptr;
+    Eng::MouseCallback    clientMouseCb = nullptr;
+
+    // -- VISTE AGGIUNTIVE --
+    std::vector<ViewRequest> views;
+
+    // -- CODA DELL'INPUT --
+    InputQueue input;
+    bool inputQueued = false;
+    /** @brief Tempo del frame in corso, per integrare i movimenti letti dallo stato dei tasti. */
+    double frameTime = 0.0;
+
+    // -- PICKING SU GPU --
+    IdPicker idPicker;
+
+    // -- CADENZA DEI FRAME --
+    FramePacer pacer;
+    bool windowCreated = false;
+    bool inFrame = false;
+    bool timerPending = false;
+    int pacingGeneration = 0;
+    FramePacer::Clock::time_point nextFrame;
+
+    // -- SIMULAZIONE A PASSO FISSO --
+    SimulationClock simulationClock;
+    Eng::UpdateCallback clientUpdateCb = nullptr;
+    FramePacer::Clock::time_point lastFrame = FramePacer::Clock::now();
+    /** @brief Vero anche prima del primo frame: l'avvio non entra ne' nella simulazione ne' nelle statistiche. */
+    bool idle = true;
+
+    // -- TESTO (atlante di glifi) --
+    TextRenderer textRenderer;
+    Hud hud;
+
+    // -- STATISTICHE DEI TEMPI DI FRAME --
+    FrameTimeStats frameStats;
+    std::string frameStatsReport;
+
+    // -- PIPELINE SIMULAZIONE / RENDERING --
+    Eng::BuildCallback clientBuildCb = nullptr;
+    bool pipelined = false;
+    /** @brief Liste prodotte dal thread di simulazione e consumate dal thread OpenGL. */
+    TripleBuffer<List> snapshots;
+    /** @brief Lista del frame in corso in modalita' pipeline (nullptr altrimenti). */
+    List* snapshot = nullptr;
+    /** @brief Vista della camera letta prima di avviare la costruzione (la gerarchia la aggiorna il worker). */
+    glm::mat4 snapshotView = glm::mat4(1.0f);
+    /** @brief Come snapshotView, per le viste aggiuntive. */
+    std::vector<glm::mat4> snapshotViews;
+    /** @brief False finche' la prima lista non e' stata costruita o dopo invalidateSnapshot(). */
+    bool snapshotReady = false;
+    /** @brief Frame aggiuntivo in corso per mostrare la lista costruita dopo l'ultimo input. */
+    bool catchUpFrame = false;
+    std::thread worker;
+    /** @brief Costruzioni richieste e concluse: il worker e' fermo quando coincidono. */
+    std::atomic<uint64_t> buildsRequested{ 0 };
+    std::atomic<uint64_t> buildsFinished{ 0 };
+    std::atomic<bool> stopWorker{ false };
+    /** @brief Tempo del frame per la costruzione richiesta (scritto prima di buildsRequested). */
+    double buildFrameTime = 0.0;
+
+    /**
+     * @brief Consegna alle callback gli eventi raccolti dall'ultimo frame (solo con l'input in coda).
+     */
+    void dispatchInput() {
+        if (!inputQueued) return;
+        for (const InputQueue::Event& event : input.getEvents()) {
+            switch (event.device) {
+            case InputQueue::Device::KEYBOARD:
+                if (event.down && clientKeyboardCb) clientKeyboardCb((unsigned char)event.key, event.x, event.y);
+                break;
+            case InputQueue::Device::SPECIAL:
+                if (event.down && clientSpecialCb) clientSpecialCb(event.key, event.x, event.y);
+                break;
+            case InputQueue::Device::MOUSE:
+                if (clientMouseCb) clientMouseCb(event.key, event.down ? GLUT_DOWN : GLUT_UP, event.x, event.y);
+                break;
+            }
+        }
+    }
 
     Reserved() {
         uiCamera = std::make_unique<OrthographicCamera>("UI_Cam", 0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
     }
+
+    // Un frame del thread di simulazione: passi fissi e lista del frame successivo
+    void build(double frameTime) {
+        Profiler::Scope scope("Build");
+        if (clientUpdateCb) {
+            Profiler::Scope updateScope("Client update");
+            simulationClock.advance(frameTime, clientUpdateCb);
+        }
+        List& list = snapshots.getWriteBuffer();
+        list.clear();
+        clientBuildCb(list);
+        snapshots.publish();
+    }
+
+    void startWorker() {
+        snapshotReady = false;
+        catchUpFrame = false;
+        stopWorker = false;
+        buildsRequested = 0;
+        buildsFinished = 0;
+        worker = std::thread([this]() {
+            uint64_t done = 0;
+            for (;;) {
+                buildsRequested.wait(done, std::memory_order_acquire);
+                if (stopWorker.load(std::memory_order_acquire)) return;
+                done = buildsRequested.load(std::memory_order_acquire);
+                build(buildFrameTime);
+                buildsFinished.store(done, std::memory_order_release);
+                buildsFinished.notify_all();
+            }
+        });
+    }
+
+    void stopWorkerThread() {
+        if (!worker.joinable()) return;
+        waitForBuild();
+        stopWorker.store(true, std::memory_order_release);
+        buildsRequested.fetch_add(1, std::memory_order_release);
+        buildsRequested.notify_one();
+        worker.join();
+    }
+
+    void requestBuild(double frameTime) {
+        buildFrameTime = frameTime;
+        buildsRequested.fetch_add(1, std::memory_order_release);
+        buildsRequested.notify_one();
+    }
+
+    // Il client e il worker condividono la scena: il thread OpenGL la tocca solo a costruzione conclusa
+    void waitForBuild() {
+        if (!worker.joinable()) return;
+        uint64_t requested = buildsRequested.load(std::memory_order_relaxed);
+        for (uint64_t finished = buildsFinished.load(std::memory_order_acquire); finished != requested;
+             finished = buildsFinished.load(std::memory_order_acquire))
+            buildsFinished.wait(finished, std::memory_order_acquire);
+    }
 };
 
 // --- STATIC WRAPPERS ---
@@ -55,6 +215,25 @@ static void glutDisplayWrapper() { Eng::Base::getInstance().handleDisplayRequest
 static void glutReshapeWrapper(int width, int height) { Eng::Base::getInstance().handleReshapeRequest(width, height); }
 static void glutKeyboardWrapper(unsigned char key, int x, int y) { Eng::Base::getInstance().handleKeyboardRequest(key, x, y); }
 static void glutSpecialWrapper(int key, int x, int y) { Eng::Base::getInstance().handleSpecialRequest(key, x, y); }
+static void glutKeyboardUpWrapper(unsigned char key, int x, int y) { Eng::Base::getInstance().handleKeyboardUpRequest(key, x, y); }
+static void glutSpecialUpWrapper(int key, int x, int y) { Eng::Base::getInstance().handleSpecialUpRequest(key, x, y); }
+static void glutMouseWrapper(int button, int state, int x, int y) { Eng::Base::getInstance().handleMouseRequest(button, state, x, y); }
+static void glutPacingWrapper(int generation) { Eng::Base::getInstance().handlePacingTimer(generation); }
+
+// Intervallo di scambio dei buffer (0 = subito, 1 = al vertical blank); false se il driver non lo permette
+static bool setSwapInterval(int interval) {
+#ifdef _WIN32
+    using SwapIntervalProc = int (APIENTRY*)(int);
+    if (auto proc = reinterpret_cast<SwapIntervalProc>(glutGetProcAddress("wglSwapIntervalEXT"))) return proc(interval) != 0;
+#else
+    using SwapIntervalMesaProc = int (*)(unsigned int);
+    using SwapIntervalSgiProc = int (*)(int);
+    if (auto proc = reinterpret_cast<SwapIntervalMesaProc>(glutGetProcAddress("glXSwapIntervalMESA"))) return proc(interval) == 0;
+    // La variante SGI non accetta 0: senza vsync resta quello predefinito del driver
+    if (auto proc = reinterpret_cast<SwapIntervalSgiProc>(glutGetProcAddress("glXSwapIntervalSGI"))) return interval > 0 && proc(interval) == 0;
+#endif
+    return false;
+}
 
 // --- IMPLEMENTAZIONE BASE ---
 
@@ -68,7 +247,9 @@ Eng::Base& Eng::Base::getInstance() {
 
 bool Eng::Base::init(int argc, char* argv[]) {
     if (reserved->initFlag) return false;
-    glutInit(&argc, argv);
+    // glutInit apre la connessione al server grafico: rimandata a createWindow(), il backend headless non la usa
+    reserved->argc = argc;
+    reserved->argv = argv;
     FreeImage_Initialise();
     std::cout << "[Engine] Initialized" << std::endl;
     reserved->initFlag = true;
@@ -77,6 +258,13 @@ bool Eng::Base::init(int argc, char* argv[]) {
 
 bool Eng::Base::free() {
     if (!reserved->initFlag) return false;
+    setPipelined(false);
+    if (!reserved->frameStatsReport.empty() && !saveFrameTimeStats(reserved->frameStatsReport))
+        std::cout << "[Engine] Impossibile salvare " << reserved->frameStatsReport << std::endl;
+    reserved->idPicker.free();
+    reserved->textRenderer.free();
+    Profiler::freeGpu();
+    reserved->offscreen.destroy();
     reserved->initFlag = false;
     std::cout << "[Engine] Freed" << std::endl;
     return true;
@@ -85,10 +273,12 @@ bool Eng::Base::free() {
 void Eng::Base::createWindow(int width, int height, int x, int y, const char* title) {
     if (!reserved->initFlag) return;
 
-    glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+    glutInit(&reserved->argc, reserved->argv);
+    glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH | GLUT_STENCIL);
     glutInitWindowSize(width, height);
     glutInitWindowPosition(x, y);
     glutCreateWindow(title);
+    reserved->hasStencil = glutGet(GLUT_WINDOW_STENCIL_SIZE) > 0;
 
     // Set frustum iniziale per la UI
     reserved->uiCamera->setFrustum(0.0f, (float)width, 0.0f, (float)height, -1.0f, 1.0f);
@@ -97,13 +287,66 @@ void Eng::Base::createWindow(int width, int height, int x, int y, const char* ti
     glutReshapeFunc(glutReshapeWrapper);
     glutKeyboardFunc(glutKeyboardWrapper);
     glutSpecialFunc(glutSpecialWrapper);
+    glutKeyboardUpFunc(glutKeyboardUpWrapper);
+    glutSpecialUpFunc(glutSpecialUpWrapper);
+    glutMouseFunc(glutMouseWrapper);
+    glutIgnoreKeyRepeat(reserved->inputQueued ? 1 : 0);
+
+    initContextState();
+    reserved->idPicker.init();
+    Profiler::initGpu();
+
+    reserved->windowCreated = true;
+    setFramePacing(reserved->pacer.getMode(), reserved->pacer.getTargetFps());
+}
+
+bool Eng::Base::createOffscreen(int width, int height) {
+    if (!reserved->initFlag || reserved->windowCreated) return false;
+    if (!reserved->offscreen.create(width, height)) return false;
+    std::cout << "[Engine] Offscreen " << width << "x" << height << " (" << reserved->offscreen.getRenderer() << ")" << std::endl;
+
+    reserved->windowWidth = reserved->offscreen.getWidth();
+    reserved->windowHeight = reserved->offscreen.getHeight();
+    reserved->hasStencil = true;
+    reserved->uiCamera->setFrustum(0.0f, (float)reserved->windowWidth, 0.0f, (float)reserved->windowHeight, -1.0f, 1.0f);
+
+    initContextState();
+    reserved->idPicker.init(OffscreenContext::getProcLoader());
+    Profiler::initGpu(OffscreenContext::getProcLoader());
+    return true;
+}
+
+int Eng::Base::renderOffscreen(int frames, double frameTime, const std::string& dumpPrefix) {
+    if (!reserved->offscreen.isValid()) return 0;
+    for (int i = 0; i < frames; i++) {
+        FramePacer::Clock::time_point start = FramePacer::Clock::now();
+        runFrame(frameTime);
+        reserved->frameStats.addFrame(std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - start).count());
+        if (!dumpPrefix.empty()) {
+            char suffix[32];
+            snprintf(suffix, sizeof(suffix), "%04d.png", i);
+            if (!saveFrame(dumpPrefix + suffix)) std::cout << "[Engine] Impossibile salvare " << dumpPrefix << suffix << std::endl;
+        }
+    }
+    // Al ritorno la scena e' di nuovo solo del chiamante
+    reserved->waitForBuild();
+    return frames;
+}
+
+bool Eng::Base::saveFrame(const std::string& path) { return reserved->offscreen.saveImage(path); }
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_LIGHTING);
+bool Eng::Base::isOffscreen() const { return reserved->offscreen.isValid(); }
+
+void Eng::Base::initContextState() {
+    // Nuovo contesto: lo stato precedente conosciuto dalla cache non e' piu' valido
+    StateCache::invalidate();
+    StateCache::enable(GL_DEPTH_TEST);
+    StateCache::enable(GL_CULL_FACE);
+    StateCache::enable(GL_LIGHTING);
     glShadeModel(GL_SMOOTH);
-    glEnable(GL_NORMALIZE);
+    StateCache::enable(GL_NORMALIZE);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    if (!reserved->textRenderer.init()) std::cout << "[Engine] Atlante dei glifi non disponibile" << std::endl;
 }
 
 void Eng::Base::update() { glutMainLoop(); }
@@ -113,33 +356,111 @@ void Eng::Base::setDisplayCallback(DisplayCallback cb) { reserved->clientDisplay
 void Eng::Base::setReshapeCallback(ReshapeCallback cb) { reserved->clientReshapeCb = cb; }
 void Eng::Base::setKeyboardCallback(KeyboardCallback cb) { reserved->clientKeyboardCb = cb; }
 void Eng::Base::setSpecialCallback(SpecialCallback cb) { reserved->clientSpecialCb = cb; }
+void Eng::Base::setMouseCallback(MouseCallback cb) { reserved->clientMouseCb = cb; }
+
+void Eng::Base::setInputQueued(bool queued) {
+    reserved->inputQueued = queued;
+    if (reserved->windowCreated) glutIgnoreKeyRepeat(queued ? 1 : 0);
+}
+
+bool Eng::Base::isInputQueued() const { return reserved->inputQueued; }
+
+const InputQueue& Eng::Base::getInput() const { return reserved->input; }
+
+double Eng::Base::getFrameTime() const { return reserved->frameTime; }
+void Eng::Base::setUpdateCallback(UpdateCallback cb) {
+    reserved->waitForBuild();
+    reserved->clientUpdateCb = cb;
+}
+void Eng::Base::setBuildCallback(BuildCallback cb) {
+    reserved->waitForBuild();
+    reserved->clientBuildCb = cb;
+    if (!cb) setPipelined(false);
+}
+
+bool Eng::Base::setPipelined(bool enable) {
+    if (enable == reserved->pipelined) return true;
+    if (enable && !reserved->clientBuildCb) return false;
+    reserved->pipelined = enable;
+    if (enable)
+        reserved->startWorker();
+    else
+        reserved->stopWorkerThread();
+    return true;
+}
+
+bool Eng::Base::isPipelined() const { return reserved->pipelined; }
+
+void Eng::Base::invalidateSnapshot() {
+    if (!reserved->pipelined) return;
+    // Dalle callback il worker e' gia' fermo; altrimenti si aspetta che smetta di leggere la scena
+    reserved->waitForBuild();
+    reserved->snapshotReady = false;
+}
+
+void Eng::Base::setFixedTimestep(double step, int maxStepsPerFrame, double maxFrameTime) {
+    reserved->waitForBuild();
+    reserved->simulationClock.configure(step, maxStepsPerFrame, maxFrameTime);
+}
+
+float Eng::Base::getInterpolationAlpha() const { return (float)reserved->simulationClock.getAlpha(); }
+
+const SimulationClock& Eng::Base::getSimulationClock() const { return reserved->simulationClock; }
 
 void Eng::Base::setClearColor(float r, float g, float b, float a) { glClearColor(r, g, b, a); }
 
-void Eng::Base::setLighting(bool enable) { 
-    if (enable) 
-        glEnable(GL_LIGHTING); 
-    else 
-        glDisable(GL_LIGHTING); }
+void Eng::Base::setLighting(bool enable) { StateCache::set(GL_LIGHTING, enable); }
+
+void Eng::Base::setTexture(bool enable) { StateCache::set(GL_TEXTURE_2D, enable); }
+
+void Eng::Base::setReflectionMode(ReflectionMode mode) { reserved->reflectionMode = mode; }
+Eng::ReflectionMode Eng::Base::getReflectionMode() { return reserved->reflectionMode; }
 
-void Eng::Base::setTexture(bool enable) { 
-    if (enable) 
-        glEnable(GL_TEXTURE_2D); 
-    else 
-        glDisable(GL_TEXTURE_2D); 
+void Eng::Base::setFramePacing(FramePacer::Mode mode, float targetFps) {
+    reserved->pacer.setMode(mode, targetFps);
+    // I timer gia' programmati appartengono alla cadenza precedente
+    reserved->pacingGeneration++;
+    reserved->timerPending = false;
+    if (!reserved->windowCreated) return;
+
+    bool vsync = mode == FramePacer::Mode::VSYNC;
+    if (!setSwapInterval(vsync ? 1 : 0) && vsync) {
+        std::cout << "[Engine] Vsync non disponibile: limite fisso a " << reserved->pacer.getTargetFps() << " FPS" << std::endl;
+        reserved->pacer.setMode(FramePacer::Mode::FIXED_FPS, targetFps);
+    }
+    glutPostRedisplay();
+}
+
+FramePacer::Mode Eng::Base::getFramePacing() const { return reserved->pacer.getMode(); }
+
+void Eng::Base::setAnimating(bool animating) {
+    bool wasIdle = !reserved->pacer.isAnimating();
+    reserved->pacer.setAnimating(animating);
+    if (animating && wasIdle) postRedisplay();
 }
 
 void Eng::Base::setRenderList(List* list) { reserved->currentList = list; }
 void Eng::Base::setReflectionList(List* list) { reserved->reflectionList = list; }
 void Eng::Base::setMainCamera(Camera* camera) { reserved->currentCamera = camera; }
 
+int Eng::Base::addView(Camera* camera, float x, float y, float width, float height) {
+    if (!camera) return -1;
+    reserved->views.push_back({ camera, x, y, width, height });
+    return (int)reserved->views.size() - 1;
+}
+
+void Eng::Base::clearViews() { reserved->views.clear(); }
+
+unsigned int Eng::Base::getNumViews() const { return (unsigned int)reserved->views.size(); }
+
 void Eng::Base::render() {
-    if (!reserved->currentCamera || !reserved->currentList) return;
+    List* list = reserved->snapshot ? reserved->snapshot : reserved->currentList;
+    if (!reserved->currentCamera || !list) return;
 
     // === SCENA 3D ===
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
+    StateCache::enable(GL_DEPTH_TEST);
+    StateCache::enable(GL_LIGHTING);
+    StateCache::enable(GL_TEXTURE_2D);
 
     glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -148,65 +469,272 @@ void Eng::Base::render() {
     glMatrixMode(GL_PROJECTION);
     glLoadMatrixf(glm::value_ptr(reserved->currentCamera->getProjectionMatrix()));
 
-    glm::mat4 viewMatrix = reserved->currentCamera->getInvCameraMatrix();
-    // prima questa se no sarebbe sopra il tavolo riflesso
-    if (reserved->reflectionList) {
-        glFrontFace(GL_CW);
-        reserved->reflectionList->render(viewMatrix);
-        glFrontFace(GL_CCW);
+    glm::mat4 viewMatrix = reserved->snapshot ? reserved->snapshotView : reserved->currentCamera->getInvCameraMatrix();
+
+    // Registrazione attiva sulla lista principale: il buffer contiene sempre l'ultimo frame completo
+    if (CommandBuffer* recorder = list->getCommandBuffer()) {
+        recorder->clear();
+        recorder->enable(GL_DEPTH_TEST);
+        recorder->enable(GL_LIGHTING);
+        recorder->enable(GL_TEXTURE_2D);
+        recorder->clearBuffers(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        recorder->loadProjection(reserved->currentCamera->getProjectionMatrix());
+    }
+    {
+        Profiler::Scope scope("Reflections");
+        Profiler::GpuScope gpuScope("Reflections");
+        // prima questa se no sarebbe sopra il tavolo riflesso
+        if (reserved->reflectionList) {
+            StateCache::frontFace(GL_CW);
+            reserved->reflectionList->render(viewMatrix);
+            StateCache::frontFace(GL_CCW);
+        }
+        // Riflessioni delle mesh specchio, ricavate dalla lista principale
+        bool stencilClip = reserved->reflectionMode == ReflectionMode::STENCIL && reserved->hasStencil;
+        list->renderReflections(viewMatrix, reserved->currentCamera->getProjectionMatrix(), stencilClip);
+    }
+    {
+        Profiler::Scope scope("Submission");
+        Profiler::GpuScope gpuScope("Submission");
+        list->render(viewMatrix);
+    }
+
+    // Passata degli id solo con una richiesta in attesa; le letture concluse sono raccolte qui e
+    // consegnate al client all'inizio del frame successivo (legge solo la lista: nessuna attesa del worker)
+    if (reserved->idPicker.isPending()) {
+        Profiler::Scope scope("ID pass");
+        Profiler::GpuScope gpuScope("ID pass");
+        reserved->idPicker.process(*list, reserved->currentCamera->getProjectionMatrix(), viewMatrix,
+                                   reserved->windowWidth, reserved->windowHeight);
+    }
+
+    // Viste aggiuntive: stessa lista, solo culling e invio dei comandi
+    if (!reserved->views.empty()) {
+        Profiler::Scope scope("Views");
+        Profiler::GpuScope gpuScope("Views");
+        // La registrazione contiene solo la vista principale
+        CommandBuffer* recorder = list->getCommandBuffer();
+        list->setCommandBuffer(nullptr);
+        bool stencilClip = reserved->reflectionMode == ReflectionMode::STENCIL && reserved->hasStencil;
+
+        for (size_t i = 0; i < reserved->views.size(); i++) {
+            const ViewRequest& view = reserved->views[i];
+            GLint x = (GLint)(view.x * reserved->windowWidth);
+            GLint y = (GLint)(view.y * reserved->windowHeight);
+            GLsizei width = (GLsizei)(view.width * reserved->windowWidth);
+            GLsizei height = (GLsizei)(view.height * reserved->windowHeight);
+            if (width <= 0 || height <= 0) continue;
+
+            // Il riquadro si pulisce da solo; le riflessioni a stencil cambiano lo scissor a ogni vista
+            glViewport(x, y, width, height);
+            StateCache::enable(GL_SCISSOR_TEST);
+            glScissor(x, y, width, height);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            StateCache::disable(GL_SCISSOR_TEST);
+
+            const glm::mat4& projection = view.camera->getProjectionMatrix();
+            glMatrixMode(GL_PROJECTION);
+            glLoadMatrixf(glm::value_ptr(projection));
+            glm::mat4 viewMatrix = reserved->snapshot ? reserved->snapshotViews[i] : view.camera->getInvCameraMatrix();
+
+            if (reserved->reflectionList) {
+                StateCache::frontFace(GL_CW);
+                reserved->reflectionList->renderCulled(viewMatrix, projection);
+                StateCache::frontFace(GL_CCW);
+            }
+            list->renderReflections(viewMatrix, projection, stencilClip);
+            list->renderCulled(viewMatrix, projection);
+        }
+
+        glViewport(0, 0, reserved->windowWidth, reserved->windowHeight);
+        list->setCommandBuffer(recorder);
     }
-    reserved->currentList->render(viewMatrix);
 
     // === OVERLAY 2D (UI) ===
     calculateFPS();
+    {
+        Profiler::Scope textScope("Text");
+        Profiler::GpuScope textGpuScope("Text");
+
+        StateCache::disable(GL_LIGHTING);
+        StateCache::disable(GL_TEXTURE_2D);
+        StateCache::disable(GL_DEPTH_TEST);
+
+        // Proiezione Ortogonale (Usa la Camera UI Interna)
+        glMatrixMode(GL_PROJECTION);
+        glLoadMatrixf(glm::value_ptr(reserved->uiCamera->getProjectionMatrix()));
+
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(glm::value_ptr(glm::mat4(1.0f)));
+
+        // Testi conservati: geometria gia' pronta se nulla e' cambiato
+        reserved->hud.draw(reserved->textRenderer, reserved->windowWidth, reserved->windowHeight);
+
+        // Tutto il testo immediato del frame finisce in un unico lotto disegnato alla fine
+        TextRenderer& text = reserved->textRenderer;
+        const glm::vec4 white(1.0f);
+
+        // Visualizzazione FPS 
+        if (reserved->show_fps) {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "FPS: %.2f", reserved->fps);
+            text.add(TextRenderer::Font::FIXED_8_BY_13, reserved->windowWidth - 100.0f, reserved->windowHeight - 12.0f, buffer, white);
+
+            // Statistiche della cache di stato OpenGL (frame precedente)
+            StateCache::Stats stats = StateCache::getLastFrameStats();
+            snprintf(buffer, sizeof(buffer), "GL: %u/%u", stats.issued, stats.issued + stats.skipped);
+            text.add(TextRenderer::Font::FIXED_8_BY_13, reserved->windowWidth - 100.0f, reserved->windowHeight - 24.0f, buffer, white);
+
+            // Distribuzione dei tempi di frame: gli scatti si vedono nei percentili alti e nel massimo
+            FrameTimeStats::Summary summary = reserved->frameStats.getSummary();
+            snprintf(buffer, sizeof(buffer), "ms p50 %.1f p95 %.1f p99 %.1f max %.1f", summary.p50, summary.p95, summary.p99, summary.max);
+            text.add(TextRenderer::Font::FIXED_8_BY_13, reserved->windowWidth - 300.0f, reserved->windowHeight - 36.0f, buffer, white);
+        }
+
+        // Visualizzazione Menu
+        float textYPosition = reserved->windowHeight - 12.0f;
+        for (const auto& toPrint : reserved->consoleText) {
+            text.add(TextRenderer::Font::FIXED_8_BY_13, 0.0f, textYPosition, toPrint, white);
+            textYPosition -= 12;
+        }
+
+        // Messaggio di vittoria
+        for (const auto& item : reserved->guiText)
+            text.add(TextRenderer::Font::TIMES_ROMAN_24, item.x, item.y, item.text, glm::vec4(item.r, item.g, item.b, 1.0f));
+
+        // Riepilogo del profiler (ultimo frame chiuso), sotto gli FPS
+        if (reserved->showProfiler) {
+            float y = reserved->windowHeight - (reserved->show_fps ? 52.0f : 40.0f);
+            const glm::vec4 yellow(1.0f, 1.0f, 0.6f, 1.0f);
+            for (const Profiler::Entry& entry : Profiler::getLastFrameBreakdown()) {
+                char buffer[96];
+                if (entry.gpuMs >= 0.0)
+                    snprintf(buffer, sizeof(buffer), "%-16s %6.2f ms  GPU %6.2f ms", entry.name, entry.cpuMs, entry.gpuMs);
+                else
+                    snprintf(buffer, sizeof(buffer), "%-16s %6.2f ms", entry.name, entry.cpuMs);
+                text.add(TextRenderer::Font::FIXED_8_BY_13, reserved->windowWidth - 300.0f, y, buffer, yellow);
+                y -= 12.0f;
+            }
+        }
+
+        text.draw();
+    }
 
-    glDisable(GL_LIGHTING);
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_DEPTH_TEST);
-
-    // Proiezione Ortogonale (Usa la Camera UI Interna)
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(glm::value_ptr(reserved->uiCamera->getProjectionMatrix()));
+    StateCache::enable(GL_LIGHTING);
+    StateCache::endFrame();
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(glm::value_ptr(glm::mat4(1.0f)));
+    Profiler::Scope swapScope("Swap");
+    if (reserved->offscreen.isValid())
+        glFlush();
+    else
+        glutSwapBuffers();
+}
 
-    // Visualizzazione FPS 
-    if (reserved->show_fps) {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "FPS: %.2f", reserved->fps);
-        glRasterPos2f(reserved->windowWidth - 100.0f, reserved->windowHeight - 12.0f);
-        glutBitmapString(GLUT_BITMAP_8_BY_13, (unsigned char*)buffer);
+void Eng::Base::handleDisplayRequest() {
+    reserved->inFrame = true;
+    // Passi fissi per il tempo reale trascorso; dopo una pausa di ON_DEMAND si riparte da zero
+    FramePacer::Clock::time_point frameStart = FramePacer::Clock::now();
+    double frameTime = reserved->idle ? 0.0 : std::chrono::duration<double>(frameStart - reserved->lastFrame).count();
+    bool resumed = reserved->idle;
+    reserved->lastFrame = frameStart;
+    reserved->idle = false;
+    runFrame(frameTime);
+    reserved->inFrame = false;
+
+    // Intervallo dal frame precedente; ripartendo da fermi si conta solo il lavoro di questo frame
+    if (resumed)
+        reserved->frameStats.addFrame(std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - frameStart).count());
+    else
+        reserved->frameStats.addFrame(frameTime * 1000.0);
+
+    // Un picking in corso ha bisogno dei frame successivi per raccogliere il risultato
+    if (reserved->idPicker.isPending()) reserved->pacer.requestRedraw();
+
+    // In pipeline il frame mostra la lista costruita prima dell'input: ne serve uno in piu'
+    if (reserved->pipelined) {
+        reserved->catchUpFrame = !reserved->catchUpFrame;
+        if (reserved->catchUpFrame) reserved->pacer.requestRedraw();
     }
 
-    // Visualizzazione Menu
-    float textYPosition = reserved->windowHeight - 12.0f;
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    for (const auto& toPrint : reserved->consoleText) {
-        glRasterPos2f(0.0f, textYPosition);
-        glutBitmapString(GLUT_BITMAP_8_BY_13, (unsigned char*)toPrint.c_str());
-        textYPosition -= 12;
+    FramePacer::Clock::time_point now = FramePacer::Clock::now();
+    if (!reserved->pacer.frameDone(now, reserved->nextFrame)) {
+        reserved->idle = true; // in attesa di eventi
+        return;
     }
-
-    // Messaggio di vittoria
-    void* guiFont = GLUT_BITMAP_TIMES_ROMAN_24;
-    for (const auto& item : reserved->guiText) {
-        glColor3f(item.r, item.g, item.b);
-        glRasterPos2f(item.x, item.y);
-        glutBitmapString(guiFont, (const unsigned char*)item.text.c_str());
+    if (reserved->nextFrame <= now) {
+        glutPostRedisplay();
+    }
+    else if (!reserved->timerPending) {
+        // Il timer di GLUT sveglia con la precisione del millisecondo: si chiede un millisecondo in
+        // anticipo e il resto lo attende FramePacer::waitUntil(), lasciando gestire gli eventi nel frattempo
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(reserved->nextFrame - now).count() - 1;
+        reserved->timerPending = true;
+        glutTimerFunc((unsigned int)std::max<long long>(ms, 0), glutPacingWrapper, reserved->pacingGeneration);
     }
+}
 
-    glEnable(GL_LIGHTING);
-    glutSwapBuffers();
+void Eng::Base::runFrame(double frameTime) {
+    reserved->frameTime = frameTime;
+    if (reserved->pipelined) {
+        {
+            Profiler::Scope frameScope("Frame");
+            // Scena di nuovo del solo thread OpenGL fino alla prossima richiesta
+            reserved->waitForBuild();
+            reserved->dispatchInput();
+            reserved->idPicker.deliver();
+            if (reserved->clientDisplayCb) {
+                Profiler::Scope scope("Client display");
+                reserved->clientDisplayCb();
+            }
+            // Prima lista, o lista scartata con invalidateSnapshot(): si costruisce qui e la si disegna subito
+            if (!reserved->snapshotReady) {
+                reserved->requestBuild(frameTime);
+                reserved->waitForBuild();
+                reserved->snapshotReady = true;
+                frameTime = 0.0;
+            }
+            // Il frame N si disegna dalla lista gia' pronta mentre il worker prepara N + 1
+            reserved->snapshot = &reserved->snapshots.getReadBuffer();
+            if (reserved->currentCamera) reserved->snapshotView = reserved->currentCamera->getInvCameraMatrix();
+            reserved->snapshotViews.resize(reserved->views.size());
+            for (size_t i = 0; i < reserved->views.size(); i++)
+                reserved->snapshotViews[i] = reserved->views[i].camera->getInvCameraMatrix();
+            // Gli eventi sono del thread OpenGL: il worker vede solo lo stato dei tasti
+            reserved->input.clearEvents();
+            reserved->requestBuild(frameTime);
+            this->render();
+            reserved->snapshot = nullptr;
+        }
+        Profiler::endFrame();
+        return;
+    }
+    {
+        Profiler::Scope frameScope("Frame");
+        reserved->dispatchInput();
+        reserved->idPicker.deliver();
+        if (reserved->clientUpdateCb) {
+            Profiler::Scope scope("Client update");
+            reserved->simulationClock.advance(frameTime, reserved->clientUpdateCb);
+        }
+        if (reserved->clientDisplayCb) {
+            Profiler::Scope scope("Client display");
+            reserved->clientDisplayCb();
+        }
+        this->render();
+    }
+    reserved->input.clearEvents();
+    Profiler::endFrame();
 }
 
-void Eng::Base::handleDisplayRequest() {
-    if (reserved->clientDisplayCb) reserved->clientDisplayCb();
-    this->render();
+void Eng::Base::handlePacingTimer(int generation) {
+    if (generation != reserved->pacingGeneration) return;
+    reserved->timerPending = false;
+    FramePacer::waitUntil(reserved->nextFrame);
+    glutPostRedisplay();
 }
 
 void Eng::Base::handleReshapeRequest(int width, int height) {
+    reserved->waitForBuild();
     if (height == 0) height = 1;
     reserved->windowWidth = width;
     reserved->windowHeight = height;
@@ -216,14 +744,42 @@ void Eng::Base::handleReshapeRequest(int width, int height) {
     reserved->uiCamera->setFrustum(0.0f, (float)width, 0.0f, (float)height, -1.0f, 1.0f);
 
     if (reserved->clientReshapeCb) reserved->clientReshapeCb(width, height);
+    postRedisplay();
 }
 
+// Ogni input puo' cambiare la scena: in ON_DEMAND ne segue un frame. Con l'input in coda le
+// callback arrivano all'inizio di quel frame (dispatchInput()), altrimenti subito
 void Eng::Base::handleKeyboardRequest(unsigned char key, int x, int y) {
-    if (reserved->clientKeyboardCb) reserved->clientKeyboardCb(key, x, y);
+    reserved->waitForBuild();
+    reserved->input.keyboard(key, true, x, y);
+    if (!reserved->inputQueued && reserved->clientKeyboardCb) reserved->clientKeyboardCb(key, x, y);
+    postRedisplay();
 }
 
 void Eng::Base::handleSpecialRequest(int key, int x, int y) {
-    if (reserved->clientSpecialCb) reserved->clientSpecialCb(key, x, y);
+    reserved->waitForBuild();
+    reserved->input.special(key, true, x, y);
+    if (!reserved->inputQueued && reserved->clientSpecialCb) reserved->clientSpecialCb(key, x, y);
+    postRedisplay();
+}
+
+void Eng::Base::handleKeyboardUpRequest(unsigned char key, int x, int y) {
+    reserved->waitForBuild();
+    reserved->input.keyboard(key, false, x, y);
+    postRedisplay();
+}
+
+void Eng::Base::handleSpecialUpRequest(int key, int x, int y) {
+    reserved->waitForBuild();
+    reserved->input.special(key, false, x, y);
+    postRedisplay();
+}
+
+void Eng::Base::handleMouseRequest(int button, int state, int x, int y) {
+    reserved->waitForBuild();
+    reserved->input.mouse(button, state == GLUT_DOWN, x, y);
+    if (!reserved->inputQueued && reserved->clientMouseCb) reserved->clientMouseCb(button, state, x, y);
+    postRedisplay();
 }
 
 void ENG_API Eng::Base::calculateFPS() {
@@ -239,16 +795,57 @@ void ENG_API Eng::Base::calculateFPS() {
 
 void ENG_API Eng::Base::enableFPS() { reserved->show_fps = true; }
 void ENG_API Eng::Base::disableFPS() { reserved->show_fps = false; }
-void Eng::Base::postRedisplay() { glutPostRedisplay(); }
 
-void Eng::Base::addToScreenText(std::string text) { reserved->consoleText.push_back(text); }
+void Eng::Base::setProfiling(bool enable) {
+    Profiler::setEnabled(enable);
+    reserved->showProfiler = enable;
+}
+
+bool Eng::Base::isProfiling() const { return Profiler::isEnabled(); }
+
+bool Eng::Base::saveProfilerTrace(const std::string& path) { return Profiler::writeChromeTrace(path); }
+
+const FrameTimeStats& Eng::Base::getFrameTimeStats() const { return reserved->frameStats; }
+
+FrameTimeStats::Summary Eng::Base::getFrameTimeSummary() const { return reserved->frameStats.getSummary(); }
+
+void Eng::Base::setFrameTimeWindow(unsigned int frames) { reserved->frameStats = FrameTimeStats(frames); }
+
+bool Eng::Base::saveFrameTimeStats(const std::string& path) { return reserved->frameStats.writeReport(path); }
+
+void Eng::Base::setFrameTimeReport(const std::string& path) { reserved->frameStatsReport = path; }
+
+void Eng::Base::postRedisplay() {
+    reserved->pacer.requestRedraw();
+    // Solo in ON_DEMAND il ciclo puo' essere fermo; durante il frame ci pensa handleDisplayRequest()
+    if (reserved->windowCreated && !reserved->inFrame && reserved->pacer.getMode() == FramePacer::Mode::ON_DEMAND)
+        glutPostRedisplay();
+}
+
+void Eng::Base::addToScreenText(std::string text) { reserved->consoleText.push_back(std::move(text)); }
 void Eng::Base::addString(float x, float y, std::string text, float r, float g, float b) {
-    TextRequest req = { text, x, y, r, g, b };
-    reserved->guiText.push_back(req);
+    reserved->guiText.push_back({ std::move(text), x, y, r, g, b });
 }
 void Eng::Base::clearScreenText() { reserved->consoleText.clear(); reserved->guiText.clear(); }
 int Eng::Base::getWindowWidth() { return reserved->windowWidth; }
 int Eng::Base::getWindowHeight() { return reserved->windowHeight; }
+
+bool Eng::Base::pick(const Bvh& bvh, int x, int y, Bvh::PickHit& hit) {
+    hit = Bvh::PickHit();
+    if (!reserved->currentCamera) return false;
+
+    glm::vec3 origin, direction;
+    reserved->currentCamera->getRay((float)x, (float)y, (float)reserved->windowWidth, (float)reserved->windowHeight, origin, direction);
+    return bvh.pick(origin, direction, hit);
+}
+
+bool Eng::Base::requestPick(int x, int y, IdPicker::Callback callback) {
+    return reserved->idPicker.request(x, y, std::move(callback));
+}
+
+bool Eng::Base::isIdPickingSupported() const { return reserved->idPicker.isSupported(); }
+Hud& Eng::Base::getHud() { return reserved->hud; }
+
 int Eng::Base::getTextWidth(const std::string& text) {
-    return glutBitmapLength(GLUT_BITMAP_TIMES_ROMAN_24, (const unsigned char*)text.c_str());
+    return TextRenderer::getTextWidth(TextRenderer::Font::TIMES_ROMAN_24, text);
 }
\ No newline at end of file
@@ -10,6 +10,14 @@
 #include "libConfig.h"
 #include "camera.h"
 #include "list.h"
+#include "bvh.h"
+#include "idPicker.h"
+#include "framePacer.h"
+#include "simulationClock.h"
+#include "offscreenContext.h"
+#include "frameTimeStats.h"
+#include "hud.h"
+#include "inputQueue.h"
 #include <chrono>
 
 
@@ -25,6 +33,20 @@ namespace Eng {
    using KeyboardCallback = std::function<void(unsigned char key, int x, int y)>;
    /** @brief Callback invocata alla pressione di un tasto speciale. */
    using SpecialCallback = std::function<void(int key, int x, int y)>;
+   /** @brief Callback invocata alla pressione o al rilascio di un pulsante del mouse (codici GLUT). */
+   using MouseCallback = std::function<void(int button, int state, int x, int y)>;
+   /** @brief Callback invocata per ogni passo fisso di simulazione (durata del passo in secondi). */
+   using UpdateCallback = SimulationClock::StepCallback;
+   /** @brief Callback del thread di simulazione in modalita' pipeline: riempie la lista (gia' vuota) del frame successivo. */
+   using BuildCallback = std::function<void(List& list)>;
+
+   /**
+    * @brief Modalita' di disegno delle riflessioni planari.
+    */
+   enum class ReflectionMode : int {
+      FULL_SCREEN, ///< La scena specchiata viene disegnata senza ritaglio
+      STENCIL      ///< La scena specchiata viene limitata ai pixel dello specchio (stencil + clip plane)
+   };
 
    /**
     * @class Base
@@ -58,12 +80,16 @@ namespace Eng {
 
       /**
        * @brief Imposta la lista degli oggetti da renderizzare nella scena principale.
+       * @note Se la lista ha un CommandBuffer (List::setCommandBuffer()), ogni frame lo svuota e vi
+       * registra proiezione, pulizia dei buffer e tutti i comandi della scena.
        * @param list Puntatore alla lista di oggetti.
        */
       void setRenderList(List* list);
 
       /**
-       * @brief Imposta la lista degli oggetti per il calcolo delle riflessioni.
+       * @brief Imposta una lista aggiuntiva di oggetti gia' specchiati, disegnata prima della scena.
+       * @note Le mesh dichiarate con Mesh::setReflectionPlane() vengono riflesse automaticamente
+       * a partire dalla lista principale: questa lista serve solo per riflessioni personalizzate.
        * @param list Puntatore alla lista di oggetti riflessi.
        */
       void setReflectionList(List* list);
@@ -74,6 +100,31 @@ namespace Eng {
        */
       void setMainCamera(Camera* camera);
 
+      /**
+       * @brief Aggiunge una vista disegnata sopra quella principale in un riquadro della finestra (es. un'anteprima).
+       *
+       * Tutte le viste usano la lista del frame, costruita una sola volta: ogni vista aggiuntiva scarta
+       * le istanze fuori dal proprio frustum (List::renderCulled()) e costa solo l'invio dei comandi.
+       * Picking e registrazione dei comandi riguardano solo la vista principale.
+       * @param camera Camera della vista; la proporzione della sua proiezione dovrebbe essere quella del riquadro.
+       * @param x Bordo sinistro del riquadro in frazioni della larghezza della finestra (0-1).
+       * @param y Bordo inferiore del riquadro in frazioni dell'altezza della finestra (0-1).
+       * @param width Larghezza del riquadro in frazioni della finestra.
+       * @param height Altezza del riquadro in frazioni della finestra.
+       * @return Indice della vista (le viste sono disegnate in ordine di aggiunta).
+       */
+      int addView(Camera* camera, float x, float y, float width, float height);
+
+      /**
+       * @brief Rimuove tutte le viste aggiunte con addView(); resta solo quella principale.
+       */
+      void clearViews();
+
+      /**
+       * @brief Numero di viste aggiunte, esclusa quella principale.
+       */
+      unsigned int getNumViews() const;
+
       // Gestione Finestra e Loop
       /**
        * @brief Crea la finestra di visualizzazione.
@@ -84,6 +135,36 @@ namespace Eng {
        * @param title Titolo della finestra.
        */
       void createWindow(int width, int height, int x, int y, const char* title);
+
+      /**
+       * @brief Alternativa a createWindow(): crea un contesto senza finestra (EGL) che disegna in un
+       * framebuffer fuori schermo. Non servono server grafico ne' GPU; i frame si disegnano con renderOffscreen().
+       * @param width Larghezza in pixel.
+       * @param height Altezza in pixel.
+       * @return False se il contesto non puo' essere creato.
+       */
+      bool createOffscreen(int width, int height);
+
+      /**
+       * @brief Disegna un numero fisso di frame nel contesto fuori schermo, salvandoli se richiesto.
+       * @param frames Numero di frame.
+       * @param frameTime Durata simulata di ogni frame in secondi (il risultato non dipende dal tempo reale).
+       * @param dumpPrefix Se non vuoto, ogni frame viene salvato in dumpPrefix seguito da 0000.png, 0001.png...
+       * @return Numero di frame disegnati (0 senza contesto fuori schermo).
+       */
+      int renderOffscreen(int frames, double frameTime = 1.0 / 60.0, const std::string& dumpPrefix = "");
+
+      /**
+       * @brief Salva l'ultimo frame del contesto fuori schermo (formato dedotto dall'estensione).
+       * @param path Percorso del file.
+       * @return False senza contesto fuori schermo o se il salvataggio fallisce.
+       */
+      bool saveFrame(const std::string& path);
+
+      /**
+       * @brief Indica se il motore disegna nel contesto fuori schermo.
+       */
+      bool isOffscreen() const;
       
       /**
        * @brief Avvia il ciclo principale (main loop) del motore grafico.
@@ -122,6 +203,107 @@ namespace Eng {
        */
       void setSpecialCallback(SpecialCallback cb);
 
+      /**
+       * @brief Registra la funzione di callback per i pulsanti del mouse.
+       * @param cb Funzione da invocare.
+       */
+      void setMouseCallback(MouseCallback cb);
+
+      /**
+       * @brief Sceglie se l'input arriva al client subito o una volta per frame.
+       *
+       * Di norma le callback di input sono chiamate dentro l'evento di GLUT. In coda gli eventi sono
+       * raccolti tra due frame e consegnati alle callback all'inizio del frame, prima della simulazione;
+       * le ripetizioni automatiche sono disattivate e quelle che arrivano comunque sono fuse (al piu' un
+       * evento per tasto per frame). I movimenti continui conviene leggerli dallo stato (getInput())
+       * e integrarli sul tempo del frame (getFrameTime()) invece di spostarsi a ogni evento.
+       * @param queued True per consegnare l'input una volta per frame.
+       */
+      void setInputQueued(bool queued);
+
+      /**
+       * @brief Indica se l'input e' consegnato una volta per frame.
+       */
+      bool isInputQueued() const;
+
+      /**
+       * @brief Eventi del frame e stato di tasti e pulsanti, aggiornati in entrambe le modalita'.
+       * @note Gli eventi restano disponibili fino alla fine del frame successivo al loro arrivo; in
+       * pipeline fino alla callback di display compresa (la simulazione vede solo lo stato dei tasti).
+       */
+      const InputQueue& getInput() const;
+
+      /**
+       * @brief Tempo in secondi dall'inizio del frame precedente usato dal frame in corso (0 ripartendo da fermi).
+       */
+      double getFrameTime() const;
+
+      /**
+       * @brief Registra la funzione di aggiornamento della simulazione, chiamata a passo fisso prima di
+       * ogni frame (zero o piu' volte) indipendentemente dagli FPS.
+       * @note In FramePacer::Mode::ON_DEMAND i passi avvengono solo quando si disegna: le simulazioni
+       * in corso vanno dichiarate con setAnimating(). Il tempo passato senza frame non viene recuperato.
+       * @param cb Funzione da invocare.
+       */
+      void setUpdateCallback(UpdateCallback cb);
+
+      /**
+       * @brief Configura il passo fisso e i limiti di recupero della simulazione.
+       * @param step Durata di un passo in secondi.
+       * @param maxStepsPerFrame Passi massimi prima di un frame.
+       * @param maxFrameTime Durata massima in secondi considerata per un frame.
+       */
+      void setFixedTimestep(double step, int maxStepsPerFrame = 5, double maxFrameTime = 0.25);
+
+      /**
+       * @brief Imposta la callback che costruisce la lista di rendering in modalita' pipeline.
+       * @param cb Funzione da invocare sul thread di simulazione (nullptr disattiva la pipeline).
+       */
+      void setBuildCallback(BuildCallback cb);
+
+      /**
+       * @brief Attiva o disattiva l'esecuzione in pipeline di simulazione e rendering.
+       *
+       * Un thread dedicato esegue i passi fissi (setUpdateCallback()) e la callback di costruzione
+       * per il frame N + 1 mentre il thread OpenGL disegna il frame N dalla lista prodotta in
+       * precedenza: il frame costa circa il massimo tra simulazione e rendering invece della somma,
+       * al prezzo di un frame di latenza. Le liste passano tra i thread con un TripleBuffer senza lock;
+       * la lista di setRenderList() viene ignorata finche' la pipeline e' attiva.
+       *
+       * @note Simulazione e client condividono la scena: prima di chiamare la callback di display,
+       * quelle di input e quelle del picking (requestPick()) il motore attende la fine della costruzione in corso, quindi queste possono
+       * leggere e modificare la scena liberamente. La callback di costruzione non deve invece usare
+       * OpenGL. Non vanno modificati materiali o geometrie durante la costruzione: il frame
+       * disegnato in parallelo li legge attraverso la lista. La vista della camera viene letta prima
+       * di avviare la costruzione, quindi la camera va mossa dalle callback di input o di display.
+       * @param enable True per attivare (richiede una callback di costruzione).
+       * @return False se manca la callback di costruzione.
+       */
+      bool setPipelined(bool enable);
+
+      /**
+       * @brief Indica se la pipeline di simulazione e rendering e' attiva.
+       */
+      bool isPipelined() const;
+
+      /**
+       * @brief Scarta la lista gia' costruita dalla pipeline: il frame successivo la ricostruisce prima di disegnare.
+       * @note Va chiamata quando una callback distrugge o sostituisce nodi della scena (es. livello
+       * ricaricato), perche' la lista pronta ne conserva i puntatori. Senza pipeline non ha effetto.
+       */
+      void invalidateSnapshot();
+
+      /**
+       * @brief Frazione di passo trascorsa dall'ultimo aggiornamento, in [0, 1): da usare nella callback
+       * di display per interpolare tra lo stato precedente e quello corrente.
+       */
+      float getInterpolationAlpha() const;
+
+      /**
+       * @brief Restituisce l'orologio della simulazione (tempo simulato, passi, tempo scartato).
+       */
+      const SimulationClock& getSimulationClock() const;
+
       // Utility per il Client
 
       /**
@@ -145,6 +327,38 @@ namespace Eng {
        */
       void setTexture(bool enable);
 
+      /**
+       * @brief Sceglie come disegnare le riflessioni delle mesh specchio.
+       * @note In modalita' STENCIL, se la finestra non ha uno stencil buffer si torna a FULL_SCREEN.
+       * @param mode Modalita' desiderata.
+       */
+      void setReflectionMode(ReflectionMode mode);
+
+      /**
+       * @brief Restituisce la modalita' di riflessione corrente.
+       */
+      ReflectionMode getReflectionMode();
+
+      /**
+       * @brief Sceglie quando disegnare i frame (predefinita: FramePacer::Mode::CONTINUOUS).
+       * @note VSYNC imposta l'intervallo di scambio dei buffer a 1 (swap control di WGL/GLX); se il driver
+       * non lo permette si usa FIXED_FPS a targetFps. In ON_DEMAND si disegna solo dopo un input,
+       * postRedisplay() o mentre setAnimating(true) e' attivo.
+       * @param mode Modalita' di cadenza.
+       * @param targetFps Frame al secondo per FIXED_FPS.
+       */
+      void setFramePacing(FramePacer::Mode mode, float targetFps = 60.0f);
+
+      /**
+       * @brief Restituisce la modalita' di cadenza corrente.
+       */
+      FramePacer::Mode getFramePacing() const;
+
+      /**
+       * @brief Dichiara se un'animazione e' in corso: in ON_DEMAND i frame continuano finche' e' true.
+       */
+      void setAnimating(bool animating);
+
       // --- METODI PER LA GESTIONE EVENTI (Chiamati dai wrapper statici) ---
 
       /**
@@ -175,6 +389,37 @@ namespace Eng {
        */
       void handleSpecialRequest(int key, int x, int y);
 
+      /**
+       * @brief Gestisce internamente l'evento di rilascio di un tasto standard.
+       * @param key Codice ASCII del tasto rilasciato.
+       * @param x Coordinata X del mouse al momento del rilascio.
+       * @param y Coordinata Y del mouse al momento del rilascio.
+       */
+      void handleKeyboardUpRequest(unsigned char key, int x, int y);
+
+      /**
+       * @brief Gestisce internamente l'evento di rilascio di un tasto speciale.
+       * @param key Codice del tasto speciale rilasciato.
+       * @param x Coordinata X del mouse al momento del rilascio.
+       * @param y Coordinata Y del mouse al momento del rilascio.
+       */
+      void handleSpecialUpRequest(int key, int x, int y);
+
+      /**
+       * @brief Gestisce internamente l'evento di pressione o rilascio di un pulsante del mouse.
+       * @param button Pulsante (0 sinistro, 1 centrale, 2 destro).
+       * @param state 0 se premuto, 1 se rilasciato.
+       * @param x Coordinata X del mouse.
+       * @param y Coordinata Y del mouse.
+       */
+      void handleMouseRequest(int button, int state, int x, int y);
+
+      /**
+       * @brief Gestisce internamente il timer che avvia il frame successivo in FIXED_FPS.
+       * @param generation Generazione della cadenza che ha programmato il timer (i timer superati sono ignorati).
+       */
+      void handlePacingTimer(int generation);
+
       // No copy
       Base(Base const&) = delete;
       void operator=(Base const&) = delete;
@@ -189,6 +434,56 @@ namespace Eng {
        */
       void disableFPS();
 
+      /**
+       * @brief Attiva o disattiva il profiler di frame e il suo riepilogo a schermo (sezioni CPU e GPU).
+       * @param enable True per attivare.
+       */
+      void setProfiling(bool enable);
+
+      /**
+       * @brief Indica se il profiler di frame e' attivo.
+       */
+      bool isProfiling() const;
+
+      /**
+       * @brief Salva i campioni del profiler nel formato Chrome trace (chrome://tracing, Perfetto).
+       * @param path Percorso del file JSON.
+       * @return False se il file non puo' essere scritto.
+       */
+      bool saveProfilerTrace(const std::string& path);
+
+      /**
+       * @brief Statistiche dei tempi di frame (finestra mobile), mostrate sotto gli FPS con enableFPS().
+       *
+       * Con la finestra si misura l'intervallo tra l'inizio di due frame consecutivi; dopo una pausa di
+       * ON_DEMAND e fuori schermo, dove l'intervallo non dice nulla, la durata del frame stesso.
+       */
+      const FrameTimeStats& getFrameTimeStats() const;
+
+      /**
+       * @brief Minimo, media, p50, p95, p99 e massimo dei tempi di frame nella finestra, in millisecondi.
+       */
+      FrameTimeStats::Summary getFrameTimeSummary() const;
+
+      /**
+       * @brief Cambia il numero di frame della finestra mobile (le statistiche ripartono da zero).
+       * @param frames Numero di frame.
+       */
+      void setFrameTimeWindow(unsigned int frames);
+
+      /**
+       * @brief Salva le statistiche dei tempi di frame in un file JSON.
+       * @param path Percorso del file.
+       * @return False se il file non puo' essere scritto.
+       */
+      bool saveFrameTimeStats(const std::string& path);
+
+      /**
+       * @brief Imposta un file in cui free() salva le statistiche dei tempi di frame all'uscita.
+       * @param path Percorso del file JSON; vuoto per non salvare.
+       */
+      void setFrameTimeReport(const std::string& path);
+
       /**
        * @brief Aggiunge un testo alla lista interna degli elementi da visualizzare.
        * @param text La stringa di testo da aggiungere.
@@ -208,6 +503,8 @@ namespace Eng {
 
       /**
        * @brief Segnala al sistema che la finestra necessita di essere ridisegnata.
+       * @note Nelle modalita' di cadenza continue il frame e' comunque gia' programmato: la richiesta
+       * non supera il limite di FIXED_FPS. Chiamata durante il frame, ne programma un altro in ON_DEMAND.
        */
       void postRedisplay();
       
@@ -235,12 +532,42 @@ namespace Eng {
       int getWindowHeight();
 
       /**
-       * @brief Calcola la larghezza in pixel di una stringa di testo renderizzata.
+       * @brief Calcola la larghezza in pixel di una stringa disegnata con addString() (Times Roman 24).
        * @param text La stringa di cui calcolare la lunghezza.
        * @return Larghezza in pixel.
        */
       int getTextWidth(const std::string& text);
 
+      /**
+       * @brief Testi a schermo conservati tra i frame: da preferire ad addToScreenText() per il testo che cambia di rado.
+       */
+      Hud& getHud();
+
+      /**
+       * @brief Cerca l'oggetto visibile in un punto della finestra con la camera principale.
+       * @param bvh Gerarchia delle mesh della scena, aggiornata (Bvh::refit()).
+       * @param x Coordinata X in pixel, come ricevuta dalle callback.
+       * @param y Coordinata Y in pixel, come ricevuta dalle callback.
+       * @param hit Mesh, punto e distanza colpiti.
+       * @return True se il raggio colpisce un triangolo.
+       */
+      bool pick(const Bvh& bvh, int x, int y, Bvh::PickHit& hit);
+
+      /**
+       * @brief Chiede l'oggetto visibile in un punto della finestra leggendo il buffer degli id sulla GPU.
+       * Il risultato arriva al callback all'inizio di uno dei frame successivi, senza bloccare il rendering.
+       * @param x Coordinata X in pixel, come ricevuta dalle callback.
+       * @param y Coordinata Y in pixel, come ricevuta dalle callback.
+       * @param callback Riceve il nodo colpito o nullptr.
+       * @return False se il picking su GPU non e' disponibile (usare pick()).
+       */
+      bool requestPick(int x, int y, IdPicker::Callback callback);
+
+      /**
+       * @brief Indica se il picking su GPU e' disponibile (dopo createWindow()).
+       */
+      bool isIdPickingSupported() const;
+
    private:
       Base();
       ~Base();
@@ -248,6 +575,17 @@ namespace Eng {
       // PIMPL: Nasconde i dettagli privati (es. header GLUT)
       struct Reserved;
       std::unique_ptr<Reserved> reserved;
+
+      /**
+       * @brief Stato OpenGL iniziale comune a finestra e contesto fuori schermo.
+       */
+      void initContextState();
+
+      /**
+       * @brief Esegue i passi di simulazione dovuti, la callback di display e il rendering di un frame.
+       * @param frameTime Tempo trascorso dal frame precedente in secondi.
+       */
+      void runFrame(double frameTime);
     
       ////FPS:
       bool show_fps;
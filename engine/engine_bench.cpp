@@ -0,0 +1,405 @@
+/**
+ * @file engine_bench.cpp
+ * @brief Benchmark delle strutture spaziali del motore (Standalone).
+ *
+ * Misura costruzione, aggiornamento e interrogazioni della Bvh su scene sintetiche di dimensione
+ * crescente, confrontando le interrogazioni con la ricerca esaustiva sulle stesse scatole, e il
+ * picking sui triangoli di scene con milioni di triangoli, l'aggiornamento delle matrici mondo della
+ * TransformHierarchy e la costruzione della lista di rendering con un numero crescente di thread.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+ // GLM includes
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Engine includes
+#include "node.h"
+#include "mesh.h"
+#include "scene.h"
+#include "frustum.h"
+#include "bvh.h"
+#include "list.h"
+#include "transformHierarchy.h"
+
+namespace {
+
+   using Clock = std::chrono::steady_clock;
+
+   double elapsedMs(Clock::time_point start) {
+      return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+   }
+
+   /** @brief Lato del cubo in cui sono sparse le mesh, scalato per tenere costante la densita'. */
+   float worldSize(int numMeshes) {
+      return 4.0f * std::cbrt((float)numMeshes);
+   }
+
+   void benchScene(int numMeshes) {
+      std::mt19937 rng(1234);
+      const float size = worldSize(numMeshes);
+      std::uniform_real_distribution<float> position(0.0f, size);
+      std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+      Scene scene;
+      Node* root = scene.create<Node>("BenchRoot");
+      scene.setRoot(root);
+      std::vector<Mesh*> meshes;
+      meshes.reserve(numMeshes);
+      for (int i = 0; i < numMeshes; i++) {
+         glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng)));
+         Mesh* mesh = scene.create<Mesh>("BenchMesh", matrix, 0, 0, nullptr, &scene.getArena());
+         mesh->set_all_vertices({ glm::vec3(-0.5f), glm::vec3(0.5f) });
+         root->addChild(mesh);
+         meshes.push_back(mesh);
+      }
+
+      // Scatole mondo pre-calcolate per la ricerca esaustiva di riferimento
+      std::vector<BoundingBox> boxes;
+      boxes.reserve(numMeshes);
+      for (Mesh* mesh : meshes) boxes.push_back(mesh->getBoundingBox().transformed(mesh->getWorldFinalMatrix()));
+
+      Bvh bvh;
+      Clock::time_point start = Clock::now();
+      bvh.build(root);
+      double buildMs = elapsedMs(start);
+
+      // Un decimo delle mesh si sposta di poco, un centesimo attraversa la scena
+      for (int i = 0; i < numMeshes; i += 10) meshes[i]->translate(glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.2f);
+      for (int i = 0; i < numMeshes; i += 100) meshes[i]->translate(glm::vec3(unit(rng), unit(rng), unit(rng)) * size * 0.5f);
+      start = Clock::now();
+      unsigned int reinserted = bvh.refit();
+      double refitMs = elapsedMs(start);
+
+      boxes.clear();
+      for (Mesh* mesh : meshes) boxes.push_back(mesh->getBoundingBox().transformed(mesh->getWorldFinalMatrix()));
+
+      // Raggi dall'esterno verso punti casuali della scena
+      const int numRays = 2000;
+      std::vector<glm::vec3> origins, directions;
+      for (int i = 0; i < numRays; i++) {
+         glm::vec3 origin = glm::vec3(size * 0.5f) + glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng))) * size * 1.5f;
+         origins.push_back(origin);
+         directions.push_back(glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) - origin));
+      }
+
+      Bvh::RayHit hit;
+      int bvhHits = 0;
+      start = Clock::now();
+      for (int i = 0; i < numRays; i++) bvhHits += bvh.raycast(origins[i], directions[i], hit) ? 1 : 0;
+      double rayMs = elapsedMs(start);
+
+      int bruteHits = 0;
+      start = Clock::now();
+      for (int i = 0; i < numRays; i++) {
+         glm::vec3 inverse = BoundingBox::inverseDirection(directions[i]);
+         float nearest = std::numeric_limits<float>::max();
+         float distance;
+         bool found = false;
+         for (const BoundingBox& box : boxes) {
+            if (box.intersectsRay(origins[i], inverse, nearest, distance)) {
+               nearest = distance;
+               found = true;
+            }
+         }
+         bruteHits += found ? 1 : 0;
+      }
+      double bruteRayMs = elapsedMs(start);
+
+      // Frustum stretti (30 gradi) puntati verso il centro da posizioni casuali
+      const int numFrustums = 200;
+      std::vector<Frustum> frustums;
+      for (int i = 0; i < numFrustums; i++) {
+         glm::vec3 eye = glm::vec3(size * 0.5f) + glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng))) * size;
+         glm::mat4 viewProj = glm::perspective(glm::radians(30.0f), 1.0f, 0.5f, size) *
+                              glm::lookAt(eye, glm::vec3(size * 0.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+         frustums.emplace_back(viewProj);
+      }
+
+      std::vector<Mesh*> out;
+      size_t bvhVisible = 0;
+      start = Clock::now();
+      for (const Frustum& frustum : frustums) {
+         out.clear();
+         bvh.query(frustum, out);
+         bvhVisible += out.size();
+      }
+      double frustumMs = elapsedMs(start);
+
+      size_t bruteVisible = 0;
+      start = Clock::now();
+      for (const Frustum& frustum : frustums) {
+         for (const BoundingBox& box : boxes) bruteVisible += frustum.intersects(box) ? 1 : 0;
+      }
+      double bruteFrustumMs = elapsedMs(start);
+
+      // Sovrapposizione con scatole di lato 4 (circa una mesh ciascuna)
+      const int numBoxes = 2000;
+      std::vector<BoundingBox> regions;
+      for (int i = 0; i < numBoxes; i++) {
+         glm::vec3 corner(position(rng), position(rng), position(rng));
+         regions.emplace_back(corner, corner + glm::vec3(4.0f));
+      }
+
+      size_t bvhOverlaps = 0;
+      start = Clock::now();
+      for (const BoundingBox& region : regions) {
+         out.clear();
+         bvh.query(region, out);
+         bvhOverlaps += out.size();
+      }
+      double overlapMs = elapsedMs(start);
+
+      size_t bruteOverlaps = 0;
+      start = Clock::now();
+      for (const BoundingBox& region : regions) {
+         for (const BoundingBox& box : boxes) bruteOverlaps += box.overlaps(region) ? 1 : 0;
+      }
+      double bruteOverlapMs = elapsedMs(start);
+
+      std::printf("%7d mesh | altezza %2d | build %8.2f ms | refit %7.2f ms (%u reinserite)\n",
+                  numMeshes, bvh.getHeight(), buildMs, refitMs, reinserted);
+      std::printf("          raggi      %10.0f/s  (esaustivo %10.0f/s)  colpi %d/%d\n",
+                  numRays / rayMs * 1000.0, numRays / bruteRayMs * 1000.0, bvhHits, bruteHits);
+      std::printf("          frustum    %10.0f/s  (esaustivo %10.0f/s)  visibili %zu/%zu\n",
+                  numFrustums / frustumMs * 1000.0, numFrustums / bruteFrustumMs * 1000.0, bvhVisible, bruteVisible);
+      std::printf("          scatole    %10.0f/s  (esaustivo %10.0f/s)  trovate %zu/%zu\n",
+                  numBoxes / overlapMs * 1000.0, numBoxes / bruteOverlapMs * 1000.0, bvhOverlaps, bruteOverlaps);
+   }
+
+   /** @brief Albero di nodi con @p fanout figli per nodo fino a circa @p numNodes nodi. */
+   Node* createTree(Scene& scene, int numNodes, int fanout) {
+      std::mt19937 rng(99);
+      std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+      Node* root = scene.create<Node>("TreeRoot");
+      scene.setRoot(root);
+      std::vector<Node*> frontier{ root };
+      int created = 1;
+      for (size_t next = 0; next < frontier.size() && created < numNodes; next++) {
+         for (int c = 0; c < fanout && created < numNodes; c++, created++) {
+            glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(offset(rng), offset(rng), offset(rng)));
+            Mesh* mesh = scene.create<Mesh>("TreeMesh", matrix, 0, 0, nullptr, &scene.getArena());
+            mesh->set_all_vertices({ glm::vec3(-0.5f), glm::vec3(0.5f) });
+            frontier[next]->addChild(mesh);
+            frontier.push_back(mesh);
+         }
+      }
+      return root;
+   }
+
+   /** @brief Costruzione della lista di rendering: pass() e passParallel() con 1, 2, 4, 8 thread. */
+   void benchTraversal(int numNodes) {
+      const int runs = 10;
+      Scene scene;
+      Node* root = createTree(scene, numNodes, 8);
+      TransformHierarchy hierarchy;
+      hierarchy.build(root);
+      List list;
+
+      auto measure = [&](auto&& build) {
+         double best = std::numeric_limits<double>::max();
+         for (int i = 0; i < runs; i++) {
+            list.clear();
+            Clock::time_point start = Clock::now();
+            build();
+            best = std::min(best, elapsedMs(start));
+         }
+         return best;
+      };
+
+      double serialMs = measure([&]() { list.pass(root, glm::mat4(1.0f)); });
+      unsigned int instances = list.getNumInstances();
+      std::printf("%7d nodi | pass seriale %8.2f ms (%u istanze, %u core)\n", numNodes, serialMs, instances,
+                  std::max(1u, std::thread::hardware_concurrency()));
+      for (unsigned int threads : { 1u, 2u, 4u, 8u }) {
+         double parallelMs = measure([&]() { list.passParallel(root, glm::mat4(1.0f), threads); });
+         bool same = list.getNumInstances() == instances;
+         double flatMs = measure([&]() { list.passParallel(hierarchy, threads); });
+         same = same && list.getNumInstances() == instances;
+         std::printf("          %u thread  grafo %8.2f ms (x%.2f) | gerarchia %8.2f ms (x%.2f)%s\n", threads,
+                     parallelMs, serialMs / parallelMs, flatMs, serialMs / flatMs, same ? "" : "  DIVERSO");
+      }
+   }
+
+   /** @brief Aggiornamento delle matrici mondo e lista costruita dagli array della gerarchia. */
+   void benchHierarchy(int numNodes) {
+      const int runs = 20;
+      Scene scene;
+      Node* root = createTree(scene, numNodes, 8);
+      TransformHierarchy hierarchy;
+      hierarchy.build(root);
+      hierarchy.update();
+
+      // Tutte le voci: la radice spostata a ogni ripetizione
+      double fullMs = std::numeric_limits<double>::max();
+      for (int i = 0; i < runs; i++) {
+         root->translate(glm::vec3(0.0f, 0.0f, 0.01f));
+         Clock::time_point start = Clock::now();
+         hierarchy.update();
+         fullMs = std::min(fullMs, elapsedMs(start));
+      }
+      unsigned int updated = hierarchy.getLastUpdateCount();
+
+      // Una sola foglia modificata
+      Node* leaf = hierarchy.getNodes().back();
+      double leafMs = std::numeric_limits<double>::max();
+      for (int i = 0; i < runs; i++) {
+         leaf->translate(glm::vec3(0.01f, 0.0f, 0.0f));
+         Clock::time_point start = Clock::now();
+         hierarchy.update();
+         leafMs = std::min(leafMs, elapsedMs(start));
+      }
+
+      List list;
+      double visitMs = std::numeric_limits<double>::max();
+      double flatMs = std::numeric_limits<double>::max();
+      for (int i = 0; i < runs / 4; i++) {
+         list.clear();
+         Clock::time_point start = Clock::now();
+         list.pass(root, glm::mat4(1.0f));
+         visitMs = std::min(visitMs, elapsedMs(start));
+         list.clear();
+         start = Clock::now();
+         list.pass(hierarchy);
+         flatMs = std::min(flatMs, elapsedMs(start));
+      }
+
+      std::printf("%7d nodi | update completo %7.3f ms (%u matrici) | una foglia %7.3f ms\n",
+                  numNodes, fullMs, updated, leafMs);
+      std::printf("          lista      visita del grafo %7.2f ms | array della gerarchia %7.2f ms\n", visitMs, flatMs);
+   }
+
+   /** @brief Griglia ondulata di size x size quadrati (2 * size^2 triangoli). */
+   Mesh* createTerrain(Scene& scene, int size, const glm::mat4& matrix) {
+      std::vector<glm::vec3> vertices;
+      std::vector<std::vector<unsigned int>> faces;
+      vertices.reserve((size + 1) * (size + 1));
+      faces.reserve(2 * size * size);
+      for (int z = 0; z <= size; z++) for (int x = 0; x <= size; x++) {
+         vertices.push_back(glm::vec3(x - size * 0.5f, std::sin(x * 0.05f) * std::cos(z * 0.07f) * 10.0f, z - size * 0.5f));
+      }
+      for (int z = 0; z < size; z++) for (int x = 0; x < size; x++) {
+         unsigned int i = z * (size + 1) + x;
+         faces.push_back({ i, i + 1, i + size + 1 });
+         faces.push_back({ i + 1, i + size + 2, i + size + 1 });
+      }
+      Mesh* mesh = scene.create<Mesh>("Terreno", matrix, 0, 0, nullptr, &scene.getArena());
+      mesh->set_all_vertices(vertices);
+      mesh->set_face_vertices(faces);
+      return mesh;
+   }
+
+   void benchPicking(int numMeshes, int gridSize) {
+      Scene scene;
+      Node* root = scene.create<Node>("PickRoot");
+      scene.setRoot(root);
+      std::vector<Mesh*> meshes;
+      for (int i = 0; i < numMeshes; i++) {
+         glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3((i % 2) * gridSize, (i / 2) * 20.0f, (i / 2 % 2) * gridSize * 0.5f)) *
+                            glm::rotate(glm::mat4(1.0f), glm::radians(15.0f * i), glm::vec3(0.0f, 1.0f, 0.0f));
+         Mesh* mesh = createTerrain(scene, gridSize, matrix);
+         root->addChild(mesh);
+         meshes.push_back(mesh);
+      }
+
+      Bvh bvh;
+      Clock::time_point start = Clock::now();
+      bvh.build(root);
+      double buildMs = elapsedMs(start);
+      unsigned int numTriangles = 0;
+      for (Mesh* mesh : meshes) numTriangles += mesh->getTriangleBvh().getNumTriangles();
+
+      // Raggi dall'alto verso punti casuali della scena, come un click su una vista dall'alto
+      std::mt19937 rng(99);
+      BoundingBox bounds = bvh.getBounds();
+      std::uniform_real_distribution<float> x(bounds.getMin().x, bounds.getMax().x);
+      std::uniform_real_distribution<float> z(bounds.getMin().z, bounds.getMax().z);
+      const int numPicks = 10000;
+      std::vector<glm::vec3> origins, directions;
+      glm::vec3 eye = bounds.getCenter() + glm::vec3(0.0f, bounds.getExtent().y + gridSize, gridSize * 0.5f);
+      for (int i = 0; i < numPicks; i++) {
+         origins.push_back(eye);
+         directions.push_back(glm::normalize(glm::vec3(x(rng), bounds.getMin().y, z(rng)) - eye));
+      }
+
+      Bvh::PickHit hit;
+      int hits = 0;
+      double worstUs = 0.0;
+      start = Clock::now();
+      for (int i = 0; i < numPicks; i++) {
+         Clock::time_point pickStart = Clock::now();
+         hits += bvh.pick(origins[i], directions[i], hit) ? 1 : 0;
+         worstUs = std::max(worstUs, elapsedMs(pickStart) * 1000.0);
+      }
+      double pickMs = elapsedMs(start);
+
+      // Verifica su pochi raggi contro il test esaustivo di tutti i triangoli
+      const int numChecks = 20;
+      int mismatches = 0;
+      start = Clock::now();
+      for (int i = 0; i < numChecks; i++) {
+         float best = std::numeric_limits<float>::max();
+         for (Mesh* mesh : meshes) {
+            glm::mat4 toLocal = glm::inverse(mesh->getWorldFinalMatrix());
+            glm::vec3 o = glm::vec3(toLocal * glm::vec4(origins[i], 1.0f));
+            glm::vec3 d = glm::vec3(toLocal * glm::vec4(directions[i], 0.0f));
+            const auto& vertices = mesh->get_all_vertices();
+            for (const auto& face : mesh->get_face_vertices()) {
+               glm::vec3 a = vertices[face[0]];
+               glm::vec3 e1 = vertices[face[1]] - a, e2 = vertices[face[2]] - a;
+               glm::vec3 p = glm::cross(d, e2);
+               float det = glm::dot(e1, p);
+               if (std::abs(det) < 1e-12f) continue;
+               glm::vec3 s = o - a;
+               float u = glm::dot(s, p) / det;
+               glm::vec3 q = glm::cross(s, e1);
+               float v = glm::dot(d, q) / det;
+               float t = glm::dot(e2, q) / det;
+               if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best) best = t;
+            }
+         }
+         bool found = bvh.pick(origins[i], directions[i], hit);
+         if (found != (best < std::numeric_limits<float>::max()) || (found && std::abs(hit.distance - best) > 0.01f)) mismatches++;
+      }
+      double bruteMs = elapsedMs(start);
+
+      std::printf("%7u triangoli in %d mesh | build %8.2f ms (scatole + triangoli)\n", numTriangles, numMeshes, buildMs);
+      std::printf("          pick       %10.2f us medio, %8.2f us peggiore  colpi %d/%d\n",
+                  pickMs * 1000.0 / numPicks, worstUs, hits, numPicks);
+      std::printf("          esaustivo  %10.2f us medio  differenze %d/%d\n", bruteMs * 1000.0 / numChecks, mismatches, numChecks);
+   }
+
+}
+
+int main() {
+   std::printf("==========================================\n");
+   std::printf("        ENGINE BENCHMARK: BVH             \n");
+   std::printf("==========================================\n");
+
+   for (int numMeshes : { 1000, 10000, 100000 }) benchScene(numMeshes);
+
+   std::printf("------------------------------------------\n");
+   std::printf("        PICKING SUI TRIANGOLI             \n");
+   std::printf("------------------------------------------\n");
+   benchPicking(4, 250);
+   benchPicking(8, 400);
+
+   std::printf("------------------------------------------\n");
+   std::printf("        GERARCHIA DI TRASFORMAZIONI       \n");
+   std::printf("------------------------------------------\n");
+   for (int numNodes : { 10000, 100000 }) benchHierarchy(numNodes);
+
+   std::printf("------------------------------------------\n");
+   std::printf("        LISTA DI RENDERING PARALLELA      \n");
+   std::printf("------------------------------------------\n");
+   for (int numNodes : { 10000, 100000 }) benchTraversal(numNodes);
+   return 0;
+}
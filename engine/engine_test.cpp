@@ -9,6 +9,7 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <string>
 
  // GLM includes
 #include <glm/glm.hpp>
@@ -26,6 +27,39 @@
 #include "infiniteLight.h"
 #include "spotLight.h"
 #include "list.h"
+#include "stateCache.h"
+#include "boundingBox.h"
+#include "frustum.h"
+#include "lightManager.h"
+#include "commandBuffer.h"
+#include "transformHierarchy.h"
+#include "nameIndex.h"
+#include "nameTable.h"
+#include "arena.h"
+#include "scene.h"
+#include "ovoReader.h"
+#include "handle.h"
+#include "objectRegistry.h"
+#include "bvh.h"
+#include "triangleBvh.h"
+#include "idPicker.h"
+#include "framePacer.h"
+#include "simulationClock.h"
+#include "offscreenContext.h"
+#include "profiler.h"
+#include "frameTimeStats.h"
+#include "textRenderer.h"
+#include "hud.h"
+#include "tripleBuffer.h"
+#include "threadPool.h"
+#include "inputQueue.h"
+#include "engine.h"
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include "perspectiveCamera.h"
+#include <cstdio>
+#include <GL/freeglut.h>
 
 // Macro di utilit per il confronto float
 #define EPSILON 0.0001f
@@ -33,6 +67,12 @@ bool areVec3Equal(const glm::vec3& a, const glm::vec3& b) {
    return glm::length(a - b) < EPSILON;
 }
 
+bool areMatricesEqual(const glm::mat4& a, const glm::mat4& b) {
+   for (int c = 0; c < 4; c++)
+      if (glm::length(a[c] - b[c]) > 0.001f) return false;
+   return true;
+}
+
 int main() {
    std::cout << "==========================================" << std::endl;
    std::cout << "      AVVIO ENGINE TEST SUITE (MAIN)      " << std::endl;
@@ -215,6 +255,1817 @@ int main() {
 
    std::cout << "OK" << std::endl;
 
+   // ------------------------------------------------------------------------
+   // 8. TESTING LIST PARALLELA (passParallel == pass)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] List parallela... ";
+
+   {
+      // Mock che espone i bucket protetti della lista
+      struct ListProbe : public List {
+         const Buckets& getBuckets() const { return instances; }
+      };
+
+      Material* glass = new Material("Vetro", emission, ambient, diffuse, specular, shininess, 0.5f);
+      std::vector<Node*> allNodes;
+      Node* bigRoot = new Node("BigRoot");
+      allNodes.push_back(bigRoot);
+
+      // Albero sbilanciato: alcuni rami profondi, altri larghi, con luci e trasparenze
+      std::vector<Node*> frontier{ bigRoot };
+      for (int level = 0; level < 6; level++) {
+         std::vector<Node*> nextLevel;
+         for (size_t p = 0; p < frontier.size(); p++) {
+            int fanOut = (p % 3 == 0) ? 4 : 2;
+            for (int c = 0; c < fanOut; c++) {
+               Node* n;
+               int kind = (int)(allNodes.size() % 7);
+               if (kind == 0)
+                  n = new OmnidirectionalLight("L" + std::to_string(allNodes.size()), glm::mat4(1.0f), ambient, diffuse, specular);
+               else if (kind == 1)
+                  n = new Mesh("T" + std::to_string(allNodes.size()), glm::mat4(1.0f), 0, 0, glass);
+               else
+                  n = new Mesh("M" + std::to_string(allNodes.size()), glm::mat4(1.0f), 0, 0, mat);
+               n->translate(glm::vec3((float)c, 0.5f * level, -0.25f * p));
+               n->rotate(3.0f * c + level, glm::vec3(0.0f, 1.0f, 0.0f));
+               frontier[p]->addChild(n);
+               allNodes.push_back(n);
+               nextLevel.push_back(n);
+            }
+         }
+         frontier = nextLevel;
+      }
+
+      ListProbe serial, parallel;
+      glm::mat4 base = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+      serial.pass(bigRoot, base);
+      parallel.passParallel(bigRoot, base, 4);
+
+      auto sameBucket = [](const auto& a, const auto& b) {
+         if (a.size() != b.size()) return false;
+         for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].node != b[i].node || a[i].nodeWorldMatrix != b[i].nodeWorldMatrix) return false;
+         }
+         return true;
+      };
+      const auto& s = serial.getBuckets();
+      const auto& p = parallel.getBuckets();
+      assert(s.lights.size() + s.opaque.size() + s.transparent.size() == allNodes.size());
+      assert(!s.lights.empty() && !s.transparent.empty());
+      assert(sameBucket(s.lights, p.lights));
+      assert(sameBucket(s.opaque, p.opaque));
+      assert(sameBucket(s.transparent, p.transparent));
+
+      // I thread del pool restano tra una costruzione e l'altra
+      unsigned int workers = ThreadPool::getShared().getNumWorkers();
+      assert(workers >= 3);
+      ListProbe again;
+      again.passParallel(bigRoot, base, 4);
+      assert(sameBucket(s.opaque, again.getBuckets().opaque));
+      assert(ThreadPool::getShared().getNumWorkers() == workers);
+
+      for (Node* n : allNodes) delete n;
+      delete glass;
+   }
+
+   {
+      // Ogni thread richiesto esegue la funzione una volta, il chiamante compreso
+      ThreadPool pool;
+      std::atomic<int> calls{ 0 };
+      assert(pool.run(4, [&]() { calls++; }) == 4 && calls == 4);
+      assert(pool.getNumWorkers() == 3);
+      assert(pool.run(2, [&]() { calls++; }) == 2 && calls == 6);
+      assert(pool.run(1, [&]() { calls++; }) == 1 && calls == 7);
+      assert(pool.getNumWorkers() == 3);
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 9. TESTING STATE CACHE (solo conteggi: senza contesto le chiamate GL sono no-op)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] State Cache... ";
+
+   StateCache::invalidate();
+   StateCache::endFrame();
+   StateCache::enable(GL_LIGHTING);
+   StateCache::enable(GL_LIGHTING);            // ridondante
+   StateCache::disable(GL_LIGHTING);
+   StateCache::material(GL_DIFFUSE, glm::vec4(1.0f));
+   StateCache::material(GL_DIFFUSE, glm::vec4(1.0f)); // ridondante
+   StateCache::bindTexture2D(3);
+   StateCache::forgetTexture(3);               // il binding torna a 0
+   StateCache::bindTexture2D(0);               // ridondante
+
+   StateCache::Stats frame = StateCache::getFrameStats();
+   assert(frame.issued == 4);
+   assert(frame.skipped == 3);
+
+   StateCache::endFrame();
+   assert(StateCache::getLastFrameStats().issued == 4);
+   assert(StateCache::getFrameStats().issued == 0);
+
+   // Dopo l'invalidazione lo stato e' sconosciuto: la chiamata viene emessa
+   StateCache::invalidate();
+   StateCache::disable(GL_LIGHTING);
+   assert(StateCache::getFrameStats().issued == 1);
+   StateCache::invalidate();
+   StateCache::endFrame();
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 10. TESTING BOUNDING BOX & FRUSTUM
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Bounding Box & Frustum... ";
+
+   {
+      BoundingBox box;
+      assert(box.isEmpty());
+      box.expand(glm::vec3(-1.0f, 0.0f, -1.0f));
+      box.expand(glm::vec3(1.0f, 2.0f, 1.0f));
+      assert(!box.isEmpty());
+      assert(box.getCenter() == glm::vec3(0.0f, 1.0f, 0.0f));
+
+      // Traslazione + rotazione di 90 gradi: le dimensioni su X e Z si scambiano
+      glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 10.0f, 0.0f));
+      world = glm::rotate(world, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+      BoundingBox worldBox = box.transformed(world);
+      assert(std::abs(worldBox.getExtent().x - 1.0f) < 0.001f);
+      assert(std::abs(worldBox.getExtent().y - 1.0f) < 0.001f);
+
+      // Piano y = 5: la scatola (y tra 9 e 11) sta tutta sopra
+      assert(std::abs(worldBox.minPlaneDistance(glm::vec4(0.0f, 1.0f, 0.0f, -5.0f)) - 4.0f) < 0.001f);
+      assert(worldBox.minPlaneDistance(glm::vec4(0.0f, 1.0f, 0.0f, -10.0f)) < 0.0f);
+
+      // Camera all'origine che guarda verso -Z
+      glm::mat4 proj = glm::perspective(glm::radians(60.0f), 1.0f, 1.0f, 100.0f);
+      Frustum frustum(proj);
+      assert(frustum.intersects(BoundingBox(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f))));
+      assert(!frustum.intersects(BoundingBox(glm::vec3(-1.0f, -1.0f, 9.0f), glm::vec3(1.0f, 1.0f, 11.0f))));
+      assert(!frustum.intersects(BoundingBox(glm::vec3(-1.0f, -1.0f, -300.0f), glm::vec3(1.0f, 1.0f, -200.0f))));
+      assert(frustum.intersects(glm::vec3(0.0f, 0.0f, -50.0f), 1.0f));
+      assert(!frustum.intersects(glm::vec3(200.0f, 0.0f, -50.0f), 1.0f));
+
+      // La mesh calcola la propria scatola dai vertici
+      Mesh boxed("Boxed", glm::mat4(1.0f), 0, 0, mat);
+      boxed.set_all_vertices({ glm::vec3(0.0f), glm::vec3(2.0f, 3.0f, 4.0f) });
+      assert(boxed.getBoundingBox().getMax() == glm::vec3(2.0f, 3.0f, 4.0f));
+      assert(!boxed.isReflector());
+      boxed.setReflectionPlane(glm::vec4(0.0f, 1.0f, 0.0f, 0.0f));
+      assert(boxed.isReflector());
+      boxed.clearReflectionPlane();
+      assert(!boxed.isReflector());
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 11. TESTING LIGHT MANAGER (piu' di 8 luci nella scena)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Light Manager... ";
+
+   {
+      LightManager manager;
+      std::vector<Light*> sceneLights;
+
+      // 12 luci puntiformi allineate sull'asse X, una ogni 10 unita', raggio 25
+      for (int i = 0; i < 12; i++) {
+         glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f * i, 0.0f, 0.0f));
+         Light* l = new OmnidirectionalLight("P" + std::to_string(i), world, ambient, diffuse, specular);
+         l->setRadius(25.0f);
+         sceneLights.push_back(l);
+      }
+      Light* sun = new InfiniteLight("Sole", glm::mat4(1.0f), ambient, diffuse, specular, glm::vec3(0.0f, -1.0f, 0.0f));
+      sceneLights.push_back(sun);
+
+      manager.begin(glm::mat4(1.0f));
+      for (Light* l : sceneLights) manager.addLight(l, glm::translate(glm::mat4(1.0f), glm::vec3(l->getM()[3])));
+      assert(manager.getNumLights() == 13);
+
+      // Oggetto vicino alla luce 0: solo le luci entro il raggio (0, 1, 2) piu' il sole
+      std::vector<int> chosen;
+      manager.select(BoundingBox(glm::vec3(-1.0f), glm::vec3(1.0f)), chosen);
+      assert((chosen == std::vector<int>{ 0, 1, 2, 12 }));
+
+      // Oggetto enorme: tutte le luci lo raggiungono, ne restano 8 (il sole e' sempre incluso)
+      manager.select(BoundingBox(glm::vec3(-200.0f), glm::vec3(200.0f)), chosen);
+      assert(chosen.size() == LightManager::MAX_LIGHTS);
+      assert(chosen.back() == 12);
+
+      // Oggetto in fondo alla fila: le luci scelte sono le piu' vicine
+      manager.select(BoundingBox(glm::vec3(109.0f, -1.0f, -1.0f), glm::vec3(111.0f, 1.0f, 1.0f)), chosen);
+      assert((chosen == std::vector<int>{ 9, 10, 11, 12 }));
+
+      // Due oggetti consecutivi con le stesse luci: nessuna riassegnazione degli slot
+      BoundingBox nearFirst(glm::vec3(-1.0f), glm::vec3(1.0f));
+      manager.bind(nearFirst);
+      unsigned int rebinds = manager.getRebindCount();
+      assert(rebinds == 4);
+      manager.bind(nearFirst);
+      assert(manager.getRebindCount() == rebinds);
+
+      // Oggetto vicino alla luce 3: restano il sole e le luci 1 e 2, entrano 3, 4 e 5
+      manager.bind(BoundingBox(glm::vec3(29.0f, -1.0f, -1.0f), glm::vec3(31.0f, 1.0f, 1.0f)));
+      assert(manager.getRebindCount() == rebinds + 3);
+
+      for (Light* l : sceneLights) delete l;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 12. TESTING COMMAND BUFFER (registrazione, salvataggio e riproduzione)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Command Buffer... ";
+
+   {
+      Material* glass = new Material("Vetro", emission, ambient, diffuse, specular, shininess, 0.5f);
+      Node* sceneRoot = new Node("CaptureRoot");
+      Light* lamp = new OmnidirectionalLight("Lampada", glm::mat4(1.0f), ambient, diffuse, specular);
+
+      // Due triangoli opachi (stessa mesh usata due volte) e uno trasparente
+      std::vector<glm::vec3> tri = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+      std::vector<glm::vec3> normals(3, glm::vec3(0.0f, 0.0f, 1.0f));
+      Mesh* solid = new Mesh("Solido", glm::mat4(1.0f), 1, 3, mat);
+      Mesh* clear = new Mesh("Trasparente", glm::mat4(1.0f), 1, 3, glass);
+      for (Mesh* m : { solid, clear }) {
+         m->set_all_vertices(tri);
+         m->set_all_normals(normals);
+         m->set_face_vertices({ { 0, 1, 2 } });
+      }
+      sceneRoot->addChild(lamp);
+      sceneRoot->addChild(solid);
+      sceneRoot->addChild(clear);
+
+      List capture;
+      CommandBuffer recorded;
+      capture.pass(sceneRoot, glm::mat4(1.0f));
+      capture.setCommandBuffer(&recorded);
+      capture.render(glm::mat4(1.0f));
+      capture.render(glm::mat4(1.0f)); // seconda passata: la mesh e' gia' nella tabella
+      capture.setCommandBuffer(nullptr);
+      assert(recorded.getNumCommands() > 0);
+      assert(recorded.getNumMeshes() == 2);
+
+      CommandBuffer::Stats live = recorded.replay();
+      assert(live.commands == recorded.getNumCommands());
+      assert(live.drawCalls == 4);
+      assert(live.triangles == 4);
+
+      // Dopo detach() la scena puo' essere distrutta; il file contiene tutto il necessario
+      recorded.detach();
+      const std::string capturePath = "engine_test_capture.ecmd";
+      assert(recorded.save(capturePath));
+      for (Node* n : std::vector<Node*>{ lamp, solid, clear, sceneRoot }) delete n;
+      delete glass;
+
+      CommandBuffer loaded;
+      assert(loaded.load(capturePath));
+      std::remove(capturePath.c_str());
+      assert(loaded.getNumCommands() == recorded.getNumCommands());
+      assert(loaded.getSizeInBytes() == recorded.getSizeInBytes());
+
+      CommandBuffer::Stats immediate = loaded.replay(CommandBuffer::Backend::IMMEDIATE);
+      CommandBuffer::Stats arrays = loaded.replay(CommandBuffer::Backend::VERTEX_ARRAY);
+      assert(immediate.commands == live.commands && immediate.triangles == live.triangles);
+      assert(arrays.drawCalls == live.drawCalls && arrays.triangles == live.triangles);
+
+      // Un file non valido viene rifiutato
+      assert(!loaded.load("file_inesistente.ecmd"));
+
+      // Conteggi corrotti: rifiutati senza allocare (niente bad_alloc)
+      const std::string corruptPath = "engine_test_corrupt.ecmd";
+      auto writeCorrupt = [&](const std::vector<uint32_t>& values) {
+         std::ofstream out(corruptPath, std::ios::binary);
+         out.write("ECMD", 4);
+         for (uint32_t value : values) out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      };
+      writeCorrupt({ 1u, 0xFFFFFFFFu });                        // tabella delle texture
+      assert(!loaded.load(corruptPath) && loaded.getNumCommands() == 0);
+      writeCorrupt({ 1u, 1u, 0x7FFFFFFFu });                    // lunghezza di un percorso
+      assert(!loaded.load(corruptPath));
+      writeCorrupt({ 1u, 0u, 0u, 0u, 5u, 0xFFFFFFFFu });        // comandi
+      assert(!loaded.load(corruptPath) && loaded.getSizeInBytes() == 0);
+      std::remove(corruptPath.c_str());
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 13. TESTING CACHE DELLE MATRICI MONDO
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] World Matrix Cache... ";
+
+   {
+      // Catena profonda: ogni livello trasla di 1 su Y
+      std::vector<Node*> chain;
+      Node* chainRoot = new Node("ChainRoot");
+      chain.push_back(chainRoot);
+      for (int i = 0; i < 50; i++) {
+         Node* n = new Node("Anello" + std::to_string(i));
+         n->translate(glm::vec3(0.0f, 1.0f, 0.0f));
+         chain.back()->addChild(n);
+         chain.push_back(n);
+      }
+      Node* leaf = chain.back();
+      assert(areVec3Equal(glm::vec3(leaf->getWorldFinalMatrix()[3]), glm::vec3(0.0f, 50.0f, 0.0f)));
+
+      // Una modifica alla radice invalida tutti i discendenti
+      chainRoot->translate(glm::vec3(5.0f, 0.0f, 0.0f));
+      assert(areVec3Equal(glm::vec3(leaf->getWorldFinalMatrix()[3]), glm::vec3(5.0f, 50.0f, 0.0f)));
+
+      // Modifica intermedia dopo che solo una parte della catena e' stata ricalcolata
+      chain[25]->getWorldFinalMatrix();
+      chain[10]->setM(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 2.0f)));
+      assert(areVec3Equal(glm::vec3(chain[25]->getWorldFinalMatrix()[3]), glm::vec3(5.0f, 25.0f, 2.0f)));
+      assert(areVec3Equal(glm::vec3(leaf->getWorldFinalMatrix()[3]), glm::vec3(5.0f, 50.0f, 2.0f)));
+
+      // Cambio di genitore: il sottoalbero staccato perde le trasformazioni degli antenati
+      chain[39]->removeChild(chain[40]);
+      assert(areVec3Equal(glm::vec3(leaf->getWorldFinalMatrix()[3]), glm::vec3(0.0f, 11.0f, 0.0f)));
+      Node* other = new Node("AltroGenitore");
+      other->translate(glm::vec3(0.0f, 0.0f, -3.0f));
+      other->addChild(chain[40]);
+      assert(areVec3Equal(glm::vec3(leaf->getWorldFinalMatrix()[3]), glm::vec3(0.0f, 11.0f, -3.0f)));
+
+      delete other;
+      for (Node* n : chain) delete n;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 14. TESTING GERARCHIA DI TRASFORMAZIONI PIATTA
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Transform Hierarchy... ";
+
+   {
+      // Il prodotto vettorizzato coincide con quello di GLM
+      glm::mat4 ma = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, -2.0f, 3.0f)), 0.7f, glm::vec3(0.3f, 1.0f, 0.2f));
+      glm::mat4 mb = glm::scale(glm::rotate(glm::mat4(1.0f), -1.1f, glm::vec3(1.0f, 0.0f, 0.5f)), glm::vec3(2.0f, 0.5f, 1.5f));
+      glm::mat4 product;
+      TransformHierarchy::multiply(ma, mb, product);
+      assert(areMatricesEqual(product, ma * mb));
+
+      // Scena: Esterno -> Radice -> { A1 -> A2 -> A3, B1 -> B2 -> B3 }
+      Node* outer = new Node("Esterno");
+      Node* hRoot = new Node("Radice");
+      Node* a[3];
+      Node* b[3];
+      outer->addChild(hRoot);
+      hRoot->translate(glm::vec3(1.0f, 0.0f, 0.0f));
+      for (int i = 0; i < 3; i++) {
+         a[i] = new Node("A" + std::to_string(i + 1));
+         b[i] = new Node("B" + std::to_string(i + 1));
+         a[i]->translate(glm::vec3(0.0f, 1.0f, 0.0f));
+         b[i]->rotate(30.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+         b[i]->translate(glm::vec3(0.0f, 0.0f, 2.0f));
+         (i == 0 ? hRoot : a[i - 1])->addChild(a[i]);
+         (i == 0 ? hRoot : b[i - 1])->addChild(b[i]);
+      }
+
+      TransformHierarchy hierarchy;
+      hierarchy.build(hRoot);
+      assert(hierarchy.getNumNodes() == 7);
+      assert(hierarchy.getRoot() == hRoot);
+
+      glm::mat4 expectedB3 = hRoot->getM() * b[0]->getM() * b[1]->getM() * b[2]->getM();
+      assert(areMatricesEqual(b[2]->getWorldFinalMatrix(), expectedB3));
+      assert(hierarchy.getLastUpdateCount() == 7);
+      assert(areVec3Equal(glm::vec3(a[2]->getWorldFinalMatrix()[3]), glm::vec3(1.0f, 3.0f, 0.0f)));
+      assert(hierarchy.getLastUpdateCount() == 0);
+
+      // Una modifica tramite il nodo ricalcola solo la voce e i suoi discendenti
+      a[0]->translate(glm::vec3(0.0f, 0.0f, 4.0f));
+      assert(areVec3Equal(glm::vec3(a[2]->getWorldFinalMatrix()[3]), glm::vec3(1.0f, 3.0f, 4.0f)));
+      assert(hierarchy.getLastUpdateCount() == 3);
+
+      // Il genitore esterno alla gerarchia sposta tutto il sottoalbero
+      outer->translate(glm::vec3(0.0f, -10.0f, 0.0f));
+      assert(areVec3Equal(glm::vec3(a[2]->getWorldFinalMatrix()[3]), glm::vec3(1.0f, -7.0f, 4.0f)));
+      assert(hierarchy.getLastUpdateCount() == 7);
+      assert(areMatricesEqual(b[2]->getWorldFinalMatrix(), outer->getM() * expectedB3));
+
+      // Un figlio aggiunto a un nodo collegato entra nella gerarchia alla ricostruzione
+      Node* added = new Node("Aggiunto");
+      added->translate(glm::vec3(0.0f, 0.5f, 0.0f));
+      a[2]->addChild(added);
+      assert(areVec3Equal(glm::vec3(added->getWorldFinalMatrix()[3]), glm::vec3(1.0f, -6.5f, 4.0f)));
+      assert(hierarchy.getNumNodes() == 8);
+      a[1]->translate(glm::vec3(1.0f, 0.0f, 0.0f));
+      assert(areVec3Equal(glm::vec3(added->getWorldFinalMatrix()[3]), glm::vec3(2.0f, -6.5f, 4.0f)));
+
+      // Un sottoalbero rimosso torna a calcolare da solo le proprie matrici
+      b[0]->removeChild(b[1]);
+      assert(areMatricesEqual(b[2]->getWorldFinalMatrix(), b[1]->getM() * b[2]->getM()));
+      assert(hierarchy.getNumNodes() == 6);
+      b[1]->translate(glm::vec3(3.0f, 0.0f, 0.0f));
+      assert(areMatricesEqual(b[2]->getWorldFinalMatrix(), b[1]->getM() * b[2]->getM()));
+
+      // Distruzione di nodi collegati (gia' staccati dal genitore): prima una foglia, poi la radice
+      a[2]->removeChild(added);
+      delete added;
+      assert(areVec3Equal(glm::vec3(a[2]->getWorldFinalMatrix()[3]), glm::vec3(2.0f, -7.0f, 4.0f)));
+      assert(hierarchy.getNumNodes() == 5);
+      outer->removeChild(hRoot);
+      hRoot->removeChild(a[0]);
+      hRoot->removeChild(b[0]);
+      delete hRoot;
+      assert(hierarchy.getNumNodes() == 0 && hierarchy.getRoot() == nullptr);
+      assert(areMatricesEqual(a[0]->getWorldFinalMatrix(), a[0]->getM()));
+
+      // Albero ampio: tutte le voci vengono aggiornate da una modifica alla radice
+      Node* wideRoot = new Node("RadiceAmpia");
+      std::vector<Node*> wide;
+      for (int i = 0; i < 1000; i++) {
+         Node* group = new Node("Gruppo");
+         group->translate(glm::vec3((float)i, 0.0f, 0.0f));
+         wideRoot->addChild(group);
+         wide.push_back(group);
+         for (int j = 0; j < 9; j++) {
+            Node* item = new Node("Elemento");
+            item->translate(glm::vec3(0.0f, (float)j, 0.0f));
+            group->addChild(item);
+            wide.push_back(item);
+         }
+      }
+      hierarchy.build(wideRoot);
+      assert(hierarchy.getNumNodes() == 10001);
+      wideRoot->translate(glm::vec3(0.0f, 0.0f, 1.0f));
+      assert(areVec3Equal(glm::vec3(wide.back()->getWorldFinalMatrix()[3]), glm::vec3(999.0f, 8.0f, 1.0f)));
+      assert(hierarchy.getLastUpdateCount() == 10001);
+
+      // Lista costruita dagli array della gerarchia: stesse istanze e stesso ordine della visita
+      struct HierarchyProbe : public List {
+         const std::vector<Instance>& getOpaque() const { return instances.opaque; }
+      };
+      HierarchyProbe visited, flat, flatParallel;
+      visited.pass(wideRoot, glm::mat4(1.0f));
+      wide[5]->translate(glm::vec3(0.0f, 0.0f, -3.0f)); // applicata da update() dentro pass()
+      flat.pass(hierarchy);
+      assert(hierarchy.getLastUpdateCount() == 1);
+      flatParallel.passParallel(hierarchy, 4);
+      assert(flat.getOpaque().size() == 10001 && flatParallel.getOpaque().size() == 10001);
+      for (size_t i = 0; i < flat.getOpaque().size(); i++) {
+         const Node* node = visited.getOpaque()[i].node;
+         assert(flat.getOpaque()[i].node == node && flatParallel.getOpaque()[i].node == node);
+         assert(areMatricesEqual(flat.getOpaque()[i].nodeWorldMatrix, node->getWorldFinalMatrix()));
+         assert(flatParallel.getOpaque()[i].nodeWorldMatrix == flat.getOpaque()[i].nodeWorldMatrix);
+      }
+      assert(areVec3Equal(glm::vec3(flat.getOpaque()[6].nodeWorldMatrix[3]), glm::vec3(0.0f, 4.0f, -2.0f)));
+
+      for (Node* n : wide) delete n;
+      delete wideRoot;
+      for (int i = 0; i < 3; i++) { delete a[i]; delete b[i]; }
+      delete outer;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 15. TESTING INDICE DEI NOMI
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Name Index... ";
+
+   {
+      assert(NameIndex::matches("Disco*", "Disco7"));
+      assert(NameIndex::matches("Disco*", "Disco"));
+      assert(!NameIndex::matches("Disco*", "Palo1"));
+      assert(NameIndex::matches("Omni00?", "Omni003"));
+      assert(!NameIndex::matches("Omni00?", "Omni0031"));
+      assert(NameIndex::matches("*.Target", "Spot001.Target"));
+      assert(NameIndex::matches("*", ""));
+
+      // Scena: Tavolo -> { Palo1 -> { Disco2, Disco1 }, Palo2 -> { Copia }, Copia }
+      Node* table = new Node("Tavolo");
+      Node* peg1 = new Node("Palo1");
+      Node* peg2 = new Node("Palo2");
+      Node* disc1 = new Node("Disco1");
+      Node* disc2 = new Node("Disco2");
+      Node* dup1 = new Node("Copia");
+      Node* dup2 = new Node("Copia");
+      table->addChild(peg1);
+      table->addChild(peg2);
+      table->addChild(dup1);
+      peg1->addChild(disc2);
+      peg1->addChild(disc1);
+      peg2->addChild(dup2);
+
+      // Senza indice: ricerca ricorsiva
+      assert(table->getNameIndex() == nullptr);
+      assert(table->findByName("Disco1") == disc1);
+      std::vector<Node*> plain = table->findMatching("Disco*");
+
+      table->buildNameIndex();
+      NameIndex* index = table->getNameIndex();
+      assert(index != nullptr && disc1->getNameIndex() == index);
+      assert(index->getNumNodes() == 7);
+
+      // Stessi risultati della versione ricorsiva, ordinati per nome
+      assert(table->findByName("Disco1") == disc1);
+      assert(table->findByName("Inesistente") == nullptr);
+      std::vector<Node*> indexed = table->findMatching("Disco*");
+      assert(indexed == plain);
+      assert(indexed.size() == 2 && indexed[0] == disc1 && indexed[1] == disc2);
+
+      // Omonimi: tutti restituiti, ma solo quelli nel sottoalbero interrogato
+      assert(table->findAllByName("Copia").size() == 2);
+      assert(table->findByName("Copia") == dup2); // primo in pre-ordine, come la ricerca ricorsiva
+      std::vector<Node*> underPeg2 = peg2->findAllByName("Copia");
+      assert(underPeg2.size() == 1 && underPeg2[0] == dup2);
+      assert(peg2->findByName("Palo1") == nullptr);
+      assert(peg1->findMatching("*").size() == 3);
+
+      // addChild/removeChild tengono l'indice allineato
+      Node* disc3 = new Node("Disco3");
+      disc3->addChild(new Node("Disco3.Target"));
+      peg2->addChild(disc3);
+      assert(index->getNumNodes() == 9);
+      assert(table->findByName("Disco3.Target") != nullptr);
+      assert(table->findMatching("Disco?").size() == 3);
+
+      peg2->removeChild(disc3);
+      assert(disc3->getNameIndex() == nullptr);
+      assert(table->findByName("Disco3") == nullptr);
+      assert(index->getNumNodes() == 7);
+      assert(disc3->findByName("Disco3.Target") != nullptr); // ricerca ricorsiva sul ramo staccato
+      delete disc3->getChild(0);
+      delete disc3;
+
+      // Un nodo distrutto esce dall'indice
+      peg1->removeChild(disc2);
+      delete disc2;
+      assert(table->findMatching("Disco*").size() == 1);
+      table->removeChild(dup1);
+      delete dup1;
+      assert(table->findAllByName("Copia").size() == 1);
+      assert(index->getNumNodes() == 5);
+
+      // Distrutta la radice, i nodi rimasti tornano alla ricerca ricorsiva
+      table->removeChild(peg1);
+      table->removeChild(peg2);
+      delete table;
+      assert(peg1->getNameIndex() == nullptr && disc1->getNameIndex() == nullptr);
+      assert(peg1->findByName("Disco1") == disc1);
+
+      delete disc1;
+      delete dup2;
+      delete peg1;
+      delete peg2;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 16. TESTING TABELLA DEI NOMI INTERNATI
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Name Table... ";
+
+   {
+      // Stesso testo -> stesso identificativo, anche da oggetti diversi
+      NameTable::Id id = NameTable::intern("NomeInternato");
+      assert(NameTable::intern(std::string("NomeInternato")) == id);
+      assert(NameTable::view(id) == "NomeInternato");
+      assert(NameTable::find("NomeInternato") == id);
+      assert(NameTable::find("NomeMaiUsato_xyz") == NameTable::INVALID);
+
+      Node* first = new Node("NomeInternato");
+      Mesh* second = new Mesh("NomeInternato");
+      assert(first->getNameId() == id && second->getNameId() == id);
+      assert(first->getName() == "NomeInternato");
+      assert(first->getName().data() == second->getName().data()); // una sola copia del testo
+
+      // Le viste restano valide mentre la tabella cresce su piu' blocchi
+      std::string_view before = first->getName();
+      unsigned int namesBefore = NameTable::getNumNames();
+      std::vector<NameTable::Id> ids;
+      for (int i = 0; i < 3000; i++) ids.push_back(NameTable::intern("Generato_" + std::to_string(i)));
+      assert(NameTable::getNumNames() == namesBefore + 3000);
+      assert(before.data() == first->getName().data() && before == "NomeInternato");
+      for (int i = 0; i < 3000; i += 250) assert(NameTable::view(ids[i]) == "Generato_" + std::to_string(i));
+
+      // Nome vuoto valido e distinto dagli altri
+      Node* unnamed = new Node("");
+      assert(unnamed->getName().empty() && unnamed->getNameId() != id);
+
+      delete unnamed;
+      delete second;
+      delete first;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 17. TESTING ARENA E SCENE
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Arena & Scene... ";
+
+   {
+      // Allocazioni contigue, allineate, e richieste piu' grandi di un blocco
+      Arena arena(1024);
+      int* i1 = arena.create<int>(1);
+      int* i2 = arena.create<int>(2);
+      assert(*i1 == 1 && *i2 == 2 && i2 > i1);
+      struct alignas(64) Aligned { float v[4]; };
+      Aligned* aligned = arena.create<Aligned>();
+      assert(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+      void* big = arena.allocate(4096, 16);
+      assert(arena.owns(big) && arena.owns(i1) && !arena.owns(&arena));
+      int* after = arena.create<int>(3);
+      assert(arena.getNumBlocks() == 2 && after > i2); // il blocco corrente resta in uso dopo quello dedicato
+      assert(arena.getNumObjects() == 0); // nessun distruttore da chiamare
+
+      // Distruttori in ordine inverso di creazione al rilascio
+      static std::vector<int> destroyed;
+      struct Tracker {
+         int id;
+         explicit Tracker(int id) : id(id) {}
+         ~Tracker() { destroyed.push_back(id); }
+      };
+      for (int i = 0; i < 3; i++) arena.create<Tracker>(i);
+      assert(arena.getNumObjects() == 3);
+
+      // Contenitori std::pmr nell'arena
+      std::pmr::vector<glm::vec3>* points = arena.create<std::pmr::vector<glm::vec3>>(&arena);
+      points->assign(100, glm::vec3(1.0f));
+      assert(arena.owns(points->data()));
+
+      arena.release();
+      assert(destroyed == std::vector<int>({ 2, 1, 0 }));
+      assert(arena.getNumBlocks() == 0 && arena.getBytesUsed() == 0);
+
+      // Scena: tutti gli oggetti nell'arena, la camera esterna viene solo staccata
+      Scene* scene = new Scene();
+      Node* sceneRoot = scene->create<Node>("RadiceScena");
+      Material* sceneMat = scene->create<Material>("MatScena", glm::vec3(0.0f), glm::vec3(0.1f), glm::vec3(1.0f), glm::vec3(0.5f), 32.0f, 1.0f);
+      Mesh* sceneMesh = scene->create<Mesh>("MeshScena", glm::mat4(1.0f), 1, 3, sceneMat, &scene->getArena());
+      sceneMesh->set_all_vertices({ glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0) });
+      sceneMesh->set_face_vertices({ { 0, 1, 2 } });
+      assert(scene->owns(sceneMesh->get_all_vertices().data()));
+      assert(scene->owns(sceneMesh->get_face_vertices()[0].data()));
+      sceneRoot->addChild(sceneMesh);
+      sceneRoot->addChild(scene->create<OmnidirectionalLight>("LuceScena", glm::mat4(1.0f), glm::vec3(0.1f), glm::vec3(1.0f), glm::vec3(1.0f)));
+      scene->setRoot(sceneRoot);
+      sceneRoot->buildNameIndex();
+
+      Node* externalCam = new Node("CameraEsterna");
+      sceneRoot->addChild(externalCam);
+      assert(sceneRoot->findByName("LuceScena") != nullptr);
+      assert(scene->owns(sceneMesh) && !scene->owns(externalCam));
+
+      delete scene;
+      assert(externalCam->getParent() == nullptr);
+      assert(externalCam->getNameIndex() == nullptr);
+      assert(externalCam->findByName("MeshScena") == nullptr);
+      delete externalCam;
+
+      // Un file mancante non lascia scene a meta'
+      OvoReader reader;
+      assert(reader.loadScene("file_inesistente.ovo", "texture/") == nullptr);
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 18. TESTING HANDLE CON GENERAZIONE
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Handles... ";
+
+   {
+      Handle<Node> empty;
+      assert(!empty && empty.get() == nullptr);
+      assert(Handle<Node>(nullptr).get() == nullptr);
+
+      unsigned int objectsBefore = ObjectRegistry::getNumObjects();
+      Node* target = new Node("Bersaglio");
+      Handle<Node> h(target);
+      assert(h && h.get() == target && h->getName() == "Bersaglio");
+      assert(ObjectRegistry::getNumObjects() == objectsBefore + 1);
+      const std::vector<Object*>& live = ObjectRegistry::getObjects();
+      assert(std::find(live.begin(), live.end(), target) != live.end());
+
+      // Handle verso la classe base di un oggetto derivato
+      Mesh* meshTarget = new Mesh("MeshBersaglio");
+      Handle<Node> hBase(meshTarget);
+      Handle<Mesh> hMesh(meshTarget);
+      assert(hBase.get() == meshTarget && hMesh.get() == meshTarget);
+
+      // Distruzione: l'handle se ne accorge anche se lo slot viene riutilizzato
+      uint32_t slot = h.getIndex();
+      delete target;
+      assert(!h && h.get() == nullptr);
+      Node* reuse = new Node("Riuso");
+      Handle<Node> hReuse(reuse);
+      assert(hReuse.getIndex() == slot && hReuse.getGeneration() != h.getGeneration());
+      assert(h.get() == nullptr && hReuse.get() == reuse);
+      assert(ObjectRegistry::getNumObjects() == objectsBefore + 2);
+
+      // La copia di un oggetto ha uno slot proprio
+      Material copySource("Originale", glm::vec3(0.0f), glm::vec3(0.1f), glm::vec3(1.0f), glm::vec3(0.5f), 8.0f, 1.0f);
+      Material copy(copySource);
+      assert(copy.getHandleIndex() != copySource.getHandleIndex());
+      assert(Handle<Material>(&copy).get() == &copy && Handle<Material>(&copySource).get() == &copySource);
+
+      // Gli oggetti di una scena distrutta invalidano i propri handle
+      Scene* handleScene = new Scene();
+      Node* inScene = handleScene->create<Node>("NellaScena");
+      handleScene->setRoot(inScene);
+      Handle<Node> hScene(inScene);
+      assert(hScene.get() == inScene);
+      delete handleScene;
+      assert(!hScene);
+
+      delete reuse;
+      delete meshTarget;
+      assert(!hBase && !hMesh && !hReuse);
+      assert(ObjectRegistry::getNumObjects() == objectsBefore + 2); // restano le due Material sullo stack
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 19. TESTING BVH (confronto con la ricerca esaustiva)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] BVH... ";
+
+   {
+      Bvh emptyBvh;
+      Bvh::RayHit noHit;
+      assert(!emptyBvh.raycast(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), noHit));
+      assert(emptyBvh.getBounds().isEmpty() && emptyBvh.validate());
+
+      // Griglia 8x8x8 di cubi unitari, sparsi con passo 3 e figli di un nodo traslato
+      Node* bvhRoot = new Node("BvhRoot");
+      bvhRoot->setM(glm::translate(glm::mat4(1.0f), glm::vec3(100.0f, 0.0f, 0.0f)));
+      std::vector<Mesh*> cubes;
+      for (int x = 0; x < 8; x++) for (int y = 0; y < 8; y++) for (int z = 0; z < 8; z++) {
+         Mesh* cube = new Mesh("Cubo", glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z) * 3.0f), 0, 0, mat);
+         cube->set_all_vertices({ glm::vec3(-0.5f), glm::vec3(0.5f) });
+         bvhRoot->addChild(cube);
+         cubes.push_back(cube);
+      }
+      bvhRoot->addChild(new Node("SenzaGeometria"));
+
+      Bvh bvh(0.25f);
+      bvh.build(bvhRoot);
+      assert(bvh.getNumLeaves() == 512 && bvh.validate());
+      assert(bvh.getHeight() <= 18); // ~2 log2(512)
+      assert(glm::all(glm::lessThan(glm::abs(bvh.getBounds().getMin() - glm::vec3(99.5f, -0.5f, -0.5f)), glm::vec3(0.001f))));
+
+      auto sorted = [](std::vector<Mesh*> v) { std::sort(v.begin(), v.end()); return v; };
+
+      // Sovrapposizione con una scatola
+      BoundingBox region(glm::vec3(103.0f, 2.0f, 2.0f), glm::vec3(110.0f, 7.0f, 4.0f));
+      std::vector<Mesh*> found, expected;
+      bvh.query(region, found);
+      for (Mesh* cube : cubes) {
+         if (cube->getBoundingBox().transformed(cube->getWorldFinalMatrix()).overlaps(region)) expected.push_back(cube);
+      }
+      assert(!expected.empty() && sorted(found) == sorted(expected));
+
+      // Frustum: camera in (112, 12, 40) che guarda verso -Z
+      glm::mat4 viewProj = glm::perspective(glm::radians(30.0f), 1.0f, 1.0f, 100.0f) *
+                           glm::lookAt(glm::vec3(112.0f, 12.0f, 40.0f), glm::vec3(112.0f, 12.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+      Frustum frustum(viewProj);
+      found.clear(); expected.clear();
+      bvh.query(frustum, found);
+      for (Mesh* cube : cubes) {
+         if (frustum.intersects(cube->getBoundingBox().transformed(cube->getWorldFinalMatrix()))) expected.push_back(cube);
+      }
+      assert(!expected.empty() && expected.size() < cubes.size() && sorted(found) == sorted(expected));
+
+      // Raggio lungo -Z: colpisce la faccia del cubo piu' vicino della colonna (x=2, y=1)
+      Bvh::RayHit hit;
+      assert(bvh.raycast(glm::vec3(106.0f, 3.0f, 50.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit));
+      assert(hit.mesh == cubes[2 * 64 + 1 * 8 + 7]);
+      assert(std::abs(hit.distance - (50.0f - 21.5f)) < 0.001f);
+      assert(!bvh.raycast(glm::vec3(106.0f, 3.0f, 50.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit, 20.0f));
+      // Raggio tra le colonne: nessun colpo
+      assert(!bvh.raycast(glm::vec3(101.5f, 1.5f, 50.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit));
+      // Raggio obliquo confrontato con tutte le scatole
+      glm::vec3 origin(95.0f, 30.0f, 30.0f);
+      glm::vec3 direction = glm::normalize(glm::vec3(112.0f, 10.0f, 10.0f) - origin);
+      float nearest = std::numeric_limits<float>::max();
+      Mesh* nearestMesh = nullptr;
+      for (Mesh* cube : cubes) {
+         float d;
+         if (cube->getBoundingBox().transformed(cube->getWorldFinalMatrix()).intersectsRay(origin, BoundingBox::inverseDirection(direction), nearest, d) && d < nearest) {
+            nearest = d;
+            nearestMesh = cube;
+         }
+      }
+      assert(nearestMesh && bvh.raycast(origin, direction, hit) && hit.mesh == nearestMesh);
+
+      // Spostamento piccolo: resta nella scatola grassa, nessun reinserimento
+      Mesh* mover = cubes[0];
+      mover->setM(glm::translate(glm::mat4(1.0f), glm::vec3(0.1f, 0.0f, 0.0f)));
+      assert(bvh.refit() == 0);
+      assert(bvh.raycast(glm::vec3(99.65f, 0.0f, -10.0f), glm::vec3(0.0f, 0.0f, 1.0f), hit) && hit.mesh == mover);
+      // Spostamento grande: un solo reinserimento, poi il raggio lo trova nella nuova posizione
+      mover->setM(glm::translate(glm::mat4(1.0f), glm::vec3(60.0f, 0.0f, 0.0f)));
+      assert(bvh.refit() == 1 && bvh.validate());
+      assert(bvh.raycast(glm::vec3(160.0f, 0.0f, 50.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit) && hit.mesh == mover);
+      found.clear();
+      bvh.query(BoundingBox(glm::vec3(99.0f, -1.0f, -1.0f), glm::vec3(100.0f, 0.0f, 0.0f)), found);
+      assert(found.empty());
+
+      // Mesh distrutte: ignorate subito, rimosse al refit
+      Mesh* doomed = cubes[2 * 64 + 1 * 8 + 7];
+      bvhRoot->removeChild(doomed);
+      delete doomed;
+      assert(bvh.raycast(glm::vec3(106.0f, 3.0f, 50.0f), glm::vec3(0.0f, 0.0f, -1.0f), hit));
+      assert(hit.mesh == cubes[2 * 64 + 1 * 8 + 6]);
+      assert(bvh.refit() == 1 && bvh.getNumLeaves() == 511 && bvh.validate());
+
+      // Inserimento e rimozione esplicita
+      Mesh extra("Extra", glm::translate(glm::mat4(1.0f), glm::vec3(-50.0f, 0.0f, 0.0f)), 0, 0, mat);
+      extra.set_all_vertices({ glm::vec3(-1.0f), glm::vec3(1.0f) });
+      int extraLeaf = bvh.insert(&extra);
+      assert(extraLeaf != Bvh::NULL_NODE && bvh.getNumLeaves() == 512 && bvh.validate());
+      assert(bvh.getBounds().getMin().x == -51.0f);
+      bvh.remove(extraLeaf);
+      assert(bvh.getNumLeaves() == 511 && bvh.validate());
+      Mesh noGeometry("Vuota");
+      assert(bvh.insert(&noGeometry) == Bvh::NULL_NODE);
+
+      for (Mesh* cube : cubes) {
+         if (cube != doomed) delete cube;
+      }
+      delete bvhRoot->getChild(bvhRoot->getNumChildren() - 1);
+      delete bvhRoot;
+      assert(bvh.refit() == 511 && bvh.getNumLeaves() == 0 && bvh.validate());
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 20. TESTING PICKING (raggio dalla camera, scatole e poi triangoli)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Picking... ";
+
+   {
+      // Superficie ondulata 60x60 (7200 triangoli) nel piano XZ
+      const int gridSize = 60;
+      std::vector<glm::vec3> gridVertices;
+      std::vector<std::vector<unsigned int>> gridFaces;
+      for (int z = 0; z <= gridSize; z++) for (int x = 0; x <= gridSize; x++) {
+         gridVertices.push_back(glm::vec3(x - gridSize * 0.5f, std::sin(x * 0.3f) * std::cos(z * 0.2f) * 2.0f, z - gridSize * 0.5f));
+      }
+      for (int z = 0; z < gridSize; z++) for (int x = 0; x < gridSize; x++) {
+         unsigned int i = z * (gridSize + 1) + x;
+         gridFaces.push_back({ i, i + 1, i + gridSize + 1 });
+         gridFaces.push_back({ i + 1, i + gridSize + 2, i + gridSize + 1 });
+      }
+      Mesh* terrain = new Mesh("Terreno", glm::mat4(1.0f), 0, 0, mat);
+      terrain->set_all_vertices(gridVertices);
+      terrain->set_face_vertices(gridFaces);
+
+      const TriangleBvh& triangles = terrain->getTriangleBvh();
+      assert(triangles.getNumTriangles() == 2 * gridSize * gridSize);
+      assert(triangles.getNumNodes() < 2 * triangles.getNumTriangles());
+      assert(triangles.getDepth() > 1 && triangles.getDepth() <= 64);
+
+      // Confronto con il test esaustivo su tutti i triangoli
+      auto bruteForce = [&](const glm::vec3& o, const glm::vec3& d, float& best, unsigned int& bestFace) {
+         best = std::numeric_limits<float>::max();
+         for (unsigned int f = 0; f < gridFaces.size(); f++) {
+            glm::vec3 a = gridVertices[gridFaces[f][0]];
+            glm::vec3 e1 = gridVertices[gridFaces[f][1]] - a;
+            glm::vec3 e2 = gridVertices[gridFaces[f][2]] - a;
+            glm::vec3 p = glm::cross(d, e2);
+            float det = glm::dot(e1, p);
+            if (std::abs(det) < 1e-12f) continue;
+            glm::vec3 sv = o - a;
+            float u = glm::dot(sv, p) / det;
+            glm::vec3 q = glm::cross(sv, e1);
+            float v = glm::dot(d, q) / det;
+            float t = glm::dot(e2, q) / det;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best) {
+               best = t;
+               bestFace = f;
+            }
+         }
+         return best < std::numeric_limits<float>::max();
+      };
+      int hits = 0;
+      for (int i = 0; i < 200; i++) {
+         glm::vec3 o(std::sin(i * 1.7f) * 40.0f, 10.0f + (i % 7), std::cos(i * 1.3f) * 40.0f);
+         glm::vec3 target(std::sin(i * 0.9f) * 25.0f, 0.0f, std::cos(i * 2.1f) * 25.0f);
+         glm::vec3 d = glm::normalize(target - o);
+         float expectedDistance, distance;
+         unsigned int expectedFace = 0, face = 0;
+         bool expected = bruteForce(o, d, expectedDistance, expectedFace);
+         bool found = triangles.raycast(o, d, std::numeric_limits<float>::max(), distance, face);
+         assert(found == expected);
+         if (found) {
+            hits++;
+            assert(std::abs(distance - expectedDistance) < 0.001f);
+         }
+      }
+      assert(hits > 150);
+
+      // Modificare la geometria ricostruisce la gerarchia alla richiesta successiva
+      terrain->set_face_vertices({ { 0, 1, (unsigned int)gridSize + 1 } });
+      assert(terrain->getTriangleBvh().getNumTriangles() == 1);
+      terrain->set_face_vertices(gridFaces);
+
+      // Raggio della camera: il centro della finestra guarda lungo l'asse della camera
+      PerspectiveCamera* pickCam = new PerspectiveCamera("PickCam", 60.0f, 1.0f, 1.0f, 500.0f);
+      pickCam->setM(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 40.0f, 0.0f)) *
+                    glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+      glm::vec3 origin, direction;
+      pickCam->getRay(399.5f, 299.5f, 800.0f, 600.0f, origin, direction);
+      assert(areVec3Equal(direction, glm::vec3(0.0f, -1.0f, 0.0f)));
+      assert(std::abs(origin.y - 39.0f) < 0.001f);
+      // Angolo in alto a sinistra: verso -X e -Z (l'alto della camera e' -Z nel mondo)
+      pickCam->getRay(0.0f, 0.0f, 800.0f, 600.0f, origin, direction);
+      assert(direction.x < 0.0f && direction.z < 0.0f && direction.y < 0.0f);
+
+      // Scena: terreno traslato e ruotato + un pannello sopra di esso
+      Node* pickRoot = new Node("PickRoot");
+      terrain->setM(glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f)) *
+                    glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+      pickRoot->addChild(terrain);
+      // Triangolo sottile lungo z = x + 2: la sua scatola copre il centro, il triangolo no
+      Mesh* sliver = new Mesh("Scheggia", glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 20.0f, 0.0f)), 0, 0, mat);
+      sliver->set_all_vertices({ glm::vec3(-5.0f, 0.0f, -3.0f), glm::vec3(3.0f, 0.0f, 5.0f), glm::vec3(3.0f, 0.0f, 4.5f) });
+      sliver->set_face_vertices({ { 0, 1, 2 } });
+      pickRoot->addChild(sliver);
+
+      Bvh pickBvh;
+      pickBvh.build(pickRoot);
+      pickCam->getRay(399.5f, 299.5f, 800.0f, 600.0f, origin, direction);
+
+      // Le scatole trovano la scheggia, i triangoli passano al terreno
+      Bvh::RayHit boxHit;
+      assert(pickBvh.raycast(origin, direction, boxHit) && boxHit.mesh == sliver);
+      Bvh::PickHit pickHit;
+      assert(pickBvh.pick(origin, direction, pickHit) && pickHit.mesh == terrain);
+      glm::vec3 localPoint = glm::vec3(glm::inverse(terrain->getWorldFinalMatrix()) * glm::vec4(pickHit.point, 1.0f));
+      float expectedDistance;
+      unsigned int expectedFace = 0;
+      glm::vec3 localOrigin = glm::vec3(glm::inverse(terrain->getWorldFinalMatrix()) * glm::vec4(origin, 1.0f));
+      glm::vec3 localDirection = glm::vec3(glm::inverse(terrain->getWorldFinalMatrix()) * glm::vec4(direction, 0.0f));
+      assert(bruteForce(localOrigin, localDirection, expectedDistance, expectedFace));
+      assert(std::abs(pickHit.distance - expectedDistance) < 0.001f && pickHit.face == expectedFace);
+      assert(std::abs(pickHit.point.x) < 0.001f && std::abs(pickHit.point.z) < 0.001f);
+      assert(std::abs(localPoint.y - pickHit.point.y) < 0.001f && std::abs(localPoint.y) <= 2.0f);
+
+      // Un raggio che attraversa la scheggia la colpisce
+      glm::vec3 onSliver(1.0f / 3.0f, 20.0f, 6.5f / 3.0f); // baricentro
+      glm::vec3 down(0.0f, -1.0f, 0.0f);
+      assert(pickBvh.pick(onSliver - down * 10.0f, down, pickHit) && pickHit.mesh == sliver);
+      assert(areVec3Equal(pickHit.point, onSliver) && std::abs(pickHit.distance - 10.0f) < 0.001f);
+      // Limite di distanza e raggio verso il cielo
+      assert(!pickBvh.pick(onSliver - down * 10.0f, down, pickHit, 5.0f));
+      assert(!pickBvh.pick(glm::vec3(0.0f, 30.0f, 0.0f), -down, pickHit));
+
+      // Picking dopo lo spostamento: la scheggia sopra il centro copre il terreno
+      sliver->setM(glm::translate(glm::mat4(1.0f), glm::vec3(-1.0f / 3.0f, 20.0f, -6.5f / 3.0f)));
+      pickBvh.refit();
+      assert(pickBvh.pick(origin, direction, pickHit) && pickHit.mesh == sliver);
+
+      delete sliver;
+      delete terrain;
+      delete pickRoot;
+      delete pickCam;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 21. TESTING PICKING SU GPU (codifica degli id e scelta del pixel)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Picking con buffer degli id... ";
+
+   {
+      // Codifica: ogni id torna uguale, lo sfondo (0, 0, 0) non e' un id
+      for (unsigned int id : { 0u, 1u, 255u, 256u, 65535u, 123456u, 0xFFFFFEu }) {
+         glm::u8vec4 color = IdPicker::encodeId(id);
+         assert(color.a == 255);
+         uint8_t rgba[4] = { color.r, color.g, color.b, color.a };
+         assert(IdPicker::decodeId(rgba) == id);
+      }
+      uint8_t background[4] = { 0, 0, 0, 0 };
+      assert(IdPicker::decodeId(background) == IdPicker::INVALID_ID);
+
+      // Oltre 2^24 - 1 gli id si ripetono, ma nessuno prende il colore dello sfondo
+      for (unsigned int id : { 0xFFFFFFu, 0x1000000u, 0x1000005u, 0xFFFFFFFEu }) {
+         glm::u8vec4 color = IdPicker::encodeId(id);
+         uint8_t rgba[4] = { color.r, color.g, color.b, color.a };
+         assert(IdPicker::decodeId(rgba) == id % 0xFFFFFFu);
+      }
+
+      // Regione tutta sfondo, poi un oggetto lontano dal centro, uno piu' vicino e infine il centro
+      const int size = IdPicker::REGION_SIZE;
+      std::vector<uint8_t> region(size * size * 4, 0);
+      auto paint = [&](int x, int y, unsigned int id) {
+         glm::u8vec4 color = IdPicker::encodeId(id);
+         uint8_t* pixel = &region[(y * size + x) * 4];
+         pixel[0] = color.r; pixel[1] = color.g; pixel[2] = color.b; pixel[3] = color.a;
+      };
+      assert(IdPicker::resolveRegion(region.data(), size) == IdPicker::INVALID_ID);
+      paint(0, 0, 7);
+      assert(IdPicker::resolveRegion(region.data(), size) == 7);
+      paint(size / 2 + 1, size / 2, 9);
+      assert(IdPicker::resolveRegion(region.data(), size) == 9);
+      paint(size / 2, size / 2, 42);
+      assert(IdPicker::resolveRegion(region.data(), size) == 42);
+
+      // La passata degli id registra ogni mesh disegnata con il suo id
+      Mesh* first = new Mesh("IdA");
+      Mesh* second = new Mesh("IdB");
+      List idList;
+      idList.pass(first, glm::mat4(1.0f));
+      idList.pass(second, glm::mat4(1.0f));
+      std::unordered_map<unsigned int, Handle<Node>> drawn;
+      idList.renderIds(glm::mat4(1.0f), drawn);
+      assert(drawn.size() == 2);
+      assert(drawn.at(first->getId()).get() == first && drawn.at(second->getId()).get() == second);
+      unsigned int secondId = second->getId();
+      delete second;
+      assert(drawn.at(secondId).get() == nullptr); // nodo distrutto: la maniglia non risolve
+      idList.clear();
+
+      // Senza init() (nessun contesto) il picking su GPU non e' disponibile e non resta in attesa
+      IdPicker picker;
+      assert(!picker.isSupported());
+      assert(!picker.request(10, 10, [](Node*) { assert(false); }));
+      assert(!picker.isPending());
+      picker.process(idList, glm::mat4(1.0f), glm::mat4(1.0f), 800, 600);
+      assert(!picker.deliver());
+      picker.free();
+
+      delete first;
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 22. TESTING CADENZA DEI FRAME
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Frame pacing... ";
+
+   {
+      using Clock = FramePacer::Clock;
+      using std::chrono::milliseconds;
+      FramePacer pacer;
+      Clock::time_point next;
+      const Clock::time_point start = Clock::now();
+
+      // Continua: sempre un altro frame, subito
+      assert(pacer.getMode() == FramePacer::Mode::CONTINUOUS);
+      assert(pacer.frameDone(start, next) && next == start);
+
+      // Su richiesta: fermo finche' non arriva una richiesta, poi un solo frame
+      pacer.setMode(FramePacer::Mode::ON_DEMAND);
+      assert(!pacer.frameDone(start, next));
+      pacer.requestRedraw();
+      assert(pacer.isRedrawRequested());
+      assert(pacer.frameDone(start, next) && next == start);
+      assert(!pacer.isRedrawRequested() && !pacer.frameDone(start, next));
+      // Con un'animazione in corso i frame continuano
+      pacer.setAnimating(true);
+      assert(pacer.frameDone(start, next) && pacer.frameDone(start, next));
+      pacer.setAnimating(false);
+      assert(!pacer.frameDone(start, next));
+
+      // FPS fissi: frame distanziati di un periodo, le richieste non aggiungono frame
+      pacer.setMode(FramePacer::Mode::FIXED_FPS, 50.0f);
+      Clock::time_point t = Clock::now();
+      assert(pacer.frameDone(t, next));
+      Clock::time_point first = next;
+      assert(first > t && first - t <= milliseconds(20));
+      pacer.requestRedraw();
+      auto isPeriod = [](Clock::duration d) { return std::abs(std::chrono::duration<double>(d).count() - 0.02) < 1e-6; };
+      assert(pacer.frameDone(first, next) && isPeriod(next - first));
+      // Un frame molto in ritardo non provoca una raffica: la cadenza riparte da quell'istante
+      Clock::time_point late = next + milliseconds(500);
+      assert(pacer.frameDone(late, next) && next == late);
+      assert(pacer.frameDone(late, next) && isPeriod(next - late));
+      // Il limite minimo e' 1 FPS
+      pacer.setMode(FramePacer::Mode::FIXED_FPS, 0.0f);
+      assert(pacer.getTargetFps() == 1.0f);
+
+      // Attesa precisa: non ritorna prima della scadenza
+      Clock::time_point deadline = Clock::now() + milliseconds(5);
+      FramePacer::waitUntil(deadline);
+      assert(Clock::now() >= deadline);
+      FramePacer::waitUntil(start); // scadenza passata: ritorna subito
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 23. TESTING OROLOGIO DELLA SIMULAZIONE A PASSO FISSO
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Simulazione a passo fisso... ";
+
+   {
+      // La stessa durata simulata a 30, 60 e 144 FPS: stessi passi, stesso stato finale
+      auto simulate = [](double fps, double seconds, double& position) {
+         SimulationClock clock(0.01);
+         double velocity = 2.0;
+         position = 0.0;
+         int frames = (int)std::round(seconds * fps);
+         for (int i = 0; i < frames; i++)
+            clock.advance(1.0 / fps, [&](double step) { position += velocity * step; });
+         return clock.getStepCount();
+      };
+      double at30, at60, at144;
+      unsigned long long steps30 = simulate(30.0, 2.0, at30);
+      unsigned long long steps60 = simulate(60.0, 2.0, at60);
+      unsigned long long steps144 = simulate(144.0, 2.0, at144);
+      assert(steps30 >= 199 && steps30 <= 200 && steps60 >= 199 && steps60 <= 200 && steps144 >= 199 && steps144 <= 200);
+      assert(std::abs(at30 - 4.0) <= 0.02 && std::abs(at60 - 4.0) <= 0.02 && std::abs(at144 - 4.0) <= 0.02);
+
+      // Alpha: frazione del passo non ancora simulata
+      SimulationClock clock(0.125, 5, 1.0); // valori esatti in virgola mobile
+      int calls = 0;
+      auto count = [&](double step) { assert(step == 0.125); calls++; };
+      assert(clock.advance(0.3125, count) == 2 && calls == 2);
+      assert(clock.getAlpha() == 0.5);
+      assert(clock.advance(0.0625, count) == 1 && clock.getAlpha() == 0.0);
+      assert(clock.getTime() == 0.375);
+
+      // Frame lunghissimo: limitato a maxFrameTime e a maxStepsPerFrame, il resto scartato
+      SimulationClock limited(0.01, 5, 0.25);
+      calls = 0;
+      assert(limited.advance(10.0, [&](double) { calls++; }) == 5 && calls == 5);
+      assert(limited.getAlpha() >= 0.0 && limited.getAlpha() < 1.0);
+      assert(std::abs(limited.getDroppedTime() + limited.getTime() + limited.getAlpha() * 0.01 - 10.0) < 1e-9);
+      // Tempo negativo ignorato, reset azzera tutto
+      assert(limited.advance(-1.0, nullptr) == 0);
+      limited.reset();
+      assert(limited.getStepCount() == 0 && limited.getAlpha() == 0.0 && limited.getDroppedTime() == 0.0);
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 24. TESTING CONTESTO FUORI SCHERMO (rendering reale, se EGL e' disponibile)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Contesto fuori schermo... ";
+
+   {
+      OffscreenContext offscreen;
+      if (!offscreen.create(64, 48)) {
+         std::cout << "(EGL non disponibile, saltato) ";
+      }
+      else {
+         assert(offscreen.isValid() && offscreen.getWidth() == 64 && offscreen.getHeight() == 48);
+         assert(!offscreen.getRenderer().empty());
+         StateCache::invalidate();
+
+         // Il framebuffer riceve il disegno: colore di pulizia letto indietro
+         std::vector<uint8_t> pixels;
+         glClearColor(0.2f, 0.4f, 0.6f, 1.0f);
+         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+         assert(offscreen.readPixels(pixels) && pixels.size() == 64 * 48 * 4);
+         auto near = [](uint8_t value, int expected) { return std::abs(value - expected) <= 1; };
+         assert(near(pixels[0], 51) && near(pixels[1], 102) && near(pixels[2], 153) && pixels[3] == 255);
+
+         // Picking su GPU reale: quadrato al centro, sfondo ai bordi
+         Mesh* square = new Mesh("Quadrato");
+         square->set_all_vertices({ glm::vec3(-1, -1, 0), glm::vec3(1, -1, 0), glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0) });
+         square->set_face_vertices({ { 0, 1, 2 }, { 0, 2, 3 } });
+         List offscreenList;
+         offscreenList.pass(square, glm::mat4(1.0f));
+         glm::mat4 projection = glm::ortho(-2.0f, 2.0f, -1.5f, 1.5f, -10.0f, 10.0f);
+
+         IdPicker gpuPicker;
+         assert(gpuPicker.init(OffscreenContext::getProcLoader()) && gpuPicker.isSupported());
+         auto pickAt = [&](int x, int y) {
+            Node* result = nullptr;
+            bool done = false;
+            assert(gpuPicker.request(x, y, [&](Node* node) { result = node; done = true; }));
+            for (int frame = 0; frame < 10 && !done; frame++) {
+               gpuPicker.process(offscreenList, projection, glm::mat4(1.0f), 64, 48);
+               gpuPicker.deliver();
+            }
+            assert(done && !gpuPicker.isPending());
+            return result;
+         };
+
+         // process() non chiama mai il callback: il risultato aspetta deliver()
+         {
+            bool called = false;
+            assert(gpuPicker.request(32, 24, [&](Node*) { called = true; }));
+            for (int frame = 0; frame < 10; frame++)
+               gpuPicker.process(offscreenList, projection, glm::mat4(1.0f), 64, 48);
+            assert(!called && gpuPicker.isPending());
+            assert(gpuPicker.deliver() && called && !gpuPicker.isPending());
+            assert(!gpuPicker.deliver());
+         }
+         assert(pickAt(32, 24) == square);
+         assert(pickAt(2, 2) == nullptr);
+         assert(pickAt(17, 24) == square); // bordo sinistro del quadrato (x = 16..47)
+
+         // La passata degli id non altera la destinazione: il colore di pulizia e' ancora quello
+         assert(offscreen.readPixels(pixels) && near(pixels[0], 51) && near(pixels[2], 153));
+
+         // Id oltre 2^24: la mesh si ritrova dall'id letto nel colore
+         struct BigIdMesh : public Mesh {
+            BigIdMesh() : Mesh("IdGrande") {}
+            unsigned int getId() const override { return 0x1000005u; }
+         };
+         BigIdMesh* bigId = new BigIdMesh();
+         bigId->set_all_vertices({ glm::vec3(-1, -1, 0), glm::vec3(1, -1, 0), glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0) });
+         bigId->set_face_vertices({ { 0, 1, 2 }, { 0, 2, 3 } });
+         offscreenList.clear();
+         offscreenList.pass(bigId, glm::mat4(1.0f));
+         assert(pickAt(32, 24) == bigId);
+         delete bigId;
+
+         gpuPicker.free();
+         offscreenList.clear();
+         delete square;
+         offscreen.destroy();
+         assert(!offscreen.isValid());
+         StateCache::invalidate();
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 25. TESTING PROFILER (sezioni annidate, thread concorrenti, Chrome trace)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Profiler... ";
+
+   {
+      std::vector<Profiler::Sample> samples;
+      Profiler::clear();
+
+      // Disattivato: nessun campione
+      Profiler::setEnabled(false);
+      { Profiler::Scope ignored("Ignorata"); }
+      Profiler::getSamples(samples);
+      assert(samples.empty());
+
+      // Sezioni annidate e ripetute nello stesso frame
+      Profiler::setEnabled(true);
+      uint32_t frame = Profiler::getFrame();
+      {
+         Profiler::Scope outer("Esterna");
+         for (int i = 0; i < 3; i++) { Profiler::Scope inner("Interna"); }
+      }
+      Profiler::endFrame();
+      assert(Profiler::getFrame() == frame + 1);
+      std::vector<Profiler::Entry> entries = Profiler::getLastFrameBreakdown();
+      assert(entries.size() == 2);
+      assert(std::string(entries[0].name) == "Interna" && entries[0].calls == 3);
+      assert(std::string(entries[1].name) == "Esterna" && entries[1].calls == 1);
+      assert(entries[1].cpuMs >= entries[0].cpuMs && entries[0].gpuMs < 0.0);
+      Profiler::getSamples(samples);
+      assert(samples.size() == 4 && samples[3].duration >= samples[0].duration);
+      assert(samples[3].start <= samples[0].start && samples[0].frame == frame && !samples[0].gpu);
+
+      // Il frame successivo ha un riepilogo proprio
+      { Profiler::Scope only("Sola"); }
+      Profiler::endFrame();
+      entries = Profiler::getLastFrameBreakdown();
+      assert(entries.size() == 1 && std::string(entries[0].name) == "Sola");
+
+      // Scrittori concorrenti senza lock: nessun campione perso o rovinato
+      Profiler::clear();
+      const int perThread = 2000;
+      std::vector<std::thread> writers;
+      for (int t = 0; t < 4; t++)
+         writers.emplace_back([]() { for (int i = 0; i < perThread; i++) { Profiler::Scope scope("Thread"); } });
+      for (auto& w : writers) w.join();
+      Profiler::getSamples(samples);
+      assert(samples.size() == 4 * perThread);
+      std::vector<uint32_t> threadIds;
+      for (const auto& sample : samples) {
+         assert(std::string(sample.name) == "Thread" && sample.thread > 0);
+         if (std::find(threadIds.begin(), threadIds.end(), sample.thread) == threadIds.end()) threadIds.push_back(sample.thread);
+      }
+      assert(threadIds.size() == 4);
+
+      // Buffer pieno: restano gli ultimi CAPACITY campioni
+      for (unsigned int i = 0; i < Profiler::CAPACITY + 10; i++) Profiler::record("Pieno", i, 1, 0, false);
+      Profiler::getSamples(samples);
+      assert(samples.size() == Profiler::CAPACITY && samples.front().start == 10);
+
+      // Riepilogo a buffer pieno: solo i campioni CPU del frame corrente, anche con GPU in ritardo in mezzo
+      frame = Profiler::getFrame();
+      assert(frame > 0);
+      Profiler::record("Corrente", 0, 2000000, frame, false);
+      Profiler::record("Ritardo", 0, 5000000, frame - 1, true);
+      Profiler::record("Corrente", 0, 1000000, frame, false);
+      Profiler::endFrame();
+      entries = Profiler::getLastFrameBreakdown();
+      assert(entries.size() == 1 && std::string(entries[0].name) == "Corrente");
+      assert(entries[0].calls == 2 && entries[0].cpuMs > 2.9 && entries[0].cpuMs < 3.1);
+
+      // Chrome trace: eventi completi con nome, durata e thread della GPU
+      Profiler::clear();
+      Profiler::record("Con \"virgolette\"", 1000, 2500, 7, false);
+      Profiler::record("Submission", 1500, 1000, 7, true);
+      const std::string tracePath = "engine_test_trace.json";
+      assert(Profiler::writeChromeTrace(tracePath));
+      std::ifstream traceFile(tracePath);
+      std::string trace((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+      traceFile.close();
+      std::remove(tracePath.c_str());
+      assert(trace.find("\"traceEvents\"") != std::string::npos);
+      assert(trace.find("\"name\":\"Con \\\"virgolette\\\"\"") != std::string::npos);
+      assert(trace.find("\"ts\":1.000,\"dur\":2.500") != std::string::npos);
+      assert(trace.find("\"cat\":\"gpu\"") != std::string::npos && trace.find("\"args\":{\"name\":\"GPU\"}") != std::string::npos);
+
+      // Timer query reali nel contesto fuori schermo, se disponibile
+      OffscreenContext offscreen;
+      if (offscreen.create(32, 32) && Profiler::initGpu(OffscreenContext::getProcLoader())) {
+         Profiler::clear();
+         {
+            Profiler::GpuScope gpuScope("Pulizia");
+            Profiler::GpuScope nested("Annidata"); // ignorata: i timer query non si annidano
+            glClear(GL_COLOR_BUFFER_BIT);
+         }
+         glFinish();
+         bool resolved = false;
+         for (int i = 0; i < 100 && !resolved; i++) {
+            Profiler::endFrame();
+            for (const auto& entry : Profiler::getLastFrameBreakdown())
+               if (std::string(entry.name) == "Pulizia" && entry.gpuMs >= 0.0) resolved = true;
+         }
+         assert(resolved);
+         Profiler::getSamples(samples);
+         assert(samples.size() == 1 && samples[0].gpu && samples[0].thread == 0);
+         Profiler::freeGpu();
+      }
+      offscreen.destroy();
+      StateCache::invalidate();
+
+      Profiler::setEnabled(false);
+      Profiler::clear();
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 26. TESTING STATISTICHE DEI TEMPI DI FRAME (istogramma, percentili, finestra mobile)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Frame Time Stats... ";
+
+   {
+      FrameTimeStats stats(100);
+      FrameTimeStats::Summary summary = stats.getSummary();
+      assert(summary.frames == 0 && summary.max == 0.0 && stats.getPercentile(99.0) == 0.0);
+
+      // 98 frame a 16 ms e due scatti: la media quasi non cambia, p99 e massimo si'
+      for (int i = 0; i < 98; i++) stats.addFrame(16.0);
+      stats.addFrame(100.0);
+      stats.addFrame(400.0); // oltre l'ultimo intervallo: overflow
+      summary = stats.getSummary();
+      assert(summary.frames == 100);
+      assert(summary.min == 16.0 && summary.max == 400.0);
+      assert(std::abs(summary.mean - 20.68) < 1e-9);
+      assert(std::abs(summary.p50 - 16.0) <= FrameTimeStats::BUCKET_MS);
+      assert(std::abs(summary.p95 - 16.0) <= FrameTimeStats::BUCKET_MS);
+      assert(std::abs(summary.p99 - 100.0) <= FrameTimeStats::BUCKET_MS);
+      assert(stats.getPercentile(100.0) == 400.0);
+      assert(stats.getHistogram()[FrameTimeStats::NUM_BUCKETS] == 1);
+
+      // Finestra mobile: gli scatti escono e l'istogramma resta coerente
+      for (int i = 0; i < 100; i++) stats.addFrame(10.0);
+      summary = stats.getSummary();
+      assert(summary.frames == 100 && stats.getTotalFrames() == 200);
+      assert(summary.min == 10.0 && summary.max == 10.0 && std::abs(summary.mean - 10.0) < 1e-9);
+      assert(summary.p99 == 10.0);
+      unsigned int counted = 0;
+      for (unsigned int count : stats.getHistogram()) counted += count;
+      assert(counted == 100 && stats.getHistogram()[FrameTimeStats::NUM_BUCKETS] == 0);
+
+      // Rapporto JSON
+      std::string reportPath = "frame_stats_test.json";
+      assert(stats.writeReport(reportPath));
+      std::ifstream reportFile(reportPath);
+      std::string report((std::istreambuf_iterator<char>(reportFile)), std::istreambuf_iterator<char>());
+      reportFile.close();
+      std::remove(reportPath.c_str());
+      assert(report.find("\"p99Ms\": 10.000") != std::string::npos);
+      assert(report.find("\"histogram\": [[10.000, 100]]") != std::string::npos);
+
+      stats.reset();
+      assert(stats.getCount() == 0 && stats.getTotalFrames() == 0);
+      assert(FrameTimeStats(0).getWindowSize() == 1);
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 27. TESTING TESTO CON ATLANTE DI GLIFI (metriche, lotto, pixel disegnati)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Text Renderer... ";
+
+   {
+      // Metriche dei font incorporati, senza contesto
+      const BitmapFont& fixed = BitmapFont::fixed8x13();
+      const BitmapFont& times = BitmapFont::timesRoman24();
+      assert(fixed.getHeight() == 14 && fixed.getOriginY() == 3 && times.getHeight() == 29);
+      assert(fixed.getTextWidth("FPS: 60.00") == 80);
+      assert(fixed.getAdvance('\n') == 0 && !fixed.hasGlyph(200) && fixed.hasGlyph('~'));
+      assert(times.getAdvance(' ') == 6 && times.getAdvance('!') == 8 && times.getAdvance('W') > times.getAdvance('i'));
+      assert(TextRenderer::getTextWidth(TextRenderer::Font::TIMES_ROMAN_24, "Wi") == times.getAdvance('W') + times.getAdvance('i'));
+      // '!' a spaziatura fissa: colonna 3, punto alla riga 3 dal basso (linea di base), asta 5..11
+      assert(fixed.getPixel('!', 3, 3) && !fixed.getPixel('!', 3, 4) && fixed.getPixel('!', 3, 5) && fixed.getPixel('!', 3, 11));
+      assert(!fixed.getPixel('!', 3, 2) && !fixed.getPixel('!', 3, 12) && !fixed.getPixel('!', 2, 5) && !fixed.getPixel(' ', 3, 3) && !fixed.getPixel('!', 8, 3));
+
+      // Lotto: un quadrilatero per carattere con glifo, qualunque font e colore
+      TextRenderer text;
+      assert(!text.isReady() && text.getAtlasHeight() >= 29 && (text.getAtlasHeight() & (text.getAtlasHeight() - 1)) == 0);
+      text.add(TextRenderer::Font::FIXED_8_BY_13, 0.0f, 0.0f, "ab\tc", glm::vec4(1.0f));
+      text.add(TextRenderer::Font::TIMES_ROMAN_24, 0.0f, 0.0f, "Vinto!", glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+      assert(text.getQuadCount() == 9);
+      text.draw(); // senza atlante svuota soltanto
+      assert(text.getQuadCount() == 0);
+
+      // Disegno reale: i pixel accesi sono quelli del glifo
+      OffscreenContext offscreen;
+      if (offscreen.create(64, 32)) {
+         StateCache::invalidate();
+         assert(text.init() && text.isReady() && text.getAtlasId() != 0);
+         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+         glClear(GL_COLOR_BUFFER_BIT);
+         StateCache::disable(GL_LIGHTING);
+         StateCache::disable(GL_DEPTH_TEST);
+         glMatrixMode(GL_PROJECTION);
+         glLoadMatrixf(glm::value_ptr(glm::ortho(0.0f, 64.0f, 0.0f, 32.0f, -1.0f, 1.0f)));
+         glMatrixMode(GL_MODELVIEW);
+         glLoadIdentity();
+
+         text.add(TextRenderer::Font::FIXED_8_BY_13, 10.0f, 10.0f, "!", glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+         text.add(TextRenderer::Font::FIXED_8_BY_13, 30.0f, 10.0f, "!", glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+         text.draw();
+
+         std::vector<uint8_t> pixels;
+         assert(offscreen.readPixels(pixels));
+         auto pixel = [&](int x, int y) { return &pixels[(size_t)(y * 64 + x) * 4]; };
+         // Linea di base a y = 10, glifo spostato di 3 in basso: il punto a y = 10, l'asta da 12 a 18
+         for (int y = 12; y <= 18; y++) {
+            assert(pixel(13, y)[0] == 255 && pixel(13, y)[1] == 0);
+            assert(pixel(33, y)[0] == 0 && pixel(33, y)[1] == 255);
+         }
+         assert(pixel(13, 10)[0] == 255 && pixel(13, 11)[0] == 0 && pixel(13, 9)[0] == 0 && pixel(13, 19)[0] == 0);
+         assert(pixel(12, 14)[0] == 0 && pixel(14, 14)[0] == 0);
+
+         text.free();
+         assert(!text.isReady());
+         offscreen.destroy();
+         StateCache::invalidate();
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 28. TESTING HUD (testi conservati, ricostruzione solo dei modificati)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Hud... ";
+
+   {
+      TextRenderer renderer; // senza atlante draw() non disegna, ma la geometria si costruisce
+      Hud hud;
+      Hud::TextHandle title = hud.createText("Menu", 0.0f, -12.0f, Hud::Anchor::TOP_LEFT);
+      Hud::TextHandle score = hud.createText("0", 10.0f, 10.0f);
+      assert(hud.getNumTexts() == 2 && hud.isValid(title) && hud.isValid(score) && title != score);
+
+      hud.draw(renderer, 100, 50);
+      assert(hud.getRebuildCount() == 2 && hud.getQuadCount() == 5);
+
+      // Testo statico: nessuna ricostruzione
+      for (int i = 0; i < 10; i++) hud.draw(renderer, 100, 50);
+      assert(hud.getRebuildCount() == 2);
+      assert(hud.setText(score, "0") && hud.setPosition(score, 10.0f, 10.0f) && hud.setColor(score, glm::vec4(1.0f)));
+      hud.draw(renderer, 100, 50);
+      assert(hud.getRebuildCount() == 2);
+
+      // Solo l'elemento cambiato viene ricostruito
+      assert(hud.setText(score, "100") && hud.getText(score) == "100");
+      hud.draw(renderer, 100, 50);
+      assert(hud.getRebuildCount() == 3 && hud.getQuadCount() == 7);
+
+      // Nascosto: il lotto cambia, la geometria no
+      assert(hud.setVisible(title, false));
+      hud.draw(renderer, 100, 50);
+      assert(hud.getRebuildCount() == 3 && hud.getQuadCount() == 3);
+      assert(hud.setVisible(title, true));
+
+      // Ridimensionamento: solo gli elementi ancorati
+      hud.draw(renderer, 200, 80);
+      assert(hud.getRebuildCount() == 4 && hud.getQuadCount() == 7);
+
+      // Handle di un elemento distrutto: non valido anche con lo slot riutilizzato
+      assert(hud.destroyText(score) && !hud.isValid(score) && !hud.destroyText(score));
+      Hud::TextHandle reused = hud.createText("x", 0.0f, 0.0f);
+      assert(reused.index == score.index && reused != score);
+      assert(!hud.setText(score, "y") && hud.getText(score).empty() && hud.getText(reused) == "x");
+      hud.draw(renderer, 200, 80);
+      assert(hud.getQuadCount() == 5);
+
+      hud.clear();
+      assert(hud.getNumTexts() == 0 && !hud.isValid(title) && !hud.isValid(reused));
+      hud.draw(renderer, 200, 80);
+      assert(hud.getQuadCount() == 0);
+
+      // Disegno reale: ancora al centro, testo centrato in orizzontale
+      OffscreenContext offscreen;
+      if (offscreen.create(64, 32)) {
+         StateCache::invalidate();
+         assert(renderer.init());
+         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+         glClear(GL_COLOR_BUFFER_BIT);
+         StateCache::disable(GL_LIGHTING);
+         StateCache::disable(GL_DEPTH_TEST);
+         glMatrixMode(GL_PROJECTION);
+         glLoadMatrixf(glm::value_ptr(glm::ortho(0.0f, 64.0f, 0.0f, 32.0f, -1.0f, 1.0f)));
+         glMatrixMode(GL_MODELVIEW);
+         glLoadIdentity();
+
+         hud.createText("!", 0.0f, 0.0f, Hud::Anchor::CENTER, TextRenderer::Font::FIXED_8_BY_13, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+         hud.draw(renderer, 64, 32);
+         std::vector<uint8_t> pixels;
+         assert(offscreen.readPixels(pixels));
+         // Larghezza 8: inizio a x = 28, colonna 3 del glifo a x = 31; punto sulla linea di base y = 16
+         assert(pixels[(16 * 64 + 31) * 4 + 2] == 255 && pixels[(18 * 64 + 31) * 4 + 2] == 255);
+         assert(pixels[(18 * 64 + 30) * 4 + 2] == 0 && pixels[(17 * 64 + 31) * 4 + 2] == 0);
+
+         renderer.free();
+         offscreen.destroy();
+         StateCache::invalidate();
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 29. TESTING TRIPLE BUFFER (passaggio senza lock tra produttore e consumatore)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Triple Buffer... ";
+
+   {
+      // Un solo thread: il lettore vede sempre l'ultima copia pubblicata
+      TripleBuffer<int> buffer;
+      assert(!buffer.hasNew());
+      buffer.getWriteBuffer() = 1;
+      buffer.publish();
+      assert(buffer.hasNew() && buffer.getReadBuffer() == 1 && !buffer.hasNew());
+      assert(buffer.getReadBuffer() == 1); // nessuna novita': stessa copia
+      buffer.getWriteBuffer() = 2;
+      buffer.publish();
+      buffer.getWriteBuffer() = 3;
+      buffer.publish(); // la 2 non letta viene scavalcata
+      assert(buffer.getReadBuffer() == 3);
+      // Lo scrittore non riceve mai la copia in lettura
+      int& read = buffer.getReadBuffer();
+      assert(&buffer.getWriteBuffer() != &read);
+
+      // Due thread: ogni copia letta e' completa e le copie arrivano in ordine
+      struct Frame {
+         uint64_t id = 0;
+         std::vector<uint64_t> values;
+      };
+      TripleBuffer<Frame> frames;
+      const uint64_t count = 20000;
+      std::thread producer([&]() {
+         for (uint64_t id = 1; id <= count; id++) {
+            Frame& frame = frames.getWriteBuffer();
+            frame.id = id;
+            frame.values.assign(16, id);
+            frames.publish();
+         }
+      });
+      uint64_t last = 0;
+      bool consistent = true;
+      while (last < count) {
+         const Frame& frame = frames.getReadBuffer();
+         if (frame.id < last) consistent = false;
+         for (uint64_t value : frame.values) if (value != frame.id) consistent = false;
+         last = std::max(last, frame.id);
+      }
+      producer.join();
+      assert(consistent && last == count);
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 30. TESTING CODA DELL'INPUT (stato dei tasti, ripetizioni fuse)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Input Queue... ";
+
+   {
+      InputQueue input;
+      assert(!input.isKeyDown('w') && input.getEvents().empty());
+
+      // Pressione e ripetizioni nello stesso frame: resta un solo evento
+      assert(input.keyboard('w', true, 10, 20));
+      assert(!input.keyboard('w', true, 11, 21));
+      assert(!input.keyboard('w', true, 12, 22));
+      assert(input.getEvents().size() == 1 && input.getCoalescedCount() == 2);
+      assert(input.isKeyDown('w') && input.isKeyDown('W') && input.wasKeyPressed('w'));
+      assert(input.getMousePosition() == glm::ivec2(12, 22));
+
+      // Frame successivo: lo stato resta, la prima ripetizione passa marcata come tale
+      input.clearEvents();
+      assert(input.isKeyDown('w') && !input.wasKeyPressed('w') && input.getCoalescedCount() == 0);
+      assert(input.keyboard('w', true, 0, 0));
+      assert(input.getEvents()[0].repeat && !input.wasKeyPressed('w'));
+
+      // Rilascio con Shift premuto: la lettera non resta bloccata
+      assert(input.keyboard('W', false, 0, 0));
+      assert(!input.isKeyDown('w'));
+
+      // L'evento conserva la maiuscola (arriva cosi' alla callback); stato e ricerca la ignorano
+      input.clearEvents();
+      assert(input.keyboard('R', true, 0, 0));
+      assert(!input.keyboard('r', true, 0, 0));
+      assert(input.getEvents().size() == 1 && input.getEvents()[0].key == 'R');
+      assert(input.isKeyDown('r') && input.wasKeyPressed('r') && input.wasKeyPressed('R'));
+      assert(input.keyboard('r', false, 0, 0) && !input.isKeyDown('R'));
+      assert(input.getEvents()[1].key == 'r');
+
+      // Pressione breve tra due frame: lo stato e' gia' rilasciato ma l'evento resta
+      input.clearEvents();
+      input.special(101, true, 0, 0);
+      input.special(101, false, 0, 0);
+      assert(!input.isSpecialDown(101) && input.wasSpecialPressed(101) && input.getEvents().size() == 2);
+      assert(input.getEvents()[0].device == InputQueue::Device::SPECIAL && input.getEvents()[0].down);
+
+      // Tasti speciali e caratteri sono indipendenti; codici fuori intervallo non toccano lo stato
+      input.special('a', true, 0, 0);
+      assert(input.isSpecialDown('a') && !input.isKeyDown('a'));
+      assert(input.special(1000, true, 0, 0) && !input.isSpecialDown(1000));
+
+      input.mouse(0, true, 5, 6);
+      assert(input.isMouseDown(0) && !input.isMouseDown(2) && !input.isMouseDown(99));
+      input.releaseAll();
+      assert(!input.isSpecialDown('a') && !input.isMouseDown(0));
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 31. TESTING VISTE MULTIPLE (una lista, culling per vista, riquadri separati)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Viste multiple... ";
+
+   {
+      OffscreenContext offscreen;
+      if (!offscreen.create(64, 48)) {
+         std::cout << "(EGL non disponibile, saltato) ";
+      }
+      else {
+         StateCache::invalidate();
+         // Due quadrati lontani: ogni vista ne inquadra uno, la lista resta una sola
+         Mesh* left = new Mesh("Sinistra");
+         Mesh* right = new Mesh("Destra");
+         for (Mesh* square : { left, right }) {
+            square->set_all_vertices({ glm::vec3(-1, -1, 0), glm::vec3(1, -1, 0), glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0) });
+            square->set_face_vertices({ { 0, 1, 2 }, { 0, 2, 3 } });
+         }
+         Node* group = new Node("Gruppo");
+         group->addChild(left);
+         group->addChild(right);
+         left->setM(glm::translate(glm::mat4(1.0f), glm::vec3(-5, 0, 0)));
+         right->setM(glm::translate(glm::mat4(1.0f), glm::vec3(5, 0, 0)));
+
+         List views;
+         views.pass(group, glm::mat4(1.0f));
+         assert(views.getNumInstances() == 3); // il gruppo senza geometria e i due quadrati
+
+         glm::mat4 projection = glm::ortho(-2.0f, 2.0f, -1.5f, 1.5f, -10.0f, 10.0f);
+         glm::mat4 lookLeft = glm::translate(glm::mat4(1.0f), glm::vec3(5, 0, 0));
+         glm::mat4 lookRight = glm::translate(glm::mat4(1.0f), glm::vec3(-5, 0, 0));
+         glm::mat4 lookAway = glm::translate(glm::mat4(1.0f), glm::vec3(0, -50, 0));
+
+         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+         StateCache::disable(GL_LIGHTING);
+         StateCache::disable(GL_CULL_FACE);
+         glMatrixMode(GL_PROJECTION);
+         glLoadMatrixf(glm::value_ptr(projection));
+
+         // Ogni vista scarta cio' che non inquadra (i nodi senza geometria passano sempre)
+         glViewport(0, 0, 32, 24);
+         views.renderCulled(lookLeft, projection);
+         assert(views.getLastVisibleCount() == 2);
+         glViewport(32, 24, 32, 24);
+         views.renderCulled(lookRight, projection);
+         assert(views.getLastVisibleCount() == 2);
+         views.renderCulled(lookAway, projection);
+         assert(views.getLastVisibleCount() == 1);
+         glm::mat4 wide = glm::ortho(-8.0f, 8.0f, -6.0f, 6.0f, -10.0f, 10.0f);
+         views.renderCulled(glm::mat4(1.0f), wide);
+         assert(views.getLastVisibleCount() == 3);
+         assert(views.getNumInstances() == 3);
+
+         // Ogni vista disegna solo nel proprio riquadro
+         std::vector<uint8_t> pixels;
+         assert(offscreen.readPixels(pixels));
+         auto lit = [&](int x, int y) { return pixels[(y * 64 + x) * 4] > 128; };
+         assert(lit(16, 12) && lit(48, 36));
+         assert(!lit(48, 12) && !lit(16, 36));
+
+         glViewport(0, 0, 64, 48);
+         views.clear();
+         assert(views.getNumInstances() == 0);
+         delete left;
+         delete right;
+         delete group;
+         offscreen.destroy();
+         StateCache::invalidate();
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+
+   // ------------------------------------------------------------------------
+   // 32. TESTING PIPELINE CON SCENA RICOSTRUITA (lista pronta scartata)
+   // ------------------------------------------------------------------------
+   std::cout << "[TEST] Pipeline e scena ricostruita... ";
+
+   {
+      // Quadrato che conta i propri disegni e segnala quelli arrivati dopo il ritiro dalla scena
+      struct SceneProbe : public Mesh {
+         bool retired = false;
+         int draws = 0;
+         bool* staleDraw;
+         SceneProbe(const char* name, bool* staleDraw) : Mesh(name), staleDraw(staleDraw) {
+            set_all_vertices({ glm::vec3(-1, -1, 0), glm::vec3(1, -1, 0), glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0) });
+            set_face_vertices({ { 0, 1, 2 }, { 0, 2, 3 } });
+         }
+         void render() override {
+            if (retired) *staleDraw = true;
+            draws++;
+            Mesh::render();
+         }
+      };
+
+      Eng::Base& engine = Eng::Base::getInstance();
+      bool ready = engine.init(0, nullptr);
+      if (ready && !engine.createOffscreen(32, 32)) {
+         engine.free();
+         ready = false;
+      }
+      if (!ready) {
+         std::cout << "(EGL non disponibile, saltato) ";
+      }
+      else {
+         bool staleDraw = false;
+         SceneProbe* first = new SceneProbe("Prima", &staleDraw);
+         SceneProbe* scene = first;
+         PerspectiveCamera* pipeCam = new PerspectiveCamera("PipeCam", 60.0f, 1.0f, 0.1f, 100.0f);
+         glm::mat4 place = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f));
+         engine.setMainCamera(pipeCam);
+         engine.setBuildCallback([&](List& list) { list.pass(scene, place); });
+         assert(engine.setPipelined(true));
+         assert(engine.renderOffscreen(2) == 2);
+         assert(first->draws == 2);
+
+         // Scena sostituita tra due frame (come una callback di input): la lista pronta va scartata
+         first->retired = true;
+         SceneProbe* second = new SceneProbe("Seconda", &staleDraw);
+         scene = second;
+         engine.invalidateSnapshot();
+         assert(engine.renderOffscreen(1) == 1);
+         assert(!staleDraw && second->draws == 1);
+
+         // Scena sostituita dentro il frame, prima del disegno (callback di display o input in coda)
+         SceneProbe* third = new SceneProbe("Terza", &staleDraw);
+         engine.setDisplayCallback([&]() {
+            if (scene != second) return;
+            second->retired = true;
+            scene = third;
+            engine.invalidateSnapshot();
+         });
+         assert(engine.renderOffscreen(2) == 2);
+         assert(!staleDraw && third->draws == 2);
+
+         // Picking in pipeline: il risultato arriva all'inizio di un frame successivo, a worker fermo
+         Node* picked = nullptr;
+         assert(engine.requestPick(16, 16, [&](Node* node) { picked = node; }));
+         assert(engine.renderOffscreen(4) == 4);
+         assert(picked == third);
+
+         engine.setDisplayCallback(nullptr);
+         engine.setPipelined(false);
+         engine.setBuildCallback(nullptr);
+         engine.setMainCamera(nullptr);
+         engine.free();
+         delete first;
+         delete second;
+         delete third;
+         delete pipeCam;
+         StateCache::invalidate();
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+
    // ------------------------------------------------------------------------
    // CLEANUP
    // ------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+#include "framePacer.h"
+#include <algorithm>
+#include <thread>
+
+/**
+ * @file framePacer.cpp
+ * @brief Implementazione della classe FramePacer.
+ */
+
+namespace {
+   /** @brief Margine lasciato all'attesa attiva: i risvegli del sistema possono tardare di circa 1 ms. */
+   constexpr std::chrono::microseconds SPIN_MARGIN(2000);
+}
+
+void FramePacer::setMode(Mode mode, float targetFps) {
+   this->mode = mode;
+   this->targetFps = std::max(targetFps, 1.0f);
+   deadline = Clock::now();
+}
+
+FramePacer::Mode FramePacer::getMode() const { return mode; }
+
+float FramePacer::getTargetFps() const { return targetFps; }
+
+void FramePacer::requestRedraw() { redrawRequested = true; }
+
+bool FramePacer::isRedrawRequested() const { return redrawRequested; }
+
+void FramePacer::setAnimating(bool animating) { this->animating = animating; }
+
+bool FramePacer::isAnimating() const { return animating; }
+
+bool FramePacer::frameDone(Clock::time_point now, Clock::time_point& next) {
+   bool requested = redrawRequested;
+   redrawRequested = false;
+   next = now;
+
+   switch (mode) {
+   case Mode::FIXED_FPS: {
+      auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+      // Un frame in ritardo non viene recuperato con una raffica: la cadenza riparte da adesso
+      deadline = std::max(deadline + period, now);
+      next = deadline;
+      return true;
+   }
+   case Mode::ON_DEMAND:
+      return requested || animating;
+   default:
+      return true;
+   }
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline) {
+   for (;;) {
+      auto remaining = deadline - Clock::now();
+      if (remaining <= Clock::duration::zero()) return;
+      if (remaining > SPIN_MARGIN)
+         std::this_thread::sleep_for(remaining - SPIN_MARGIN);
+      else
+         std::this_thread::yield();
+   }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file framePacer.h
+ * @brief Decide quando disegnare il frame successivo.
+ */
+#pragma once
+#include "libConfig.h"
+#include <chrono>
+
+/**
+ * @class FramePacer
+ * @brief Politica di cadenza dei frame usata da Eng::Base al termine di ogni frame.
+ *
+ * Non chiama GLUT ne' OpenGL: dopo ogni frame frameDone() dice se e quando disegnarne un altro,
+ * e il motore lo programma. In modalita' ON_DEMAND, senza input, animazioni o modifiche il ciclo
+ * resta fermo in attesa di eventi e il processo non consuma CPU.
+ */
+class ENG_API FramePacer {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   /**
+    * @brief Modalita' di cadenza.
+    */
+   enum class Mode : int {
+      CONTINUOUS, ///< Un frame dopo l'altro, il piu' velocemente possibile
+      VSYNC,      ///< Un frame dopo l'altro, con lo scambio dei buffer sincronizzato al monitor
+      FIXED_FPS,  ///< Al massimo getTargetFps() frame al secondo, attendendo tra un frame e l'altro
+      ON_DEMAND   ///< Solo dopo requestRedraw() o mentre un'animazione e' in corso
+   };
+
+   /**
+    * @brief Cambia modalita'; la cadenza di FIXED_FPS riparte dall'istante della chiamata.
+    * @param mode Nuova modalita'.
+    * @param targetFps Frame al secondo in FIXED_FPS (ignorato dalle altre modalita', minimo 1).
+    */
+   void setMode(Mode mode, float targetFps = 60.0f);
+
+   /**
+    * @brief Restituisce la modalita' corrente.
+    */
+   Mode getMode() const;
+
+   /**
+    * @brief Restituisce i frame al secondo di FIXED_FPS.
+    */
+   float getTargetFps() const;
+
+   /**
+    * @brief Segnala che la scena e' cambiata: in ON_DEMAND verra' disegnato un frame.
+    */
+   void requestRedraw();
+
+   /**
+    * @brief Indica se c'e' una richiesta non ancora consumata da frameDone().
+    */
+   bool isRedrawRequested() const;
+
+   /**
+    * @brief Dichiara se un'animazione e' in corso: in ON_DEMAND i frame continuano finche' e' true.
+    */
+   void setAnimating(bool animating);
+
+   /**
+    * @brief Indica se un'animazione e' in corso.
+    */
+   bool isAnimating() const;
+
+   /**
+    * @brief Da chiamare al termine di ogni frame: consuma le richieste e decide il frame successivo.
+    * @param now Istante di fine del frame.
+    * @param next Istante in cui iniziare il frame successivo (uguale a now se subito).
+    * @return False se non serve un altro frame finche' non arriva una richiesta.
+    */
+   bool frameDone(Clock::time_point now, Clock::time_point& next);
+
+   /**
+    * @brief Attende fino a un istante con precisione inferiore al millisecondo: dorme finche' mancano
+    * piu' di un paio di millisecondi, poi cede il processore fino alla scadenza.
+    * @param deadline Istante da raggiungere.
+    */
+   static void waitUntil(Clock::time_point deadline);
+
+private:
+   Mode mode = Mode::CONTINUOUS;
+   float targetFps = 60.0f;
+   bool redrawRequested = false;
+   bool animating = false;
+   /** @brief Inizio previsto del prossimo frame in FIXED_FPS. */
+   Clock::time_point deadline = Clock::now();
+};
@@ -0,0 +1,119 @@
+#include "frameTimeStats.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+/**
+ * @file frameTimeStats.cpp
+ * @brief Implementazione delle statistiche dei tempi di frame.
+ */
+
+FrameTimeStats::FrameTimeStats(unsigned int windowSize)
+   : windowSize(std::max(1u, windowSize)), window(this->windowSize, 0.0), histogram(NUM_BUCKETS + 1, 0) {}
+
+unsigned int FrameTimeStats::bucketOf(double milliseconds) {
+   if (!(milliseconds > 0.0)) return 0;
+   double bucket = milliseconds / BUCKET_MS;
+   return bucket >= NUM_BUCKETS ? NUM_BUCKETS : (unsigned int)bucket;
+}
+
+void FrameTimeStats::addFrame(double milliseconds) {
+   if (!(milliseconds >= 0.0)) milliseconds = 0.0;
+
+   // Il frame che esce dalla finestra toglie il suo contributo
+   if (count == windowSize) {
+      double old = window[next];
+      histogram[bucketOf(old)]--;
+      sum -= old;
+   } else {
+      count++;
+   }
+
+   window[next] = milliseconds;
+   next = (next + 1) % windowSize;
+   histogram[bucketOf(milliseconds)]++;
+   sum += milliseconds;
+   total++;
+}
+
+double FrameTimeStats::getPercentile(double percentile) const {
+   if (count == 0) return 0.0;
+   percentile = std::clamp(percentile, 0.0, 100.0);
+
+   // Rango piu' vicino: il valore con almeno percentile% dei frame minori o uguali
+   unsigned int rank = std::max(1u, (unsigned int)std::ceil(percentile / 100.0 * count));
+   auto range = std::minmax_element(window.begin(), window.begin() + count);
+   unsigned int cumulative = 0;
+   for (unsigned int i = 0; i < NUM_BUCKETS; i++) {
+      if (cumulative + histogram[i] < rank) {
+         cumulative += histogram[i];
+         continue;
+      }
+      // Interpolazione lineare dentro l'intervallo, mai oltre i valori reali
+      double fraction = (double)(rank - cumulative) / histogram[i];
+      return std::clamp((i + fraction) * BUCKET_MS, *range.first, *range.second);
+   }
+   return *range.second; // overflow: nessuna risoluzione, vale il massimo
+}
+
+FrameTimeStats::Summary FrameTimeStats::getSummary() const {
+   Summary summary;
+   summary.frames = count;
+   if (count == 0) return summary;
+
+   auto range = std::minmax_element(window.begin(), window.begin() + count);
+   summary.min = *range.first;
+   summary.max = *range.second;
+   summary.mean = sum / count;
+   summary.p50 = getPercentile(50.0);
+   summary.p95 = getPercentile(95.0);
+   summary.p99 = getPercentile(99.0);
+   return summary;
+}
+
+const std::vector<unsigned int>& FrameTimeStats::getHistogram() const { return histogram; }
+
+unsigned int FrameTimeStats::getCount() const { return count; }
+
+unsigned long long FrameTimeStats::getTotalFrames() const { return total; }
+
+unsigned int FrameTimeStats::getWindowSize() const { return windowSize; }
+
+void FrameTimeStats::reset() {
+   std::fill(histogram.begin(), histogram.end(), 0);
+   next = 0;
+   count = 0;
+   total = 0;
+   sum = 0.0;
+}
+
+bool FrameTimeStats::writeReport(const std::string& path) const {
+   std::ofstream file(path);
+   if (!file) return false;
+
+   Summary summary = getSummary();
+   file << std::fixed << std::setprecision(3);
+   file << "{\n";
+   file << "  \"frames\": " << summary.frames << ",\n";
+   file << "  \"totalFrames\": " << total << ",\n";
+   file << "  \"windowSize\": " << windowSize << ",\n";
+   file << "  \"minMs\": " << summary.min << ",\n";
+   file << "  \"meanMs\": " << summary.mean << ",\n";
+   file << "  \"p50Ms\": " << summary.p50 << ",\n";
+   file << "  \"p95Ms\": " << summary.p95 << ",\n";
+   file << "  \"p99Ms\": " << summary.p99 << ",\n";
+   file << "  \"maxMs\": " << summary.max << ",\n";
+   file << "  \"bucketMs\": " << BUCKET_MS << ",\n";
+
+   // Coppie [inizio intervallo in ms, conteggio]; l'overflow parte da NUM_BUCKETS * BUCKET_MS
+   file << "  \"histogram\": [";
+   bool first = true;
+   for (unsigned int i = 0; i <= NUM_BUCKETS; i++) {
+      if (histogram[i] == 0) continue;
+      file << (first ? "" : ", ") << "[" << i * BUCKET_MS << ", " << histogram[i] << "]";
+      first = false;
+   }
+   file << "]\n}\n";
+   return (bool)file;
+}
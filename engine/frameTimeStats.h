@@ -0,0 +1,109 @@
+/**
+ * @file frameTimeStats.h
+ * @brief Istogramma dei tempi di frame e percentili su una finestra mobile.
+ */
+#pragma once
+#include "libConfig.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameTimeStats
+ * @brief Statistiche dei tempi di frame sugli ultimi N frame: minimo, media, percentili e massimo.
+ *
+ * La media sul secondo nasconde i singoli scatti (un blocco di 200 ms tra frame a 16 ms cambia poco
+ * gli FPS); i percentili alti no. I tempi entrano in un istogramma a intervalli fissi aggiornato in
+ * modo incrementale: ogni nuovo frame incrementa un intervallo e quello che esce dalla finestra lo
+ * decrementa, quindi aggiungere un frame costa O(1) e un percentile O(NUM_BUCKETS), senza ordinare.
+ * I percentili hanno la risoluzione di BUCKET_MS (interpolati dentro l'intervallo); minimo, media e
+ * massimo sono esatti. I tempi oltre l'ultimo intervallo finiscono in un intervallo di overflow.
+ */
+class ENG_API FrameTimeStats {
+public:
+   /** @brief Ampiezza di un intervallo dell'istogramma in millisecondi. */
+   static constexpr double BUCKET_MS = 0.25;
+   /** @brief Numero di intervalli (fino a 250 ms), piu' uno di overflow. */
+   static constexpr unsigned int NUM_BUCKETS = 1000;
+
+   /**
+    * @struct Summary
+    * @brief Statistiche della finestra corrente, in millisecondi.
+    */
+   struct Summary {
+      unsigned int frames = 0;
+      double min = 0.0;
+      double mean = 0.0;
+      double p50 = 0.0;
+      double p95 = 0.0;
+      double p99 = 0.0;
+      double max = 0.0;
+   };
+
+   /**
+    * @brief Crea statistiche vuote.
+    * @param windowSize Numero di frame della finestra mobile (minimo 1).
+    */
+   explicit FrameTimeStats(unsigned int windowSize = 600);
+
+   /**
+    * @brief Aggiunge il tempo di un frame; oltre windowSize frame esce il piu' vecchio.
+    * @param milliseconds Durata del frame.
+    */
+   void addFrame(double milliseconds);
+
+   /**
+    * @brief Percentile della finestra (rango piu' vicino, interpolato nell'intervallo).
+    * @param percentile Valore tra 0 e 100.
+    * @return Tempo in millisecondi, 0 se la finestra e' vuota.
+    */
+   double getPercentile(double percentile) const;
+
+   /**
+    * @brief Calcola tutte le statistiche della finestra.
+    */
+   Summary getSummary() const;
+
+   /**
+    * @brief Conteggi dell'istogramma della finestra (NUM_BUCKETS + 1 valori, l'ultimo e' l'overflow).
+    */
+   const std::vector<unsigned int>& getHistogram() const;
+
+   /**
+    * @brief Numero di frame nella finestra.
+    */
+   unsigned int getCount() const;
+
+   /**
+    * @brief Numero totale di frame aggiunti dall'ultimo reset().
+    */
+   unsigned long long getTotalFrames() const;
+
+   /**
+    * @brief Restituisce la dimensione della finestra.
+    */
+   unsigned int getWindowSize() const;
+
+   /**
+    * @brief Svuota finestra e istogramma.
+    */
+   void reset();
+
+   /**
+    * @brief Scrive statistiche e istogramma (solo intervalli non vuoti) in un file JSON, per confronti automatici.
+    * @param path Percorso del file.
+    * @return False se il file non puo' essere scritto.
+    */
+   bool writeReport(const std::string& path) const;
+
+private:
+   static unsigned int bucketOf(double milliseconds);
+
+   unsigned int windowSize;
+   /** @brief Ultimi tempi in ordine circolare. */
+   std::vector<double> window;
+   unsigned int next = 0;
+   unsigned int count = 0;
+   unsigned long long total = 0;
+   double sum = 0.0;
+   std::vector<unsigned int> histogram;
+};
@@ -0,0 +1,48 @@
+#include "frustum.h"
+#include <glm/gtc/matrix_access.hpp>
+
+/**
+ * @file frustum.cpp
+ * @brief Implementazione della classe Frustum.
+ */
+
+Frustum::Frustum(const glm::mat4& m) {
+   glm::vec4 row0 = glm::row(m, 0);
+   glm::vec4 row1 = glm::row(m, 1);
+   glm::vec4 row2 = glm::row(m, 2);
+   glm::vec4 row3 = glm::row(m, 3);
+
+   planes[0] = row3 + row0; // sinistro
+   planes[1] = row3 - row0; // destro
+   planes[2] = row3 + row1; // basso
+   planes[3] = row3 - row1; // alto
+   planes[4] = row3 + row2; // vicino
+   planes[5] = row3 - row2; // lontano
+
+   for (auto& plane : planes) {
+      float len = glm::length(glm::vec3(plane));
+      if (len > 0.0f) plane /= len;
+   }
+}
+
+bool Frustum::intersects(const BoundingBox& box) const {
+   if (box.isEmpty()) return false;
+   for (const auto& plane : planes) {
+      // Vertice "positivo": se anche lui e' dietro il piano, la scatola e' fuori
+      glm::vec3 n(plane);
+      glm::vec3 p(n.x >= 0.0f ? box.getMax().x : box.getMin().x,
+                  n.y >= 0.0f ? box.getMax().y : box.getMin().y,
+                  n.z >= 0.0f ? box.getMax().z : box.getMin().z);
+      if (glm::dot(n, p) + plane.w < 0.0f) return false;
+   }
+   return true;
+}
+
+bool Frustum::intersects(const glm::vec3& center, float radius) const {
+   for (const auto& plane : planes) {
+      if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+   }
+   return true;
+}
+
+const glm::vec4& Frustum::getPlane(int index) const { return planes[index]; }
@@ -0,0 +1,45 @@
+/**
+ * @file frustum.h
+ * @brief Definizione del tronco di piramide di visione usato per il culling.
+ */
+#pragma once
+#include "libConfig.h"
+#include "boundingBox.h"
+#include <glm/glm.hpp>
+
+/**
+ * @class Frustum
+ * @brief I sei piani del volume di vista, estratti da una matrice Projection * View.
+ */
+class ENG_API Frustum {
+public:
+   /**
+    * @brief Estrae i piani dalla matrice di clip (metodo di Gribb-Hartmann).
+    * @param viewProjection Matrice Projection * View (eventualmente moltiplicata per altre trasformazioni).
+    */
+   Frustum(const glm::mat4& viewProjection);
+
+   /**
+    * @brief Verifica se una scatola (nello stesso spazio della matrice) e' almeno in parte visibile.
+    * @param box Scatola da verificare.
+    * @return False solo se la scatola e' sicuramente fuori dal frustum.
+    */
+   bool intersects(const BoundingBox& box) const;
+
+   /**
+    * @brief Verifica se una sfera (nello stesso spazio della matrice) e' almeno in parte visibile.
+    * @param center Centro della sfera.
+    * @param radius Raggio della sfera.
+    */
+   bool intersects(const glm::vec3& center, float radius) const;
+
+   /**
+    * @brief Restituisce uno dei sei piani normalizzati (sinistro, destro, basso, alto, vicino, lontano).
+    * @param index Indice del piano (0-5).
+    */
+   const glm::vec4& getPlane(int index) const;
+
+private:
+   /** @brief Piani (a, b, c, d) con la normale rivolta verso l'interno. */
+   glm::vec4 planes[6];
+};
@@ -0,0 +1,75 @@
+/**
+ * @file handle.h
+ * @brief Riferimento sicuro a un oggetto del motore, basato sull'ObjectRegistry.
+ */
+#pragma once
+#include "objectRegistry.h"
+#include <cassert>
+#include <cstdint>
+
+/**
+ * @class Handle
+ * @brief Riferimento a un Object (o derivato) che si accorge della distruzione dell'oggetto.
+ *
+ * Contiene solo lo slot e la generazione dell'oggetto nell'ObjectRegistry: get() costa un accesso
+ * a un array e restituisce nullptr se l'oggetto e' stato distrutto (es. con la scena dopo un reload),
+ * anche se la memoria e' stata riutilizzata da un altro oggetto.
+ */
+template <class T>
+class Handle {
+public:
+   /**
+    * @brief Costruisce un handle vuoto.
+    */
+   Handle() = default;
+
+   /**
+    * @brief Costruisce un handle verso un oggetto esistente (vuoto se object e' nullptr).
+    */
+   explicit Handle(T* object) {
+      if (object) {
+         index = object->getHandleIndex();
+         generation = ObjectRegistry::getGeneration(index);
+      }
+   }
+
+   /**
+    * @brief Restituisce l'oggetto, o nullptr se e' stato distrutto o l'handle e' vuoto.
+    */
+   T* get() const {
+      return static_cast<T*>(ObjectRegistry::resolve(index, generation));
+   }
+
+   /**
+    * @brief True se l'oggetto esiste ancora.
+    */
+   bool isValid() const { return get() != nullptr; }
+
+   explicit operator bool() const { return isValid(); }
+
+   /**
+    * @brief Accesso diretto all'oggetto, che deve esistere ancora.
+    */
+   T* operator->() const {
+      T* object = get();
+      assert(object && "Handle verso un oggetto distrutto");
+      return object;
+   }
+
+   /**
+    * @brief Svuota l'handle.
+    */
+   void reset() { *this = Handle(); }
+
+   bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+   bool operator!=(const Handle& other) const { return !(*this == other); }
+
+   /** @brief Indice dello slot nell'ObjectRegistry. */
+   uint32_t getIndex() const { return index; }
+   /** @brief Generazione dello slot al momento della creazione dell'handle. */
+   uint32_t getGeneration() const { return generation; }
+
+private:
+   uint32_t index = ObjectRegistry::INVALID_INDEX;
+   uint32_t generation = 0;
+};
@@ -0,0 +1,158 @@
+#include "hud.h"
+
+/**
+ * @file hud.cpp
+ * @brief Implementazione dei testi a schermo conservati.
+ */
+
+Hud::TextHandle Hud::createText(const std::string& text, float x, float y, Anchor anchor, TextRenderer::Font font, const glm::vec4& color) {
+   uint32_t index;
+   if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+   } else {
+      index = (uint32_t)elements.size();
+      elements.emplace_back();
+   }
+
+   Element& element = elements[index];
+   element.text = text;
+   element.position = glm::vec2(x, y);
+   element.anchor = anchor;
+   element.font = font;
+   element.color = color;
+   element.visible = true;
+   element.alive = true;
+   element.vertices.clear();
+   touch(element);
+   numTexts++;
+
+   TextHandle handle;
+   handle.index = index;
+   handle.generation = element.generation;
+   return handle;
+}
+
+bool Hud::destroyText(TextHandle handle) {
+   Element* element = find(handle);
+   if (!element) return false;
+   element->alive = false;
+   element->generation++; // invalida gli handle esistenti
+   element->text.clear();
+   element->vertices.clear();
+   freeSlots.push_back(handle.index);
+   numTexts--;
+   batchDirty = true;
+   return true;
+}
+
+bool Hud::isValid(TextHandle handle) const { return find(handle) != nullptr; }
+
+bool Hud::setText(TextHandle handle, const std::string& text) {
+   Element* element = find(handle);
+   if (!element) return false;
+   if (element->text != text) {
+      element->text = text;
+      touch(*element);
+   }
+   return true;
+}
+
+const std::string& Hud::getText(TextHandle handle) const {
+   static const std::string empty;
+   const Element* element = find(handle);
+   return element ? element->text : empty;
+}
+
+bool Hud::setPosition(TextHandle handle, float x, float y) {
+   Element* element = find(handle);
+   if (!element) return false;
+   if (element->position != glm::vec2(x, y)) {
+      element->position = glm::vec2(x, y);
+      touch(*element);
+   }
+   return true;
+}
+
+bool Hud::setColor(TextHandle handle, const glm::vec4& color) {
+   Element* element = find(handle);
+   if (!element) return false;
+   if (element->color != color) {
+      element->color = color;
+      touch(*element);
+   }
+   return true;
+}
+
+bool Hud::setVisible(TextHandle handle, bool visible) {
+   Element* element = find(handle);
+   if (!element) return false;
+   if (element->visible != visible) {
+      element->visible = visible;
+      batchDirty = true; // la geometria resta valida: cambia solo il lotto
+   }
+   return true;
+}
+
+unsigned int Hud::getNumTexts() const { return numTexts; }
+
+void Hud::clear() {
+   for (uint32_t i = 0; i < elements.size(); i++)
+      if (elements[i].alive) destroyText({ i, elements[i].generation });
+}
+
+void Hud::draw(const TextRenderer& renderer, int width, int height) {
+   // Gli elementi ancorati dipendono dalla dimensione della finestra
+   if (width != this->width || height != this->height) {
+      this->width = width;
+      this->height = height;
+      for (Element& element : elements)
+         if (element.alive && element.anchor != Anchor::BOTTOM_LEFT) touch(element);
+   }
+
+   if (anyDirty) {
+      for (Element& element : elements) {
+         if (!element.alive || !element.dirty) continue;
+         const BitmapFont& font = TextRenderer::getFont(element.font);
+         glm::vec2 origin = element.position;
+         switch (element.anchor) {
+         case Anchor::BOTTOM_LEFT: break;
+         case Anchor::TOP_LEFT:    origin.y += height; break;
+         case Anchor::TOP_RIGHT:   origin += glm::vec2(width - font.getTextWidth(element.text), height); break;
+         case Anchor::CENTER:      origin += glm::vec2((width - font.getTextWidth(element.text)) / 2.0f, height / 2.0f); break;
+         }
+         element.vertices.clear();
+         renderer.append(element.font, origin.x, origin.y, element.text, element.color, element.vertices);
+         element.dirty = false;
+         rebuilds++;
+      }
+      anyDirty = false;
+   }
+
+   if (batchDirty) {
+      batch.clear();
+      for (const Element& element : elements)
+         if (element.alive && element.visible) batch.insert(batch.end(), element.vertices.begin(), element.vertices.end());
+      batchDirty = false;
+   }
+
+   renderer.draw(batch);
+}
+
+unsigned long long Hud::getRebuildCount() const { return rebuilds; }
+
+unsigned int Hud::getQuadCount() const { return (unsigned int)(batch.size() / (TextRenderer::FLOATS_PER_VERTEX * 4)); }
+
+Hud::Element* Hud::find(TextHandle handle) {
+   if (handle.index >= elements.size()) return nullptr;
+   Element& element = elements[handle.index];
+   return element.alive && element.generation == handle.generation ? &element : nullptr;
+}
+
+const Hud::Element* Hud::find(TextHandle handle) const { return const_cast<Hud*>(this)->find(handle); }
+
+void Hud::touch(Element& element) {
+   element.dirty = true;
+   anyDirty = true;
+   batchDirty = true;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file hud.h
+ * @brief Testi a schermo conservati tra i frame, ricostruiti solo quando cambiano.
+ */
+#pragma once
+#include "libConfig.h"
+#include "textRenderer.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class Hud
+ * @brief Elementi di testo creati una volta e aggiornati solo quando il contenuto cambia.
+ *
+ * addToScreenText() e addString() di Eng::Base vanno ripetuti a ogni frame e ogni volta il testo
+ * viene copiato e disposto di nuovo. Un elemento dell'Hud invece vive finche' non viene distrutto:
+ * la sua geometria (i quadrilateri di TextRenderer) resta in memoria e viene ricalcolata solo se
+ * cambiano testo, posizione, colore o, per gli elementi ancorati, la dimensione della finestra.
+ * Anche il lotto complessivo si ricompone solo dopo una modifica, quindi con testo statico un frame
+ * costa una sola draw call.
+ *
+ * Gli elementi si raggiungono con un TextHandle (slot e generazione, come gli Handle degli Object):
+ * un handle di un elemento distrutto non e' piu' valido anche se lo slot e' stato riutilizzato.
+ */
+class ENG_API Hud {
+public:
+   /**
+    * @brief Punto della finestra a cui si riferisce la posizione di un elemento.
+    */
+   enum class Anchor {
+      BOTTOM_LEFT, ///< Posizione assoluta, origine in basso a sinistra.
+      TOP_LEFT,    ///< Y misurata dal bordo superiore (es. -12 per la prima riga).
+      TOP_RIGHT,   ///< Testo allineato a destra; X e Y misurate dall'angolo in alto a destra.
+      CENTER       ///< Testo centrato in orizzontale; posizione relativa al centro della finestra.
+   };
+
+   /**
+    * @struct TextHandle
+    * @brief Riferimento a un elemento di testo.
+    */
+   struct TextHandle {
+      uint32_t index = 0xFFFFFFFFu;
+      uint32_t generation = 0;
+      bool operator==(const TextHandle& other) const { return index == other.index && generation == other.generation; }
+      bool operator!=(const TextHandle& other) const { return !(*this == other); }
+   };
+
+   /**
+    * @brief Crea un elemento di testo visibile.
+    * @param text Testo.
+    * @param x Posizione orizzontale della linea di base, relativa all'ancora.
+    * @param y Posizione verticale della linea di base, relativa all'ancora.
+    * @param anchor Punto di riferimento della posizione.
+    * @param font Font.
+    * @param color Colore RGBA.
+    * @return Handle dell'elemento.
+    */
+   TextHandle createText(const std::string& text, float x, float y, Anchor anchor = Anchor::BOTTOM_LEFT,
+                         TextRenderer::Font font = TextRenderer::Font::FIXED_8_BY_13, const glm::vec4& color = glm::vec4(1.0f));
+
+   /**
+    * @brief Distrugge un elemento.
+    * @return False se l'handle non e' valido.
+    */
+   bool destroyText(TextHandle handle);
+
+   /**
+    * @brief Indica se l'elemento esiste ancora.
+    */
+   bool isValid(TextHandle handle) const;
+
+   /**
+    * @brief Cambia il testo; se e' uguale al precedente non succede nulla.
+    * @return False se l'handle non e' valido.
+    */
+   bool setText(TextHandle handle, const std::string& text);
+
+   /**
+    * @brief Restituisce il testo di un elemento (vuoto se l'handle non e' valido).
+    */
+   const std::string& getText(TextHandle handle) const;
+
+   /**
+    * @brief Sposta un elemento (stessa ancora).
+    * @return False se l'handle non e' valido.
+    */
+   bool setPosition(TextHandle handle, float x, float y);
+
+   /**
+    * @brief Cambia il colore di un elemento.
+    * @return False se l'handle non e' valido.
+    */
+   bool setColor(TextHandle handle, const glm::vec4& color);
+
+   /**
+    * @brief Mostra o nasconde un elemento senza distruggerlo.
+    * @return False se l'handle non e' valido.
+    */
+   bool setVisible(TextHandle handle, bool visible);
+
+   /**
+    * @brief Numero di elementi esistenti.
+    */
+   unsigned int getNumTexts() const;
+
+   /**
+    * @brief Distrugge tutti gli elementi (gli handle esistenti diventano non validi).
+    */
+   void clear();
+
+   /**
+    * @brief Ricostruisce gli elementi modificati e disegna il lotto con una sola draw call.
+    * @param renderer Atlante dei glifi.
+    * @param width Larghezza della finestra (per le ancore).
+    * @param height Altezza della finestra (per le ancore).
+    */
+   void draw(const TextRenderer& renderer, int width, int height);
+
+   /**
+    * @brief Numero di elementi ricostruiti dalla creazione dell'Hud (per verificare il riuso della geometria).
+    */
+   unsigned long long getRebuildCount() const;
+
+   /**
+    * @brief Numero di caratteri nel lotto dell'ultimo draw().
+    */
+   unsigned int getQuadCount() const;
+
+private:
+   struct Element {
+      std::string text;
+      glm::vec2 position = glm::vec2(0.0f);
+      Anchor anchor = Anchor::BOTTOM_LEFT;
+      TextRenderer::Font font = TextRenderer::Font::FIXED_8_BY_13;
+      glm::vec4 color = glm::vec4(1.0f);
+      bool visible = true;
+      bool alive = false;
+      bool dirty = true;
+      uint32_t generation = 0;
+      /** @brief Geometria disposta dall'ultima ricostruzione. */
+      std::vector<float> vertices;
+   };
+
+   /** @brief Elemento dell'handle, o nullptr se non valido. */
+   Element* find(TextHandle handle);
+   const Element* find(TextHandle handle) const;
+   /** @brief Segna un elemento da ricostruire. */
+   void touch(Element& element);
+
+   std::vector<Element> elements;
+   std::vector<uint32_t> freeSlots;
+   unsigned int numTexts = 0;
+   /** @brief Almeno un elemento va ricostruito. */
+   bool anyDirty = false;
+   /** @brief Il lotto va ricomposto. */
+   bool batchDirty = false;
+   int width = -1;
+   int height = -1;
+   unsigned long long rebuilds = 0;
+   std::vector<float> batch;
+};
@@ -0,0 +1,372 @@
+#include "idPicker.h"
+#include "list.h"
+#include "stateCache.h"
+#include <GL/freeglut.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @file idPicker.cpp
+ * @brief Implementazione della classe IdPicker.
+ */
+
+// Costanti di OpenGL 3.x non presenti nel gl.h di Windows (1.1)
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_DEPTH_ATTACHMENT
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24 0x81A6
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_FRAMEBUFFER_BINDING
+#define GL_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+#ifndef GL_COLOR_CLEAR_VALUE
+#define GL_COLOR_CLEAR_VALUE 0x0C22
+#endif
+
+namespace {
+
+   // Puntatori alle funzioni caricate a runtime (i GLsync sono trattati come puntatori opachi)
+   using GenObjectsProc = void (APIENTRY*)(GLsizei, GLuint*);
+   using DeleteObjectsProc = void (APIENTRY*)(GLsizei, const GLuint*);
+   using BindObjectProc = void (APIENTRY*)(GLenum, GLuint);
+   using RenderbufferStorageProc = void (APIENTRY*)(GLenum, GLenum, GLsizei, GLsizei);
+   using FramebufferRenderbufferProc = void (APIENTRY*)(GLenum, GLenum, GLenum, GLuint);
+   using CheckFramebufferStatusProc = GLenum (APIENTRY*)(GLenum);
+   using BufferDataProc = void (APIENTRY*)(GLenum, std::ptrdiff_t, const void*, GLenum);
+   using MapBufferProc = void* (APIENTRY*)(GLenum, GLenum);
+   using UnmapBufferProc = GLboolean (APIENTRY*)(GLenum);
+   using FenceSyncProc = void* (APIENTRY*)(GLenum, GLbitfield);
+   using ClientWaitSyncProc = GLenum (APIENTRY*)(void*, GLbitfield, uint64_t);
+   using DeleteSyncProc = void (APIENTRY*)(void*);
+
+   /** @brief Frame dopo i quali la lettura viene raccolta se il fence non e' disponibile. */
+   constexpr int FRAMES_WITHOUT_FENCE = 2;
+
+   void* glutLoader(const char* name) { return reinterpret_cast<void*>(glutGetProcAddress(name)); }
+
+}
+
+struct IdPicker::Reserved {
+   // --- FUNZIONI ---
+   GenObjectsProc genFramebuffers = nullptr;
+   DeleteObjectsProc deleteFramebuffers = nullptr;
+   BindObjectProc bindFramebuffer = nullptr;
+   GenObjectsProc genRenderbuffers = nullptr;
+   DeleteObjectsProc deleteRenderbuffers = nullptr;
+   BindObjectProc bindRenderbuffer = nullptr;
+   RenderbufferStorageProc renderbufferStorage = nullptr;
+   FramebufferRenderbufferProc framebufferRenderbuffer = nullptr;
+   CheckFramebufferStatusProc checkFramebufferStatus = nullptr;
+   GenObjectsProc genBuffers = nullptr;
+   DeleteObjectsProc deleteBuffers = nullptr;
+   BindObjectProc bindBuffer = nullptr;
+   BufferDataProc bufferData = nullptr;
+   MapBufferProc mapBuffer = nullptr;
+   UnmapBufferProc unmapBuffer = nullptr;
+   FenceSyncProc fenceSync = nullptr;
+   ClientWaitSyncProc clientWaitSync = nullptr;
+   DeleteSyncProc deleteSync = nullptr;
+
+   // --- RISORSE ---
+   bool supported = false;
+   GLuint framebuffer = 0;
+   GLuint colorBuffer = 0;
+   GLuint depthBuffer = 0;
+   GLuint pixelBuffer = 0;
+
+   // --- RICHIESTA IN ATTESA DI ESSERE DISEGNATA ---
+   bool requested = false;
+   int requestX = 0;
+   int requestY = 0;
+   Callback requestCallback;
+
+   // --- LETTURA IN CORSO ---
+   bool reading = false;
+   void* fence = nullptr;
+   int framesWaited = 0;
+   Callback readCallback;
+   /** @brief Mesh disegnate nella passata in lettura, per risalire dall'id al nodo. */
+   std::unordered_map<unsigned int, Handle<Node>> drawn;
+
+   // --- RISULTATO IN ATTESA DI CONSEGNA ---
+   bool resultReady = false;
+   /** @brief Nodo colpito, risolto solo alla consegna (puo' essere distrutto nel frattempo). */
+   Handle<Node> resultNode;
+   Callback resultCallback;
+
+   OffscreenContext::ProcLoader loader = glutLoader;
+
+   template <class Proc>
+   bool load(Proc& proc, const char* name) {
+      proc = reinterpret_cast<Proc>(loader(name));
+      return proc != nullptr;
+   }
+
+   bool loadFunctions() {
+      bool ok = load(genFramebuffers, "glGenFramebuffers") && load(deleteFramebuffers, "glDeleteFramebuffers") &&
+                load(bindFramebuffer, "glBindFramebuffer") && load(genRenderbuffers, "glGenRenderbuffers") &&
+                load(deleteRenderbuffers, "glDeleteRenderbuffers") && load(bindRenderbuffer, "glBindRenderbuffer") &&
+                load(renderbufferStorage, "glRenderbufferStorage") &&
+                load(framebufferRenderbuffer, "glFramebufferRenderbuffer") &&
+                load(checkFramebufferStatus, "glCheckFramebufferStatus") && load(genBuffers, "glGenBuffers") &&
+                load(deleteBuffers, "glDeleteBuffers") && load(bindBuffer, "glBindBuffer") &&
+                load(bufferData, "glBufferData") && load(mapBuffer, "glMapBuffer") && load(unmapBuffer, "glUnmapBuffer");
+      // Il fence (OpenGL 3.2) e' facoltativo: senza, la lettura si raccoglie dopo qualche frame
+      if (!load(fenceSync, "glFenceSync") || !load(clientWaitSync, "glClientWaitSync") || !load(deleteSync, "glDeleteSync")) {
+         fenceSync = nullptr;
+         clientWaitSync = nullptr;
+         deleteSync = nullptr;
+      }
+      return ok;
+   }
+
+   /** @brief True se la GPU ha finito di scrivere nel pixel buffer (non si blocca mai). */
+   bool readFinished() {
+      if (fence) {
+         GLenum status = clientWaitSync(fence, 0, 0);
+         return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+      }
+      return ++framesWaited > FRAMES_WITHOUT_FENCE;
+   }
+
+   /** @brief Decodifica la regione letta e la tiene per deliver(). */
+   void collect() {
+      if (fence) {
+         deleteSync(fence);
+         fence = nullptr;
+      }
+
+      unsigned int id = INVALID_ID;
+      bindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+      if (const uint8_t* pixels = static_cast<const uint8_t*>(mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY))) {
+         id = resolveRegion(pixels, REGION_SIZE);
+         unmapBuffer(GL_PIXEL_PACK_BUFFER);
+      }
+      bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+      resultNode.reset();
+      if (id != INVALID_ID) {
+         auto it = drawn.find(id);
+         if (it != drawn.end()) resultNode = it->second;
+      }
+      reading = false;
+      drawn.clear();
+      resultCallback = std::move(readCallback);
+      readCallback = nullptr;
+      resultReady = true;
+   }
+};
+
+IdPicker::IdPicker() : reserved(std::make_unique<Reserved>()) {}
+
+IdPicker::~IdPicker() {}
+
+bool IdPicker::init(OffscreenContext::ProcLoader loader) {
+   Reserved& r = *reserved;
+   if (r.supported) return true;
+   r.loader = loader ? loader : glutLoader;
+   if (!r.loadFunctions()) {
+      std::cout << "[IdPicker] Framebuffer o pixel buffer object non disponibili: picking su GPU disattivato" << std::endl;
+      return false;
+   }
+
+   r.genFramebuffers(1, &r.framebuffer);
+   r.genRenderbuffers(1, &r.colorBuffer);
+   r.genRenderbuffers(1, &r.depthBuffer);
+   r.bindRenderbuffer(GL_RENDERBUFFER, r.colorBuffer);
+   r.renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, REGION_SIZE, REGION_SIZE);
+   r.bindRenderbuffer(GL_RENDERBUFFER, r.depthBuffer);
+   r.renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, REGION_SIZE, REGION_SIZE);
+   r.bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+   GLint previousFramebuffer = 0;
+   glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+   r.bindFramebuffer(GL_FRAMEBUFFER, r.framebuffer);
+   r.framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, r.colorBuffer);
+   r.framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, r.depthBuffer);
+   bool complete = r.checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+   r.bindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+
+   r.genBuffers(1, &r.pixelBuffer);
+   r.bindBuffer(GL_PIXEL_PACK_BUFFER, r.pixelBuffer);
+   r.bufferData(GL_PIXEL_PACK_BUFFER, REGION_SIZE * REGION_SIZE * 4, nullptr, GL_STREAM_READ);
+   r.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+   r.supported = complete;
+   if (!complete) {
+      std::cout << "[IdPicker] Framebuffer incompleto: picking su GPU disattivato" << std::endl;
+      free();
+   }
+   return r.supported;
+}
+
+void IdPicker::free() {
+   Reserved& r = *reserved;
+   if (r.fence) r.deleteSync(r.fence);
+   if (r.framebuffer) r.deleteFramebuffers(1, &r.framebuffer);
+   if (r.colorBuffer) r.deleteRenderbuffers(1, &r.colorBuffer);
+   if (r.depthBuffer) r.deleteRenderbuffers(1, &r.depthBuffer);
+   if (r.pixelBuffer) r.deleteBuffers(1, &r.pixelBuffer);
+   r.fence = nullptr;
+   r.framebuffer = r.colorBuffer = r.depthBuffer = r.pixelBuffer = 0;
+   r.supported = false;
+   r.requested = false;
+   r.reading = false;
+   r.requestCallback = nullptr;
+   r.readCallback = nullptr;
+   r.drawn.clear();
+   r.resultReady = false;
+   r.resultNode.reset();
+   r.resultCallback = nullptr;
+}
+
+bool IdPicker::isSupported() const { return reserved->supported; }
+
+bool IdPicker::request(int x, int y, Callback callback) {
+   Reserved& r = *reserved;
+   if (!r.supported) return false;
+   r.requested = true;
+   r.requestX = x;
+   r.requestY = y;
+   r.requestCallback = std::move(callback);
+   return true;
+}
+
+bool IdPicker::isPending() const { return reserved->requested || reserved->reading || reserved->resultReady; }
+
+void IdPicker::process(List& list, const glm::mat4& projection, const glm::mat4& viewMatrix, int width, int height) {
+   Reserved& r = *reserved;
+   if (!r.supported) return;
+
+   // Un risultato non ancora consegnato non viene sovrascritto: la lettura successiva resta nel pixel buffer
+   if (r.reading && !r.resultReady && r.readFinished()) r.collect();
+   // Una sola lettura alla volta: una nuova richiesta aspetta la fine di quella in corso
+   if (!r.requested || r.reading) return;
+
+   r.requested = false;
+   r.readCallback = std::move(r.requestCallback);
+   r.requestCallback = nullptr;
+
+   // Proiezione ristretta alla regione intorno al pixel (come gluPickMatrix), con la Y dal basso
+   float centerX = r.requestX + 0.5f;
+   float centerY = height - r.requestY - 0.5f;
+   glm::mat4 pickMatrix = glm::translate(glm::mat4(1.0f), glm::vec3((width - 2.0f * centerX) / REGION_SIZE,
+                                                                    (height - 2.0f * centerY) / REGION_SIZE, 0.0f));
+   pickMatrix = glm::scale(pickMatrix, glm::vec3((float)width / REGION_SIZE, (float)height / REGION_SIZE, 1.0f));
+
+   // Stato da ripristinare: la destinazione puo' essere anche un framebuffer fuori schermo
+   GLfloat clearColor[4];
+   glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+   GLint previousFramebuffer = 0;
+   glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+   r.bindFramebuffer(GL_FRAMEBUFFER, r.framebuffer);
+   glViewport(0, 0, REGION_SIZE, REGION_SIZE);
+   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+   StateCache::depthMask(true);
+   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+   // Il colore deve arrivare intatto nel buffer
+   StateCache::disable(GL_LIGHTING);
+   StateCache::disable(GL_TEXTURE_2D);
+   StateCache::disable(GL_BLEND);
+   StateCache::disable(GL_DITHER);
+   StateCache::enable(GL_DEPTH_TEST);
+
+   glMatrixMode(GL_PROJECTION);
+   glLoadMatrixf(glm::value_ptr(pickMatrix * projection));
+   list.renderIds(viewMatrix, r.drawn);
+
+   // Copia asincrona nel pixel buffer: glReadPixels ritorna subito
+   r.bindBuffer(GL_PIXEL_PACK_BUFFER, r.pixelBuffer);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glReadPixels(0, 0, REGION_SIZE, REGION_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+   r.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+   r.fence = r.fenceSync ? r.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+   r.framesWaited = 0;
+   r.reading = true;
+
+   r.bindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+   glViewport(0, 0, width, height);
+   glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+   StateCache::enable(GL_DITHER);
+   glMatrixMode(GL_PROJECTION);
+   glLoadMatrixf(glm::value_ptr(projection));
+}
+
+bool IdPicker::deliver() {
+   Reserved& r = *reserved;
+   if (!r.resultReady) return false;
+   r.resultReady = false;
+   Node* node = r.resultNode.get();
+   r.resultNode.reset();
+
+   // Il callback puo' fare una nuova richiesta: va spostato prima della chiamata
+   Callback callback = std::move(r.resultCallback);
+   r.resultCallback = nullptr;
+   if (callback) callback(node);
+   return true;
+}
+
+glm::u8vec4 IdPicker::encodeId(unsigned int id) {
+   // +1: lo 0 resta allo sfondo. Oltre 2^24 - 1 oggetti creati gli id si ripetono (modulo 2^24 - 1,
+   // cosi' nessun id finisce sul colore dello sfondo)
+   unsigned int value = id % 0xFFFFFFu + 1;
+   return glm::u8vec4(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, 255);
+}
+
+unsigned int IdPicker::decodeId(const uint8_t* rgba) {
+   unsigned int value = rgba[0] | (rgba[1] << 8) | (rgba[2] << 16);
+   return value == 0 ? INVALID_ID : value - 1;
+}
+
+unsigned int IdPicker::resolveRegion(const uint8_t* pixels, int size) {
+   // Pixel centrale, altrimenti il piu' vicino al centro: perdona i click vicino a oggetti sottili
+   int center = size / 2;
+   unsigned int best = INVALID_ID;
+   int bestDistance = size * size * 2;
+   for (int y = 0; y < size; y++) {
+      for (int x = 0; x < size; x++) {
+         unsigned int id = decodeId(pixels + (y * size + x) * 4);
+         int distance = (x - center) * (x - center) + (y - center) * (y - center);
+         if (id != INVALID_ID && distance < bestDistance) {
+            best = id;
+            bestDistance = distance;
+         }
+      }
+   }
+   return best;
+}
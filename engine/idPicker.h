@@ -0,0 +1,127 @@
+/**
+ * @file idPicker.h
+ * @brief Picking su GPU tramite un buffer fuori schermo con l'id di ogni oggetto.
+ */
+#pragma once
+#include "libConfig.h"
+#include "handle.h"
+#include "node.h"
+#include "offscreenContext.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+class List;
+
+/**
+ * @class IdPicker
+ * @brief Legge l'oggetto visibile in un pixel dal colore con cui e' stato disegnato il suo Object::getId().
+ *
+ * Su richiesta, la lista corrente viene ridisegnata in un piccolo framebuffer fuori schermo, restringendo
+ * la proiezione alla regione REGION_SIZE x REGION_SIZE intorno al cursore: il costo di rasterizzazione
+ * non dipende dal numero di triangoli sullo schermo e il risultato e' esatto al pixel. La lettura passa
+ * da un pixel buffer object ed e' asincrona: il risultato viene raccolto in un frame successivo, quando
+ * la GPU ha finito (controllato con un fence, senza attese), quindi il thread di rendering non si blocca.
+ * Disegno e lettura (process()) usano solo la lista; la consegna al callback (deliver()) e' separata,
+ * perche' il callback puo' modificare la scena.
+ *
+ * Il pipeline fixed-function non puo' scrivere su un target intero: l'id (piu' uno, lo 0 e' lo sfondo)
+ * viene codificato nei 24 bit RGB di un target RGBA8, esatto con luci, texture, blending e dithering spenti.
+ *
+ * @note Richiede framebuffer object e pixel buffer object (OpenGL 3.0 o le estensioni ARB); le funzioni
+ * vengono caricate da init(), dopo la creazione della finestra o del contesto fuori schermo.
+ */
+class ENG_API IdPicker {
+public:
+   /** @brief Lato in pixel della regione disegnata e letta intorno al cursore. */
+   static constexpr int REGION_SIZE = 5;
+
+   /** @brief Callback che riceve il nodo colpito (nullptr se sfondo o nodo distrutto nel frattempo). */
+   using Callback = std::function<void(Node* node)>;
+
+   IdPicker();
+   ~IdPicker();
+
+   IdPicker(const IdPicker&) = delete;
+   IdPicker& operator=(const IdPicker&) = delete;
+
+   /**
+    * @brief Carica le funzioni OpenGL e crea framebuffer e pixel buffer (richiede un contesto attivo).
+    * @param loader Caricatore delle funzioni; nullptr usa glutGetProcAddress() (finestra GLUT).
+    * @return True se il picking su GPU e' disponibile.
+    */
+   bool init(OffscreenContext::ProcLoader loader = nullptr);
+
+   /**
+    * @brief Libera le risorse OpenGL (richiede il contesto ancora attivo).
+    */
+   void free();
+
+   /**
+    * @brief Indica se init() e' riuscita.
+    */
+   bool isSupported() const;
+
+   /**
+    * @brief Chiede l'oggetto visibile in un punto della finestra; una nuova richiesta sostituisce quella in attesa.
+    * @param x Coordinata X in pixel (da sinistra).
+    * @param y Coordinata Y in pixel (dall'alto, come negli eventi GLUT).
+    * @param callback Chiamata quando il risultato e' pronto.
+    * @return False se il picking su GPU non e' disponibile.
+    */
+   bool request(int x, int y, Callback callback);
+
+   /**
+    * @brief Indica se ci sono richieste non ancora concluse o risultati non ancora consegnati.
+    */
+   bool isPending() const;
+
+   /**
+    * @brief Da chiamare una volta per frame dopo il disegno della scena: raccoglie le letture concluse
+    * (il risultato resta in attesa di deliver()) e, se c'e' una richiesta in attesa, disegna gli id e
+    * avvia la lettura. Non chiama callback e non accede alla scena oltre alla lista.
+    * @param list Lista di rendering del frame.
+    * @param projection Matrice di proiezione della camera.
+    * @param viewMatrix Matrice di vista della camera.
+    * @param width Larghezza della finestra.
+    * @param height Altezza della finestra.
+    */
+   void process(List& list, const glm::mat4& projection, const glm::mat4& viewMatrix, int width, int height);
+
+   /**
+    * @brief Consegna al callback il risultato raccolto da process(), se c'e'.
+    * @note Il callback puo' modificare la scena: va chiamata quando nessun altro thread la sta leggendo.
+    * @return True se un risultato e' stato consegnato.
+    */
+   bool deliver();
+
+   /**
+    * @brief Codifica un id come colore RGBA8 (alpha sempre 255).
+    *
+    * Nei 24 bit di colore entrano 2^24 - 1 valori: decodeId() restituisce l'id modulo 2^24 - 1,
+    * che e' anche la chiave con cui List::renderIds() registra le mesh disegnate.
+    */
+   static glm::u8vec4 encodeId(unsigned int id);
+
+   /**
+    * @brief Ricava l'id codificato in un colore, o INVALID_ID per lo sfondo.
+    */
+   static unsigned int decodeId(const uint8_t* rgba);
+
+   /**
+    * @brief Sceglie l'id di una regione letta: il pixel centrale o, se e' sfondo, il piu' vicino al centro.
+    * @param pixels Regione RGBA8 di size x size pixel, riga per riga.
+    * @return Id trovato o INVALID_ID.
+    */
+   static unsigned int resolveRegion(const uint8_t* pixels, int size);
+
+   /** @brief Id restituito per lo sfondo. */
+   static constexpr unsigned int INVALID_ID = 0xFFFFFFFFu;
+
+private:
+   /** @brief Risorse e funzioni OpenGL (nascoste agli utenti dell'header). */
+   struct Reserved;
+   std::unique_ptr<Reserved> reserved;
+};
@@ -7,7 +7,7 @@ InfiniteLight::InfiniteLight() : Light()
     setPosition(glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
 }
 
-InfiniteLight::InfiniteLight(const std::string& name, const glm::mat4& matrix,
+InfiniteLight::InfiniteLight(std::string_view name, const glm::mat4& matrix,
     const glm::vec3& ambient, const glm::vec3& diffuse,
     const glm::vec3& specular, const glm::vec3& direction)
     : Light(name, matrix)
@@ -33,9 +33,10 @@ glm::vec3 InfiniteLight::getDirection() const {
     return glm::vec3(pos.x, pos.y, pos.z);
 }
 
-void InfiniteLight::render() {
-    Light::render();
+Light::Parameters InfiniteLight::getParameters() const {
+    Parameters parameters = Light::getParameters();
 
     // Luce direzionale: w=0 nel vettore posizione
-    glLightfv(lightContextID, GL_POSITION, glm::value_ptr(getPosition()));
+    parameters.position = getPosition();
+    return parameters;
 }
\ No newline at end of file
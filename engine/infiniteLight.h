@@ -23,7 +23,7 @@ public:
      * @brief Inizializza una luce infinita specificando le componenti luminose e la direzione.
      * * @param direction Vettore che definisce la direzione di propagazione della luce.
      */
-    InfiniteLight(const std::string& name, const glm::mat4& matrix,
+    InfiniteLight(std::string_view name, const glm::mat4& matrix,
         const glm::vec3& ambient, const glm::vec3& diffuse,
         const glm::vec3& specular, const glm::vec3& direction);
 
@@ -43,7 +43,7 @@ public:
     glm::vec3 getDirection() const;
 
     /**
-     * @brief Esegue il rendering della luce all'interno della scena.
+     * @brief Aggiunge ai parametri comuni quelli specifici di questo tipo di luce.
      */
-    void render() override;
+    Parameters getParameters() const override;
 };
\ No newline at end of file
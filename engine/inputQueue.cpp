@@ -0,0 +1,87 @@
+#include "inputQueue.h"
+#include <cctype>
+
+/**
+ * @file inputQueue.cpp
+ * @brief Implementazione della coda degli eventi di input.
+ */
+
+int InputQueue::fold(unsigned char key) { return std::tolower(key); }
+
+// Indice nello stato: solo i caratteri ignorano maiuscole e minuscole
+int InputQueue::slotOf(Device device, int key) { return device == Device::KEYBOARD ? fold((unsigned char)key) : key; }
+
+bool InputQueue::push(Device device, int key, bool down, int x, int y, bool* state, int size) {
+   int slot = slotOf(device, key);
+   bool tracked = slot >= 0 && slot < size;
+   bool repeat = down && tracked && state[slot];
+
+   // Una ripetizione vale solo se nel frame non c'e' gia' una pressione dello stesso tasto
+   if (repeat) {
+      for (const Event& event : events) {
+         if (event.device == device && slotOf(device, event.key) == slot && event.down) {
+            coalesced++;
+            return false;
+         }
+      }
+   }
+
+   if (tracked) state[slot] = down;
+   Event event;
+   event.device = device;
+   event.key = key;
+   event.down = down;
+   event.repeat = repeat;
+   event.x = x;
+   event.y = y;
+   events.push_back(event);
+   return true;
+}
+
+bool InputQueue::keyboard(unsigned char key, bool down, int x, int y) {
+   mousePosition = glm::ivec2(x, y);
+   return push(Device::KEYBOARD, key, down, x, y, keys, NUM_KEYS);
+}
+
+bool InputQueue::special(int key, bool down, int x, int y) {
+   mousePosition = glm::ivec2(x, y);
+   return push(Device::SPECIAL, key, down, x, y, specials, NUM_KEYS);
+}
+
+void InputQueue::mouse(int button, bool down, int x, int y) {
+   mousePosition = glm::ivec2(x, y);
+   push(Device::MOUSE, button, down, x, y, buttons, NUM_BUTTONS);
+}
+
+const std::vector<InputQueue::Event>& InputQueue::getEvents() const { return events; }
+
+bool InputQueue::isKeyDown(unsigned char key) const { return keys[fold(key)]; }
+
+bool InputQueue::isSpecialDown(int key) const { return key >= 0 && key < NUM_KEYS && specials[key]; }
+
+bool InputQueue::isMouseDown(int button) const { return button >= 0 && button < NUM_BUTTONS && buttons[button]; }
+
+bool InputQueue::wasPressed(Device device, int slot) const {
+   for (const Event& event : events)
+      if (event.device == device && slotOf(device, event.key) == slot && event.down && !event.repeat) return true;
+   return false;
+}
+
+bool InputQueue::wasKeyPressed(unsigned char key) const { return wasPressed(Device::KEYBOARD, fold(key)); }
+
+bool InputQueue::wasSpecialPressed(int key) const { return wasPressed(Device::SPECIAL, key); }
+
+glm::ivec2 InputQueue::getMousePosition() const { return mousePosition; }
+
+unsigned int InputQueue::getCoalescedCount() const { return coalesced; }
+
+void InputQueue::clearEvents() {
+   events.clear();
+   coalesced = 0;
+}
+
+void InputQueue::releaseAll() {
+   for (bool& key : keys) key = false;
+   for (bool& key : specials) key = false;
+   for (bool& button : buttons) button = false;
+}
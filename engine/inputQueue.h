@@ -0,0 +1,133 @@
+/**
+ * @file inputQueue.h
+ * @brief Coda degli eventi di input del frame e stato dei tasti.
+ */
+#pragma once
+#include "libConfig.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @class InputQueue
+ * @brief Raccoglie gli eventi di tastiera e mouse arrivati tra due frame e tiene lo stato dei tasti premuti.
+ *
+ * Il client puo' scorrere gli eventi del frame (getEvents()) oppure interrogare lo stato
+ * (isKeyDown(), wasKeyPressed()) una volta per frame, integrando i movimenti sul tempo trascorso
+ * invece di reagire a ogni ripetizione automatica. Le ripetizioni di un tasto gia' premuto sono
+ * fuse: nel frame resta al piu' un evento di pressione per tasto, le altre vengono solo contate.
+ *
+ * @note Lo stato delle lettere e' tracciato senza distinzione tra maiuscole e minuscole: un tasto
+ * premuto come 'w' e rilasciato come 'W' (Shift premuto nel frattempo) non resta bloccato. Gli
+ * eventi invece conservano il carattere originale.
+ */
+class ENG_API InputQueue {
+public:
+   /** @brief Numero di codici tracciati per tasti e tasti speciali. */
+   static constexpr int NUM_KEYS = 256;
+   /** @brief Numero di pulsanti del mouse tracciati. */
+   static constexpr int NUM_BUTTONS = 8;
+
+   /**
+    * @brief Origine di un evento.
+    */
+   enum class Device {
+      KEYBOARD, ///< Tasto con carattere (codici ASCII).
+      SPECIAL,  ///< Tasto speciale (codici GLUT_KEY_*).
+      MOUSE     ///< Pulsante del mouse (codici GLUT).
+   };
+
+   /**
+    * @struct Event
+    * @brief Pressione o rilascio di un tasto o di un pulsante.
+    */
+   struct Event {
+      Device device = Device::KEYBOARD;
+      /** @brief Carattere (maiuscole comprese), codice del tasto speciale o pulsante del mouse. */
+      int key = 0;
+      bool down = false;
+      /** @brief Pressione di un tasto gia' premuto (ripetizione automatica). */
+      bool repeat = false;
+      int x = 0;
+      int y = 0;
+   };
+
+   /**
+    * @brief Accoda la pressione o il rilascio di un tasto con carattere.
+    * @return False se l'evento e' stato fuso con una ripetizione gia' in coda.
+    */
+   bool keyboard(unsigned char key, bool down, int x, int y);
+
+   /**
+    * @brief Accoda la pressione o il rilascio di un tasto speciale.
+    * @return False se l'evento e' stato fuso con una ripetizione gia' in coda.
+    */
+   bool special(int key, bool down, int x, int y);
+
+   /**
+    * @brief Accoda la pressione o il rilascio di un pulsante del mouse.
+    */
+   void mouse(int button, bool down, int x, int y);
+
+   /**
+    * @brief Eventi arrivati dall'ultimo clearEvents(), in ordine.
+    */
+   const std::vector<Event>& getEvents() const;
+
+   /**
+    * @brief Indica se un tasto con carattere e' premuto.
+    */
+   bool isKeyDown(unsigned char key) const;
+
+   /**
+    * @brief Indica se un tasto speciale e' premuto.
+    */
+   bool isSpecialDown(int key) const;
+
+   /**
+    * @brief Indica se un pulsante del mouse e' premuto.
+    */
+   bool isMouseDown(int button) const;
+
+   /**
+    * @brief Indica se il tasto e' stato premuto (non ripetuto) nel frame, anche se gia' rilasciato.
+    */
+   bool wasKeyPressed(unsigned char key) const;
+
+   /**
+    * @brief Indica se il tasto speciale e' stato premuto (non ripetuto) nel frame, anche se gia' rilasciato.
+    */
+   bool wasSpecialPressed(int key) const;
+
+   /**
+    * @brief Ultima posizione del mouse nota (da un evento), in pixel della finestra.
+    */
+   glm::ivec2 getMousePosition() const;
+
+   /**
+    * @brief Numero di ripetizioni fuse dall'ultimo clearEvents().
+    */
+   unsigned int getCoalescedCount() const;
+
+   /**
+    * @brief Svuota gli eventi del frame; lo stato dei tasti resta.
+    */
+   void clearEvents();
+
+   /**
+    * @brief Considera rilasciati tutti i tasti e i pulsanti (es. finestra che perde il fuoco).
+    */
+   void releaseAll();
+
+private:
+   static int fold(unsigned char key);
+   bool push(Device device, int key, bool down, int x, int y, bool* state, int size);
+   static int slotOf(Device device, int key);
+   bool wasPressed(Device device, int slot) const;
+
+   bool keys[NUM_KEYS] = {};
+   bool specials[NUM_KEYS] = {};
+   bool buttons[NUM_BUTTONS] = {};
+   glm::ivec2 mousePosition = glm::ivec2(0);
+   std::vector<Event> events;
+   unsigned int coalesced = 0;
+};
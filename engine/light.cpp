@@ -1,6 +1,7 @@
 #include "light.h"
 #include <GL/freeglut.h>
 #include <glm/gtc/type_ptr.hpp>
+#include "stateCache.h"
 
 Light::Light() : Node("Light"),
 lightContextID(-1),
@@ -12,7 +13,7 @@ position(0.0f, 0.0f, 0.0f, 1.0f)
 
 }
 
-Light::Light(const std::string& name, const glm::mat4& matrix)
+Light::Light(std::string_view name, const glm::mat4& matrix)
     : Node(name),
     lightContextID(-1),
     ambient(0.0f),
@@ -35,14 +36,38 @@ void Light::setDiffuse(const glm::vec4& v) { diffuse = v; }
 void Light::setSpecular(const glm::vec4& v) { specular = v; }
 void Light::setPosition(const glm::vec4& v) { position = v; }
 
+float Light::getRadius() const { return radius; }
+void Light::setRadius(float value) { radius = value; }
+
 void Light::setLightID(int id) {
     this->lightContextID = id;
 }
 
+Light::Parameters Light::getParameters() const {
+    Parameters parameters;
+    parameters.ambient = ambient;
+    parameters.diffuse = diffuse;
+    parameters.specular = specular;
+    return parameters;
+}
+
+void Light::apply(int lightId, const Parameters& p) {
+    StateCache::enable(lightId);
+    glLightfv(lightId, GL_AMBIENT, glm::value_ptr(p.ambient));
+    glLightfv(lightId, GL_DIFFUSE, glm::value_ptr(p.diffuse));
+    glLightfv(lightId, GL_SPECULAR, glm::value_ptr(p.specular));
+    glLightfv(lightId, GL_POSITION, glm::value_ptr(p.position));
+    glLightfv(lightId, GL_SPOT_DIRECTION, glm::value_ptr(p.spotDirection));
+    glLightf(lightId, GL_SPOT_CUTOFF, p.spotCutoff);
+    glLightf(lightId, GL_SPOT_EXPONENT, p.spotExponent);
+
+    // Attenuazione standard
+    glLightf(lightId, GL_CONSTANT_ATTENUATION, 1.0f);
+    glLightf(lightId, GL_LINEAR_ATTENUATION, 0.0f);
+    glLightf(lightId, GL_QUADRATIC_ATTENUATION, 0.0f);
+}
+
 void Light::render() {
     if (lightContextID < 0) return;
-    glEnable(lightContextID);
-    glLightfv(lightContextID, GL_AMBIENT, glm::value_ptr(ambient));
-    glLightfv(lightContextID, GL_DIFFUSE, glm::value_ptr(diffuse));
-    glLightfv(lightContextID, GL_SPECULAR, glm::value_ptr(specular));
+    apply(lightContextID, getParameters());
 }
\ No newline at end of file
@@ -15,6 +15,28 @@
 class ENG_API Light : public Node
 {
 public:
+   /**
+    * @struct Parameters
+    * @brief Valori inviati alla pipeline fixed-function per configurare uno slot luce.
+    * Posizione e direzione sono nello spazio locale della luce (la ModelView e' gia' caricata).
+    */
+   struct Parameters {
+      /** @brief Componente ambientale. */
+      glm::vec4 ambient{ 0.0f };
+      /** @brief Componente diffusa. */
+      glm::vec4 diffuse{ 1.0f };
+      /** @brief Componente speculare. */
+      glm::vec4 specular{ 1.0f };
+      /** @brief Posizione (w = 1) o direzione (w = 0) della luce. */
+      glm::vec4 position{ 0.0f, 0.0f, 0.0f, 1.0f };
+      /** @brief Direzione del cono (solo spot). */
+      glm::vec3 spotDirection{ 0.0f, 0.0f, -1.0f };
+      /** @brief Apertura del cono in gradi (180 = nessun cono). */
+      float spotCutoff = 180.0f;
+      /** @brief Concentrazione della luce nel cono. */
+      float spotExponent = 0.0f;
+   };
+
    /**
     * @brief Costruttore di default.
     */
@@ -25,7 +47,7 @@ public:
     * @param name Nome del nodo luce.
     * @param matrix Matrice di trasformazione iniziale.
     */
-   Light(const std::string& name, const glm::mat4& matrix);
+   Light(std::string_view name, const glm::mat4& matrix);
 
    /**
     * @brief Distruttore virtuale puro.
@@ -72,12 +94,37 @@ public:
     */
    void setPosition(const glm::vec4& position);
 
+   /**
+    * @brief Restituisce il raggio d'azione della luce (0 = portata illimitata).
+    */
+   float getRadius() const;
+
+   /**
+    * @brief Imposta il raggio d'azione della luce, oltre il quale il suo contributo e' trascurabile.
+    * @param radius Raggio in unita' mondo (0 = portata illimitata).
+    */
+   void setRadius(float radius);
+
    /**
     * @brief Assegna l'identificativo numerico della luce nel contesto grafico (es. GL_LIGHTi).
     * @param id Indice della luce da attivare.
     */
    void setLightID(int id);
 
+   /**
+    * @brief Descrive la configurazione OpenGL della luce; le sottoclassi aggiungono i propri parametri.
+    * @return Parametri da applicare allo slot luce.
+    */
+   virtual Parameters getParameters() const;
+
+   /**
+    * @brief Configura uno slot luce OpenGL con i parametri indicati (tutti, cosi' non restano valori
+    * di una luce precedente nello stesso slot).
+    * @param lightId Slot da configurare (GL_LIGHT0 + i).
+    * @param parameters Parametri della luce.
+    */
+   static void apply(int lightId, const Parameters& parameters);
+
    /**
     * @brief Attiva e configura la luce nella pipeline di rendering.
     */
@@ -94,4 +141,6 @@ protected:
    glm::vec4 position;
    /** @brief ID hardware o del contesto grafico assegnato a questa luce. */
    int lightContextID;
+   /** @brief Raggio d'azione usato per scegliere le luci di ogni oggetto (0 = illimitato). */
+   float radius = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "lightManager.h"
+#include "light.h"
+#include "stateCache.h"
+#include "commandBuffer.h"
+#include <GL/freeglut.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file lightManager.cpp
+ * @brief Implementazione della classe LightManager.
+ */
+
+LightManager::LightManager() : viewMatrix(1.0f) {
+   for (int i = 0; i < MAX_LIGHTS; i++) slots[i] = -1;
+}
+
+void LightManager::begin(const glm::mat4& view, CommandBuffer* buffer) {
+   candidates.clear();
+   viewMatrix = view;
+   rebinds = 0;
+   recorder = buffer;
+
+   // Le luci del passaggio precedente potrebbero non esistere piu': si riparte da slot spenti
+   for (int i = 0; i < MAX_LIGHTS; i++) {
+      StateCache::disable(GL_LIGHT0 + i);
+      if (recorder) recorder->disableLight(i);
+      slots[i] = -1;
+   }
+}
+
+void LightManager::addLight(Light* light, const glm::mat4& worldMatrix) {
+   // Luminanza della luce: a parita' di distanza vince la luce piu' forte
+   const glm::vec3 luma(0.2126f, 0.7152f, 0.0722f);
+   float intensity = glm::dot(glm::vec3(light->getDiffuse() + light->getAmbient()), luma);
+
+   Candidate candidate;
+   candidate.light = light;
+   candidate.worldMatrix = worldMatrix;
+   candidate.worldPosition = glm::vec3(worldMatrix[3]);
+   candidate.radius = light->getRadius();
+   candidate.intensity = intensity;
+   candidate.directional = light->getPosition().w == 0.0f;
+   candidates.push_back(candidate);
+}
+
+void LightManager::select(const BoundingBox& worldBox, std::vector<int>& out) const {
+   scored.clear();
+   for (int i = 0; i < (int)candidates.size(); i++) {
+      const Candidate& c = candidates[i];
+      if (c.directional) {
+         scored.push_back({ std::numeric_limits<float>::max(), i });
+         continue;
+      }
+
+      // Distanza dal punto della scatola piu' vicino alla luce (0 se la luce e' dentro)
+      float distance = 0.0f;
+      if (!worldBox.isEmpty()) {
+         glm::vec3 closest = glm::clamp(c.worldPosition, worldBox.getMin(), worldBox.getMax());
+         distance = glm::length(c.worldPosition - closest);
+      }
+
+      float falloff;
+      if (c.radius > 0.0f) {
+         if (distance >= c.radius) continue;
+         float t = 1.0f - distance / c.radius;
+         falloff = t * t;
+      }
+      else {
+         falloff = 1.0f / (1.0f + distance);
+      }
+      scored.push_back({ c.intensity * falloff, i });
+   }
+
+   if ((int)scored.size() > MAX_LIGHTS) {
+      // A parita' di influenza vince la luce inserita prima
+      std::partial_sort(scored.begin(), scored.begin() + MAX_LIGHTS, scored.end(),
+         [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+         });
+      scored.resize(MAX_LIGHTS);
+   }
+
+   out.clear();
+   for (const auto& entry : scored) out.push_back(entry.second);
+   std::sort(out.begin(), out.end());
+}
+
+void LightManager::bind(const BoundingBox& worldBox) {
+   select(worldBox, selection);
+
+   // Le luci gia' attive e ancora scelte restano nel loro slot
+   bool placed[MAX_LIGHTS] = { false };
+   bool slotKept[MAX_LIGHTS] = { false };
+   for (int s = 0; s < MAX_LIGHTS; s++) {
+      if (slots[s] < 0) continue;
+      for (size_t k = 0; k < selection.size(); k++) {
+         if (selection[k] == slots[s]) {
+            placed[k] = true;
+            slotKept[s] = true;
+            break;
+         }
+      }
+   }
+
+   int freeSlot = 0;
+   for (size_t k = 0; k < selection.size(); k++) {
+      if (placed[k]) continue;
+      while (slotKept[freeSlot]) freeSlot++;
+
+      const Candidate& c = candidates[selection[k]];
+      glm::mat4 modelView = viewMatrix * c.worldMatrix;
+      glMatrixMode(GL_MODELVIEW);
+      glLoadMatrixf(glm::value_ptr(modelView));
+      c.light->setLightID(GL_LIGHT0 + freeSlot);
+      c.light->render();
+      if (recorder) {
+         recorder->loadModelView(modelView);
+         recorder->setLight(freeSlot, c.light->getParameters());
+      }
+
+      slots[freeSlot] = selection[k];
+      slotKept[freeSlot] = true;
+      rebinds++;
+   }
+
+   // Spegne gli slot rimasti senza luce
+   for (int s = 0; s < MAX_LIGHTS; s++) {
+      if (!slotKept[s] && slots[s] >= 0) {
+         StateCache::disable(GL_LIGHT0 + s);
+         if (recorder) recorder->disableLight(s);
+         slots[s] = -1;
+      }
+   }
+}
+
+int LightManager::getNumLights() const { return (int)candidates.size(); }
+
+unsigned int LightManager::getRebindCount() const { return rebinds; }
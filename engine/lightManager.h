@@ -0,0 +1,98 @@
+/**
+ * @file lightManager.h
+ * @brief Scelta delle luci hardware da attivare per ogni oggetto disegnato.
+ */
+#pragma once
+#include "libConfig.h"
+#include "boundingBox.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class Light;
+class CommandBuffer;
+
+/**
+ * @class LightManager
+ * @brief Assegna a ogni oggetto le luci piu' influenti tra quelle della scena, nei limiti degli slot GL_LIGHTi.
+ *
+ * Le luci direzionali hanno sempre la precedenza; quelle puntiformi e spot vengono ordinate per
+ * intensita' attenuata alla distanza dalla scatola dell'oggetto e scartate oltre il proprio raggio.
+ * Gli slot vengono riassegnati solo quando l'insieme scelto cambia rispetto al disegno precedente,
+ * e le luci gia' attive restano nel proprio slot.
+ */
+class ENG_API LightManager {
+public:
+   /** @brief Numero di slot luce disponibili nella pipeline fixed-function. */
+   static constexpr int MAX_LIGHTS = 8;
+
+   /**
+    * @brief Costruttore di default.
+    */
+   LightManager();
+
+   /**
+    * @brief Inizia un nuovo passaggio: dimentica le luci candidate e spegne gli slot in uso.
+    * @param viewMatrix Matrice di vista con cui posizionare le luci.
+    * @param recorder Buffer in cui registrare anche i comandi delle luci (opzionale).
+    */
+   void begin(const glm::mat4& viewMatrix, CommandBuffer* recorder = nullptr);
+
+   /**
+    * @brief Aggiunge una luce candidata al passaggio corrente.
+    * @param light Luce da considerare.
+    * @param worldMatrix Matrice mondo della luce.
+    */
+   void addLight(Light* light, const glm::mat4& worldMatrix);
+
+   /**
+    * @brief Calcola le luci da usare per un oggetto, in ordine di inserimento.
+    * @param worldBox Scatola dell'oggetto nello spazio mondo.
+    * @param selection Indici delle luci candidate scelte (al massimo MAX_LIGHTS).
+    */
+   void select(const BoundingBox& worldBox, std::vector<int>& selection) const;
+
+   /**
+    * @brief Attiva le luci scelte per un oggetto, riconfigurando solo gli slot che cambiano.
+    * @note Modifica la matrice GL_MODELVIEW: va chiamato prima di caricare quella dell'oggetto.
+    * @param worldBox Scatola dell'oggetto nello spazio mondo.
+    */
+   void bind(const BoundingBox& worldBox);
+
+   /**
+    * @brief Restituisce il numero di luci candidate nel passaggio corrente.
+    */
+   int getNumLights() const;
+
+   /**
+    * @brief Restituisce quante volte una luce e' stata caricata in uno slot dall'ultimo begin().
+    */
+   unsigned int getRebindCount() const;
+
+private:
+   /**
+    * @brief Luce candidata con i dati gia' portati nello spazio mondo.
+    */
+   struct Candidate {
+      Light* light;
+      glm::mat4 worldMatrix;
+      glm::vec3 worldPosition;
+      float radius;
+      float intensity;
+      bool directional;
+   };
+
+   /** @brief Luci candidate del passaggio corrente. */
+   std::vector<Candidate> candidates;
+   /** @brief Indice della candidata caricata in ogni slot (-1 = slot spento). */
+   int slots[MAX_LIGHTS];
+   /** @brief Matrice di vista del passaggio corrente. */
+   glm::mat4 viewMatrix;
+   /** @brief Contatore delle luci caricate negli slot. */
+   unsigned int rebinds = 0;
+   /** @brief Buffer di registrazione del passaggio corrente (nullptr = nessuno). */
+   CommandBuffer* recorder = nullptr;
+
+   /** @brief Buffer riutilizzati tra un oggetto e il successivo. */
+   mutable std::vector<std::pair<float, int>> scored;
+   std::vector<int> selection;
+};
@@ -2,116 +2,474 @@
 #include "light.h"
 #include <GL/freeglut.h>
 #include <glm/gtc/type_ptr.hpp>
-#include <iostream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
 #include "mesh.h"
+#include "stateCache.h"
+#include "frustum.h"
+#include "commandBuffer.h"
+#include "idPicker.h"
+#include "profiler.h"
+#include "threadPool.h"
+#include "transformHierarchy.h"
 
 ENG_API List::List() : Object("RenderList") {}
 List::~List() { clear(); }
 
-void List::pass(Node* node, glm::mat4 parentMatrix) {
-   if (!node) return;
-
-   // Calcola matrice mondo
-   glm::mat4 currentWorldMatrix = parentMatrix * node->getM();
-
-   // Aggiungi istanza
+void List::classify(Node* node, const glm::mat4& worldMatrix, Buckets& out) {
    Instance inst;
    inst.node = node;
-   inst.nodeWorldMatrix = currentWorldMatrix;
+   inst.nodeWorldMatrix = worldMatrix;
 
-   // Se  una luce, la mettiamo in testa alla lista per elaborarla prima
-   if (dynamic_cast<Light*>(node) != nullptr)
-      instances.push_front(inst);
+   // Le luci vanno elaborate prima di tutto il resto
+   if (dynamic_cast<Light*>(node) != nullptr) {
+      out.lights.push_back(inst);
+      return;
+   }
+
+   // Se ha un materiale e la trasparenza è < 1.0 (es. scacchiera 0.8) va disegnata per ultima
+   Mesh* mesh = dynamic_cast<Mesh*>(node);
+   if (mesh) inst.worldBox = mesh->getBoundingBox().transformed(worldMatrix);
+   if (mesh && mesh->isReflector())
+      out.reflectors.push_back(inst);
+   if (mesh && mesh->getMaterial() && mesh->getMaterial()->getTransparency() < 1.0f)
+      out.transparent.push_back(inst);
    else
-      instances.push_back(inst);
+      out.opaque.push_back(inst);
+}
+
+void List::collect(Node* node, const glm::mat4& parentMatrix, Buckets& out) {
+   if (!node) return;
+
+   // Calcola matrice mondo
+   glm::mat4 currentWorldMatrix = parentMatrix * node->getM();
+   classify(node, currentWorldMatrix, out);
 
    // Ricorsione
    for (unsigned int i = 0; i < node->getNumChildren(); i++) {
-      pass(node->getChild(i), currentWorldMatrix);
+      collect(node->getChild(i), currentWorldMatrix, out);
    }
 }
 
-void List::render(glm::mat4 viewMatrix) {
-   int lightCounter = 0;
-   const int MAX_HARDWARE_LIGHTS = 8;
-   std::list<Instance> transp;
-
-   // Spegni tutte le luci per sicurezza all'inizio del frame
-   for (int i = 0; i < MAX_HARDWARE_LIGHTS; i++) glDisable(GL_LIGHT0 + i);
-
-   for (auto& inst : instances) {
-      // Calcola ModelView = View * World
-      glm::mat4 modelView = viewMatrix * inst.nodeWorldMatrix;
-      glMatrixMode(GL_MODELVIEW);
-      glLoadMatrixf(glm::value_ptr(modelView));
-
-      // Controllo se  una luce
-      Light* lightNode = dynamic_cast<Light*>(inst.node);
-
-      if (lightNode) {
-         if (lightCounter < MAX_HARDWARE_LIGHTS) {
-            // Assegna slot hardware e renderizza
-            lightNode->setLightID(GL_LIGHT0 + lightCounter);
-            lightNode->render();
-            lightCounter++;
+void List::pass(Node* node, glm::mat4 parentMatrix) {
+   Profiler::Scope scope("Traversal");
+   collect(node, parentMatrix, instances);
+}
+
+void List::passParallel(Node* node, glm::mat4 parentMatrix, unsigned int numThreads) {
+   if (!node) return;
+
+   if (numThreads == 0)
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+   if (numThreads == 1) {
+      pass(node, parentMatrix);
+      return;
+   }
+   Profiler::Scope scope("Traversal");
+
+   // Unita' di lavoro: un nodo singolo (gia' espanso) oppure un intero sottoalbero
+   struct WorkItem {
+      Node* node;
+      glm::mat4 parentMatrix;
+      bool recursive;
+   };
+
+   // Espande i sottoalberi livello per livello finche' non ci sono abbastanza unita'
+   // per bilanciare il carico. L'ordine del vettore resta quello della visita in profondita'.
+   const size_t targetItems = numThreads * 8;
+   std::vector<WorkItem> items{ { node, parentMatrix, true } };
+   bool expanded = true;
+   while (expanded && items.size() < targetItems) {
+      expanded = false;
+      std::vector<WorkItem> next;
+      next.reserve(items.size() * 2);
+      for (const WorkItem& item : items) {
+         if (!item.recursive || item.node->getNumChildren() == 0) {
+            next.push_back(item);
+            continue;
          }
-         else {
-            // Limite superato
-            std::cout << "NUMERO MAX RAGGIUNTO: Luce '" << lightNode->getName() << "' ignorata." << std::endl;
-            lightNode->setLightID(-1); // Disabilita
+         glm::mat4 world = item.parentMatrix * item.node->getM();
+         next.push_back({ item.node, item.parentMatrix, false });
+         for (unsigned int i = 0; i < item.node->getNumChildren(); i++) {
+            Node* child = item.node->getChild(i);
+            if (child) next.push_back({ child, world, true });
          }
+         expanded = true;
       }
-      else {
-         
-         Mesh* mesh = dynamic_cast<Mesh*>(inst.node);
-         if (mesh) {
-            // Se ha un materiale e la trasparenza  < 1.0 (es. scacchiera 0.8)
-            if (mesh->getMaterial() && mesh->getMaterial()->getTransparency() < 1.0f) {
-               transp.push_back(inst);
-            }
-            else {
-               inst.node->render();
+      items.swap(next);
+   }
+
+   // Ogni unita' scrive solo nei propri bucket: nessuna sincronizzazione durante la visita
+   std::vector<Buckets> partial(items.size());
+   std::atomic<size_t> nextItem{ 0 };
+   auto worker = [&]() {
+      Profiler::Scope workerScope("Traversal worker");
+      for (size_t i = nextItem++; i < items.size(); i = nextItem++) {
+         const WorkItem& item = items[i];
+         if (item.recursive)
+            collect(item.node, item.parentMatrix, partial[i]);
+         else
+            classify(item.node, item.parentMatrix * item.node->getM(), partial[i]);
+      }
+   };
+
+   // Thread del pool condiviso, creati una volta e riusati a ogni frame
+   ThreadPool::getShared().run((unsigned int)std::min<size_t>(numThreads, items.size()), worker);
+
+   // Unione deterministica nell'ordine di visita
+   merge(partial);
+}
+
+void List::merge(const std::vector<Buckets>& partial) {
+   for (const Buckets& b : partial) {
+      instances.lights.insert(instances.lights.end(), b.lights.begin(), b.lights.end());
+      instances.opaque.insert(instances.opaque.end(), b.opaque.begin(), b.opaque.end());
+      instances.transparent.insert(instances.transparent.end(), b.transparent.begin(), b.transparent.end());
+      instances.reflectors.insert(instances.reflectors.end(), b.reflectors.begin(), b.reflectors.end());
+   }
+}
+
+void List::classifyRange(const TransformHierarchy& hierarchy, size_t begin, size_t end, Buckets& out) {
+   const std::vector<Node*>& nodes = hierarchy.getNodes();
+   const std::vector<glm::mat4>& world = hierarchy.getWorldMatrices();
+   for (size_t i = begin; i < end; i++)
+      if (nodes[i]) classify(nodes[i], world[i], out);
+}
+
+void List::pass(TransformHierarchy& hierarchy) {
+   Profiler::Scope scope("Traversal");
+   hierarchy.update();
+   classifyRange(hierarchy, 0, hierarchy.getNodes().size(), instances);
+}
+
+void List::passParallel(TransformHierarchy& hierarchy, unsigned int numThreads) {
+   if (numThreads == 0)
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+   hierarchy.update();
+   const size_t count = hierarchy.getNodes().size();
+   numThreads = (unsigned int)std::min<size_t>(numThreads, count / PARALLEL_MIN_NODES);
+   Profiler::Scope scope("Traversal");
+   if (numThreads <= 1) {
+      classifyRange(hierarchy, 0, count, instances);
+      return;
+   }
+
+   // Le matrici sono gia' pronte: basta dividere gli array in blocchi contigui, piu' dei thread
+   // per bilanciare il costo diverso delle voci (luci, mesh, nodi vuoti)
+   const size_t numChunks = (size_t)numThreads * 4;
+   std::vector<Buckets> partial(numChunks);
+   std::atomic<size_t> nextChunk{ 0 };
+   ThreadPool::getShared().run(numThreads, [&]() {
+      Profiler::Scope workerScope("Traversal worker");
+      for (size_t c = nextChunk++; c < numChunks; c = nextChunk++)
+         classifyRange(hierarchy, count * c / numChunks, count * (c + 1) / numChunks, partial[c]);
+   });
+   merge(partial);
+}
+
+/**
+ * @brief Rettangolo di schermo (in pixel) coperto da una scatola nello spazio mondo.
+ * @return False se la scatola non copre alcun pixel; se attraversa il piano della camera
+ * restituisce l'intero viewport.
+ */
+static bool screenRect(const BoundingBox& box, const glm::mat4& viewProjection, const GLint viewport[4], GLint rect[4]) {
+   glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+   for (int i = 0; i < 8; i++) {
+      glm::vec3 corner((i & 1) ? box.getMax().x : box.getMin().x,
+                       (i & 2) ? box.getMax().y : box.getMin().y,
+                       (i & 4) ? box.getMax().z : box.getMin().z);
+      glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+      if (clip.w <= 1e-5f) {
+         ndcMin = glm::vec2(-1.0f);
+         ndcMax = glm::vec2(1.0f);
+         break;
+      }
+      glm::vec2 ndc = glm::vec2(clip) / clip.w;
+      ndcMin = glm::min(ndcMin, ndc);
+      ndcMax = glm::max(ndcMax, ndc);
+   }
+   ndcMin = glm::max(ndcMin, glm::vec2(-1.0f));
+   ndcMax = glm::min(ndcMax, glm::vec2(1.0f));
+   if (ndcMin.x >= ndcMax.x || ndcMin.y >= ndcMax.y) return false;
+
+   GLint x0 = viewport[0] + (GLint)std::floor((ndcMin.x * 0.5f + 0.5f) * viewport[2]);
+   GLint y0 = viewport[1] + (GLint)std::floor((ndcMin.y * 0.5f + 0.5f) * viewport[3]);
+   GLint x1 = viewport[0] + (GLint)std::ceil((ndcMax.x * 0.5f + 0.5f) * viewport[2]);
+   GLint y1 = viewport[1] + (GLint)std::ceil((ndcMax.y * 0.5f + 0.5f) * viewport[3]);
+   rect[0] = x0;
+   rect[1] = y0;
+   rect[2] = x1 - x0;
+   rect[3] = y1 - y0;
+   return rect[2] > 0 && rect[3] > 0;
+}
+
+void List::renderReflections(glm::mat4 viewMatrix, glm::mat4 projectionMatrix, bool stencilClip) {
+   // Margine per gli oggetti appoggiati esattamente sul piano
+   const float PLANE_TOLERANCE = 1e-3f;
+
+   glm::mat4 viewProjection = projectionMatrix * viewMatrix;
+   Frustum viewFrustum(viewProjection);
+   GLint viewport[4] = { 0, 0, 0, 0 };
+   if (stencilClip && !instances.reflectors.empty())
+      glGetIntegerv(GL_VIEWPORT, viewport);
+
+   for (const Instance& reflector : instances.reflectors) {
+      Mesh* mirror = static_cast<Mesh*>(reflector.node);
+
+      // Uno specchio fuori dallo schermo non mostra nulla
+      BoundingBox mirrorBox = mirror->getBoundingBox().transformed(reflector.nodeWorldMatrix);
+      if (!mirrorBox.isEmpty() && !viewFrustum.intersects(mirrorBox)) continue;
+
+      GLint rect[4] = { 0, 0, 0, 0 };
+      if (stencilClip && !mirrorBox.isEmpty() && !screenRect(mirrorBox, viewProjection, viewport, rect)) continue;
+
+      // Piano nello spazio mondo: i piani si trasformano con l'inversa trasposta
+      glm::vec4 plane = glm::transpose(glm::inverse(reflector.nodeWorldMatrix)) * mirror->getReflectionPlane();
+      float len = glm::length(glm::vec3(plane));
+      if (len <= 0.0f) continue;
+      plane /= len;
+      glm::vec3 n(plane);
+
+      // Matrice di riflessione: x' = x - 2 (n.x + d) n
+      glm::mat4 mirrorMatrix(1.0f);
+      for (int col = 0; col < 3; col++)
+         for (int row = 0; row < 3; row++)
+            mirrorMatrix[col][row] -= 2.0f * n[row] * n[col];
+      mirrorMatrix[3] = glm::vec4(-2.0f * plane.w * n, 1.0f);
+
+      // Frustum specchiato: gli oggetti originali vengono testati contro Projection * View * Mirror
+      Frustum mirroredFrustum(projectionMatrix * viewMatrix * mirrorMatrix);
+
+      reflected.lights.clear();
+      reflected.opaque.clear();
+      reflected.transparent.clear();
+
+      for (const Instance& inst : instances.lights) {
+         glm::vec3 pos(inst.nodeWorldMatrix[3]);
+         if (glm::dot(n, pos) + plane.w > 0.0f)
+            reflected.lights.push_back({ inst.node, mirrorMatrix * inst.nodeWorldMatrix, BoundingBox() });
+      }
+
+      auto reflectBucket = [&](const std::vector<Instance>& src, std::vector<Instance>& dst) {
+         for (const Instance& inst : src) {
+            Mesh* mesh = dynamic_cast<Mesh*>(inst.node);
+            if (!mesh || mesh->isReflector()) continue;
+            const BoundingBox& worldBox = inst.worldBox;
+            if (worldBox.isEmpty() || worldBox.minPlaneDistance(plane) < -PLANE_TOLERANCE) continue;
+            if (!mirroredFrustum.intersects(worldBox)) continue;
+            glm::mat4 mirroredMatrix = mirrorMatrix * inst.nodeWorldMatrix;
+            dst.push_back({ inst.node, mirroredMatrix, mesh->getBoundingBox().transformed(mirroredMatrix) });
+         }
+      };
+      {
+         Profiler::Scope cullingScope("Culling");
+         reflectBucket(instances.opaque, reflected.opaque);
+         reflectBucket(instances.transparent, reflected.transparent);
+      }
+
+      if (reflected.lights.empty() && reflected.opaque.empty() && reflected.transparent.empty()) continue;
+
+      if (stencilClip) {
+         // 1. Marca nello stencil i pixel visibili dello specchio, limitando anche la pulizia
+         //    al rettangolo che lo contiene
+         if (!mirrorBox.isEmpty()) {
+            StateCache::enable(GL_SCISSOR_TEST);
+            glScissor(rect[0], rect[1], rect[2], rect[3]);
+            if (recorder) {
+               recorder->enable(GL_SCISSOR_TEST);
+               recorder->scissor(rect[0], rect[1], rect[2], rect[3]);
             }
          }
-         else {
-            
-            inst.node->render();
+         glClearStencil(0);
+         glClear(GL_STENCIL_BUFFER_BIT);
+
+         StateCache::enable(GL_STENCIL_TEST);
+         StateCache::stencilFunc(GL_ALWAYS, 1, 0xFF);
+         StateCache::stencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+         StateCache::colorMask(false);
+         StateCache::depthMask(false);
+
+         glm::mat4 mirrorModelView = viewMatrix * reflector.nodeWorldMatrix;
+         glMatrixMode(GL_MODELVIEW);
+         glLoadMatrixf(glm::value_ptr(mirrorModelView));
+         mirror->renderGeometry();
+
+         if (recorder) {
+            recorder->clearBuffers(GL_STENCIL_BUFFER_BIT);
+            recorder->enable(GL_STENCIL_TEST);
+            recorder->stencilFunc(GL_ALWAYS, 1, 0xFF);
+            recorder->stencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+            recorder->colorMask(false);
+            recorder->depthMask(false);
+            recorder->loadModelView(mirrorModelView);
+            recorder->drawMesh(mirror);
          }
 
-         
+         // 2. La scena specchiata passa solo dove lo stencil vale 1
+         StateCache::colorMask(true);
+         StateCache::depthMask(true);
+         StateCache::stencilFunc(GL_EQUAL, 1, 0xFF);
+         StateCache::stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-         
+         // 3. Scarta cio' che dopo la riflessione sporge sopra il piano (il piano e' in coordinate
+         //    mondo: OpenGL lo porta in coordinate occhio con la modelview corrente)
+         glLoadMatrixf(glm::value_ptr(viewMatrix));
+         GLdouble equation[4] = { -plane.x, -plane.y, -plane.z, -plane.w };
+         glClipPlane(GL_CLIP_PLANE0, equation);
+         StateCache::enable(GL_CLIP_PLANE0);
+
+         if (recorder) {
+            recorder->colorMask(true);
+            recorder->depthMask(true);
+            recorder->stencilFunc(GL_EQUAL, 1, 0xFF);
+            recorder->stencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            recorder->loadModelView(viewMatrix);
+            recorder->clipPlane(0, -plane);
+            recorder->enable(GL_CLIP_PLANE0);
+         }
       }
 
+      // La riflessione inverte l'orientamento dei triangoli
+      StateCache::frontFace(GL_CW);
+      if (recorder) recorder->frontFace(GL_CW);
+      renderBuckets(reflected, viewMatrix);
+      StateCache::frontFace(GL_CCW);
+      if (recorder) recorder->frontFace(GL_CCW);
+
+      if (stencilClip) {
+         StateCache::disable(GL_CLIP_PLANE0);
+         StateCache::disable(GL_STENCIL_TEST);
+         StateCache::disable(GL_SCISSOR_TEST);
+         if (recorder) {
+            recorder->disable(GL_CLIP_PLANE0);
+            recorder->disable(GL_STENCIL_TEST);
+            recorder->disable(GL_SCISSOR_TEST);
+         }
+      }
    }
-   
-   for (auto& inst : transp) {
-      glm::mat4 modelView = viewMatrix * inst.nodeWorldMatrix;
-      glMatrixMode(GL_MODELVIEW);
-      glLoadMatrixf(glm::value_ptr(modelView));
-      glEnable(GL_BLEND);
-      
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glDepthMask(GL_FALSE);
-      glDisable(GL_CULL_FACE); // Renderizza anche il retro delle facce trasparenti
-
-      inst.node->render();
-
-      glEnable(GL_CULL_FACE);
-      glDepthMask(GL_TRUE);
-      glDisable(GL_BLEND);
+}
+
+void List::render(glm::mat4 viewMatrix) {
+   renderBuckets(instances, viewMatrix);
+}
+
+void List::renderCulled(glm::mat4 viewMatrix, glm::mat4 projectionMatrix) {
+   Frustum frustum(projectionMatrix * viewMatrix);
+   auto cullBucket = [&](const std::vector<Instance>& src, std::vector<Instance>& dst) {
+      dst.clear();
+      for (const Instance& inst : src)
+         if (inst.worldBox.isEmpty() || frustum.intersects(inst.worldBox)) dst.push_back(inst);
+   };
+   {
+      Profiler::Scope cullingScope("Culling");
+      culled.lights = instances.lights;
+      cullBucket(instances.opaque, culled.opaque);
+      cullBucket(instances.transparent, culled.transparent);
    }
-   
-   
+   renderBuckets(culled, viewMatrix);
+}
 
+unsigned int List::getLastVisibleCount() const { return (unsigned int)(culled.opaque.size() + culled.transparent.size()); }
 
+unsigned int List::getNumInstances() const { return (unsigned int)(instances.opaque.size() + instances.transparent.size()); }
+
+void List::renderInstance(const Instance& inst, const glm::mat4& viewMatrix) {
+   // Le luci vengono scelte sulla scatola della mesh (o sulla sua origine se e' vuota)
+   Mesh* mesh = dynamic_cast<Mesh*>(inst.node);
+   if (mesh) {
+      BoundingBox worldBox = inst.worldBox;
+      if (worldBox.isEmpty()) {
+         glm::vec3 origin(inst.nodeWorldMatrix[3]);
+         worldBox = BoundingBox(origin, origin);
+      }
+      lightManager.bind(worldBox);
+   }
+
+   glm::mat4 modelView = viewMatrix * inst.nodeWorldMatrix;
+   glMatrixMode(GL_MODELVIEW);
+   glLoadMatrixf(glm::value_ptr(modelView));
+
+   inst.node->render();
+
+   // Una mesh equivale a materiale + geometria (vedi Mesh::render())
+   if (recorder && mesh) {
+      recorder->loadModelView(modelView);
+      recorder->setMaterial(mesh->getMaterial());
+      recorder->drawMesh(mesh);
+   }
 }
 
+void List::renderBuckets(const Buckets& buckets, const glm::mat4& viewMatrix) {
+   // Luci: in ordine inverso di inserimento (come se fossero in testa alla lista),
+   // cosi' a parita' di influenza prevale la stessa luce di prima
+   lightManager.begin(viewMatrix, recorder);
+   for (auto it = buckets.lights.rbegin(); it != buckets.lights.rend(); ++it)
+      lightManager.addLight(static_cast<Light*>(it->node), it->nodeWorldMatrix);
+
+   for (auto& inst : buckets.opaque) renderInstance(inst, viewMatrix);
+
+   if (buckets.transparent.empty()) return;
+
+   // Lo stato per le trasparenze viene impostato una sola volta per tutto il bucket
+   StateCache::enable(GL_BLEND);
+   StateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   StateCache::depthMask(false);
+   StateCache::disable(GL_CULL_FACE); // Renderizza anche il retro delle facce trasparenti
+   if (recorder) {
+      recorder->enable(GL_BLEND);
+      recorder->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      recorder->depthMask(false);
+      recorder->disable(GL_CULL_FACE);
+   }
+
+   for (auto& inst : buckets.transparent) renderInstance(inst, viewMatrix);
+
+   StateCache::enable(GL_CULL_FACE);
+   StateCache::depthMask(true);
+   StateCache::disable(GL_BLEND);
+   if (recorder) {
+      recorder->enable(GL_CULL_FACE);
+      recorder->depthMask(true);
+      recorder->disable(GL_BLEND);
+   }
+}
+
+void List::renderIds(const glm::mat4& viewMatrix, std::unordered_map<unsigned int, Handle<Node>>& drawn) const {
+   glMatrixMode(GL_MODELVIEW);
+   // Anche le trasparenti sono selezionabili: nel buffer degli id vengono disegnate come opache
+   for (const std::vector<Instance>* bucket : { &instances.opaque, &instances.transparent }) {
+      for (const Instance& inst : *bucket) {
+         Mesh* mesh = dynamic_cast<Mesh*>(inst.node);
+         if (!mesh) continue;
+
+         glm::u8vec4 color = IdPicker::encodeId(mesh->getId());
+         glColor4ub(color.r, color.g, color.b, color.a);
+         // Chiave: l'id letto indietro dal colore, non quello completo (oltre 2^24 differiscono)
+         const uint8_t rgba[4] = { color.r, color.g, color.b, color.a };
+         glLoadMatrixf(glm::value_ptr(viewMatrix * inst.nodeWorldMatrix));
+         mesh->renderGeometry();
+         drawn[IdPicker::decodeId(rgba)] = Handle<Node>(mesh);
+      }
+   }
+}
+
+void List::setCommandBuffer(CommandBuffer* buffer) { recorder = buffer; }
+
+CommandBuffer* List::getCommandBuffer() const { return recorder; }
+
 void List::render() {
-   // Fallback: se chiamato senza matrice vista, usa l'identit (nessuna trasformazione camera)
+   // Fallback: se chiamato senza matrice vista, usa l'identità (nessuna trasformazione camera)
    render(glm::mat4(1.0f));
 }
 
 void List::clear() {
-   instances.clear();
-}
\ No newline at end of file
+   instances.lights.clear();
+   instances.opaque.clear();
+   instances.transparent.clear();
+   instances.reflectors.clear();
+   culled.lights.clear();
+   culled.opaque.clear();
+   culled.transparent.clear();
+}
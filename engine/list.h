@@ -5,9 +5,16 @@
 #pragma once
 #include "object.h"
 #include "node.h"
-#include <list>
+#include "lightManager.h"
+#include "handle.h"
+#include "boundingBox.h"
+#include <vector>
+#include <unordered_map>
 #include "libConfig.h"
 
+class CommandBuffer;
+class TransformHierarchy;
+
 /**
 * @class List
 * @brief Gestisce una collezione di nodi grafici da renderizzare in un determinato passaggio.
@@ -31,17 +38,113 @@ public:
 	 */
 	void pass(Node* node, glm::mat4 mat);
 
+	/**
+	 * @brief Variante parallela di pass() pensata per grafi di scena molto grandi.
+	 *
+	 * I sottoalberi vengono suddivisi in unita' di lavoro distribuite dinamicamente tra i thread
+	 * di ThreadPool::getShared(); ogni unita' riempie i propri bucket (luci, opachi, trasparenti)
+	 * che vengono poi uniti nell'ordine di visita. Il risultato e' identico a quello di pass().
+	 * @param node Nodo radice del sottoalbero da visitare.
+	 * @param mat Matrice mondo del genitore del nodo.
+	 * @param numThreads Numero di thread da usare (0 = tutti i core disponibili).
+	 */
+	void passParallel(Node* node, glm::mat4 mat, unsigned int numThreads = 0);
+
+	/**
+	 * @brief Aggiunge tutti i nodi di una gerarchia di trasformazioni, con le sue matrici mondo.
+	 *
+	 * Esegue TransformHierarchy::update() (ricalcolando solo le matrici modificate) e scorre gli
+	 * array in pre-ordine invece di visitare il grafo moltiplicando le matrici: l'ordine delle
+	 * istanze e' lo stesso di pass() sulla radice della gerarchia.
+	 * @param hierarchy Gerarchia da cui leggere nodi e matrici.
+	 */
+	void pass(TransformHierarchy& hierarchy);
+
+	/**
+	 * @brief Variante parallela di pass(TransformHierarchy&): gli array vengono divisi in blocchi
+	 * contigui tra i thread di ThreadPool::getShared() e i bucket uniti nell'ordine dei blocchi.
+	 * Sotto PARALLEL_MIN_NODES nodi per thread la costruzione resta su un solo thread.
+	 * @param hierarchy Gerarchia da cui leggere nodi e matrici.
+	 * @param numThreads Numero di thread da usare (0 = tutti i core disponibili).
+	 */
+	void passParallel(TransformHierarchy& hierarchy, unsigned int numThreads = 0);
+
+	/** @brief Nodi minimi per thread perche' passParallel(TransformHierarchy&) divida il lavoro. */
+	static constexpr unsigned int PARALLEL_MIN_NODES = 2048;
+
 	/**
 	 * @brief Esegue il rendering di tutti gli elementi contenuti nella lista.
 	 * @param viewMatrix Matrice di vista corrente utilizzata per il rendering.
 	 */
 	void render(glm::mat4 viewMatrix);
 
+	/**
+	 * @brief Disegna solo le istanze la cui scatola e' almeno in parte dentro il frustum della vista.
+	 *
+	 * Pensato per disegnare la stessa lista da piu' viste nello stesso frame: le scatole nello spazio
+	 * mondo sono calcolate una volta durante pass() e ogni vista le confronta con il proprio frustum,
+	 * senza visitare di nuovo il grafo di scena. Le luci non vengono scartate (illuminano anche
+	 * oggetti dentro la vista) e neppure i nodi senza geometria.
+	 * @param viewMatrix Matrice di vista.
+	 * @param projectionMatrix Matrice di proiezione della vista.
+	 */
+	void renderCulled(glm::mat4 viewMatrix, glm::mat4 projectionMatrix);
+
+	/**
+	 * @brief Numero di istanze (opache e trasparenti) disegnate dall'ultima renderCulled().
+	 */
+	unsigned int getLastVisibleCount() const;
+
+	/**
+	 * @brief Numero di istanze opache e trasparenti nella lista.
+	 */
+	unsigned int getNumInstances() const;
+
+	/**
+	 * @brief Disegna le riflessioni planari delle mesh riflettenti presenti nella lista.
+	 *
+	 * Per ogni mesh dichiarata con Mesh::setReflectionPlane() le istanze gia' in lista che si trovano
+	 * interamente dal lato della normale vengono ridisegnate moltiplicate per la matrice di
+	 * riflessione, scartando quelle fuori dal frustum specchiato. Non richiede una seconda visita
+	 * del grafo di scena. Va chiamato prima di render().
+	 *
+	 * Con @p stencilClip la mesh specchio viene prima scritta nello stencil buffer e le istanze
+	 * riflesse vengono disegnate solo sui suoi pixel, tagliate da un piano di clipping: il costo di
+	 * riempimento dipende dall'area dello specchio a schermo e non dalla finestra.
+	 * @param viewMatrix Matrice di vista corrente.
+	 * @param projectionMatrix Matrice di proiezione corrente.
+	 * @param stencilClip True per limitare la riflessione all'impronta dello specchio (richiede uno stencil buffer).
+	 */
+	void renderReflections(glm::mat4 viewMatrix, glm::mat4 projectionMatrix, bool stencilClip = false);
+
+	/**
+	 * @brief Attiva la registrazione dei comandi di rendering in un CommandBuffer.
+	 *
+	 * Finche' il buffer e' impostato, render() e renderReflections() continuano a disegnare e in
+	 * piu' accodano al buffer ogni comando inviato, che puo' poi essere riprodotto con
+	 * CommandBuffer::replay() senza visitare il grafo di scena.
+	 * @param buffer Buffer di destinazione (nullptr per disattivare la registrazione).
+	 */
+	void setCommandBuffer(CommandBuffer* buffer);
+
+	/**
+	 * @brief Restituisce il buffer di registrazione corrente (nullptr se disattivata).
+	 */
+	CommandBuffer* getCommandBuffer() const;
+
 	/**
 	 * @brief Implementazione del metodo di rendering generico (ereditato da Object).
 	 */
 	void render() override;
 
+	/**
+	 * @brief Disegna le mesh della lista con un colore piatto che codifica il loro id (vedi IdPicker).
+	 * Materiali e luci sono ignorati; chi chiama imposta proiezione e stato.
+	 * @param viewMatrix Matrice di vista corrente.
+	 * @param drawn Riceve un handle di ogni mesh disegnata, indicizzato dall'id che IdPicker::decodeId() legge dal suo colore.
+	 */
+	void renderIds(const glm::mat4& viewMatrix, std::unordered_map<unsigned int, Handle<Node>>& drawn) const;
+
 	/**
 	 * @brief Rimuove tutti gli elementi presenti nella lista di rendering.
 	 */
@@ -59,10 +162,81 @@ protected:
 
 		/** @brief Matrice di trasformazione dell'oggetto nello spazio mondo. */
 		glm::mat4 nodeWorldMatrix;
+
+		/** @brief Scatola della mesh nello spazio mondo (vuota per gli altri nodi). */
+		BoundingBox worldBox;
+	};
+
+	/**
+	 * @struct Buckets
+	 * @brief Istanze suddivise per categoria di rendering.
+	 */
+	struct Buckets {
+		/** @brief Luci in ordine di visita (vengono elaborate in ordine inverso, come in testa alla lista). */
+		std::vector<Instance> lights;
+		/** @brief Nodi opachi (mesh senza trasparenza e nodi generici). */
+		std::vector<Instance> opaque;
+		/** @brief Mesh trasparenti, disegnate per ultime con il blending attivo. */
+		std::vector<Instance> transparent;
+		/** @brief Mesh riflettenti (presenti anche nel proprio bucket di disegno). */
+		std::vector<Instance> reflectors;
 	};
 
+	/**
+	 * @brief Visita ricorsiva del sottoalbero che accoda le istanze nei bucket indicati.
+	 * @param node Nodo da visitare.
+	 * @param parentMatrix Matrice mondo del genitore.
+	 * @param out Bucket di destinazione.
+	 */
+	static void collect(Node* node, const glm::mat4& parentMatrix, Buckets& out);
+
+	/**
+	 * @brief Inserisce un singolo nodo (senza figli) nel bucket corretto.
+	 * @param node Nodo da inserire.
+	 * @param worldMatrix Matrice mondo gia' calcolata del nodo.
+	 * @param out Bucket di destinazione.
+	 */
+	static void classify(Node* node, const glm::mat4& worldMatrix, Buckets& out);
+
+	/**
+	 * @brief Classifica le voci [begin, end) degli array di una gerarchia gia' aggiornata.
+	 */
+	static void classifyRange(const TransformHierarchy& hierarchy, size_t begin, size_t end, Buckets& out);
+
+	/**
+	 * @brief Accoda ai bucket della lista quelli parziali, nell'ordine dato.
+	 */
+	void merge(const std::vector<Buckets>& partial);
+
+	/**
+	 * @brief Disegna il contenuto di un insieme di bucket: opachi e infine trasparenti.
+	 *
+	 * Le luci del bucket vengono affidate al LightManager, che prima di ogni mesh attiva le
+	 * LightManager::MAX_LIGHTS luci piu' influenti per la sua scatola.
+	 * @param buckets Istanze da disegnare.
+	 * @param viewMatrix Matrice di vista corrente.
+	 */
+	void renderBuckets(const Buckets& buckets, const glm::mat4& viewMatrix);
+
+	/**
+	 * @brief Disegna una singola istanza dopo averle assegnato le luci.
+	 * @param inst Istanza da disegnare.
+	 * @param viewMatrix Matrice di vista corrente.
+	 */
+	void renderInstance(const Instance& inst, const glm::mat4& viewMatrix);
+
 	/** @brief Contenitore interno delle istanze da elaborare. */
-	std::list<Instance> instances;
-};
+	Buckets instances;
 
+	/** @brief Istanze specchiate del passaggio di riflessione (riutilizzate tra i frame). */
+	Buckets reflected;
 
+	/** @brief Istanze visibili dell'ultima renderCulled() (riutilizzate tra le viste). */
+	Buckets culled;
+
+	/** @brief Selezione delle luci per oggetto. */
+	LightManager lightManager;
+
+	/** @brief Buffer in cui registrare i comandi inviati (nullptr = nessuna registrazione). */
+	CommandBuffer* recorder = nullptr;
+};
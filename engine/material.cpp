@@ -1,10 +1,11 @@
 #include "material.h"
 #include <GL/freeglut.h>
 #include <glm/gtc/type_ptr.hpp> // Per glm::value_ptr
+#include "stateCache.h"
 
 
 
-Material::Material(const std::string& name, const glm::vec3& emission, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess, float transparency)
+Material::Material(std::string_view name, const glm::vec3& emission, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess, float transparency)
 	: Object(name), emissione(emission), ambient(ambient), diffuse(diffuse), specular(specular), shininess(shininess), transparency(transparency), texture(nullptr)
 {
 }
@@ -18,7 +19,7 @@ const glm::vec3& Material::getSpecular() const { return specular; }
 const glm::vec3& Material::getEmissione() const { return emissione; }
 float Material::getShininess() const { return shininess; }
 float Material::getTransparency() const { return transparency; }
-Texture* Material::getTexture() { return texture; }
+Texture* Material::getTexture() const { return texture; }
 
 // Setters
 void Material::setAmbient(const glm::vec3& v) { ambient = v; }
@@ -31,22 +32,25 @@ void Material::setTexture(Texture* t) { texture = t; }
 
 void Material::render() {
 	
+	// Un materiale richiede sempre l'illuminazione (una mesh senza materiale la disattiva)
+	StateCache::enable(GL_LIGHTING);
+
 	// Imposta parametri di shading Phong/Blinn-Phong
-	glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, glm::value_ptr(glm::vec4(ambient, transparency)));
-	glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, glm::value_ptr(glm::vec4(diffuse, transparency)));
-	glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, glm::value_ptr(glm::vec4(specular, transparency)));
-	glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, glm::value_ptr(glm::vec4(emissione, transparency)));
-	glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, shininess);
+	StateCache::material(GL_AMBIENT, glm::vec4(ambient, transparency));
+	StateCache::material(GL_DIFFUSE, glm::vec4(diffuse, transparency));
+	StateCache::material(GL_SPECULAR, glm::vec4(specular, transparency));
+	StateCache::material(GL_EMISSION, glm::vec4(emissione, transparency));
+	StateCache::materialShininess(shininess);
 
 	// Gestione Texture
 	if (texture) {
-        glEnable(GL_TEXTURE_2D);
+        StateCache::enable(GL_TEXTURE_2D);
         // Dice a OpenGL: "Moltiplica il colore della texture con il colore (e l'alpha) del materiale"
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE); 
+        StateCache::texEnvMode(GL_MODULATE);
 
         texture->render();
     } else {
-        glDisable(GL_TEXTURE_2D);
+        StateCache::disable(GL_TEXTURE_2D);
     }
 	
 }
\ No newline at end of file
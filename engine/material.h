@@ -24,7 +24,7 @@ public:
 	 * @param shininess Fattore di brillantezza (esponente speculare).
 	 * @param transparency Livello di trasparenza del materiale.
 	 */
-	Material(const std::string& name, const glm::vec3& emission, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess, float transparency);
+	Material(std::string_view name, const glm::vec3& emission, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular, float shininess, float transparency);
 
 	/**
 	 * @brief Distruttore della classe.
@@ -65,7 +65,7 @@ public:
 	/**
 	 * @brief Restituisce il puntatore alla texture associata, se presente.
 	 */
-	Texture* getTexture();
+	Texture* getTexture() const;
 
 	// Setters
 
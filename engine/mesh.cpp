@@ -1,41 +1,87 @@
 #include "mesh.h"
 #include <GL/freeglut.h>
+#include "stateCache.h"
 #include <iostream>
-Mesh::Mesh(const std::string& name)
-    : Node(name) {
+Mesh::Mesh(std::string_view name, std::pmr::memory_resource* resource)
+    : Node(name), all_vertices(resource), all_normals(resource), all_texture_coords(resource), face_vertices(resource),
+      numFaces(0), numVertices(0), material(nullptr), triangleBvh(resource) {
    
 }
 
-Mesh::Mesh(const std::string& name, glm::mat4 matrix, unsigned int faces, unsigned int vertices, Material* material)
-    : Node(name), matrix(matrix), numFaces(faces), numVertices(vertices), material(material) {
+Mesh::Mesh(std::string_view name, glm::mat4 matrix, unsigned int faces, unsigned int vertices, Material* material,
+           std::pmr::memory_resource* resource)
+    : Node(name), all_vertices(resource), all_normals(resource), all_texture_coords(resource), face_vertices(resource),
+      matrix(matrix), numFaces(faces), numVertices(vertices), material(material), triangleBvh(resource) {
    this->setM(matrix);
 
 }
 
-const std::vector<glm::vec3>& Mesh::get_all_vertices() const { return all_vertices; }
-const std::vector<glm::vec3>& Mesh::get_all_normals() const { return all_normals; }
-const std::vector<glm::vec2>& Mesh::get_all_texture_coords() const { return all_texture_coords; }
-const std::vector<std::vector<unsigned int>>& Mesh::get_face_vertices() const { return face_vertices; }
+const std::pmr::vector<glm::vec3>& Mesh::get_all_vertices() const { return all_vertices; }
+const std::pmr::vector<glm::vec3>& Mesh::get_all_normals() const { return all_normals; }
+const std::pmr::vector<glm::vec2>& Mesh::get_all_texture_coords() const { return all_texture_coords; }
+const std::pmr::vector<std::pmr::vector<unsigned int>>& Mesh::get_face_vertices() const { return face_vertices; }
 Material* Mesh::getMaterial() const { return material; }
+const BoundingBox& Mesh::getBoundingBox() const { return boundingBox; }
+const TriangleBvh& Mesh::getTriangleBvh() const {
+    if (triangleBvhDirty) {
+        triangleBvh.build(all_vertices, face_vertices);
+        triangleBvhDirty = false;
+    }
+    return triangleBvh;
+}
+
+bool Mesh::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& distance, unsigned int& face) const {
+    // Raggio nello spazio locale: con una trasformazione affine la distanza lungo il raggio non cambia
+    glm::mat4 toLocal = glm::inverse(getWorldFinalMatrix());
+    glm::vec3 localOrigin = glm::vec3(toLocal * glm::vec4(origin, 1.0f));
+    glm::vec3 localDirection = glm::vec3(toLocal * glm::vec4(direction, 0.0f));
+    return getTriangleBvh().raycast(localOrigin, localDirection, maxDistance, distance, face);
+}
 
-void Mesh::set_all_vertices(const std::vector<glm::vec3>& vertices) { all_vertices = vertices; }
-void Mesh::set_all_normals(const std::vector<glm::vec3>& normals) { all_normals = normals; }
-void Mesh::set_all_texture_coords(const std::vector<glm::vec2>& textureCoords) { all_texture_coords = textureCoords; }
-void Mesh::set_face_vertices(const std::vector<std::vector<unsigned int>>& faces) { face_vertices = faces; }
+bool Mesh::isReflector() const { return reflector; }
+const glm::vec4& Mesh::getReflectionPlane() const { return reflectionPlane; }
+
+void Mesh::set_all_vertices(const std::vector<glm::vec3>& vertices) {
+    all_vertices.assign(vertices.begin(), vertices.end());
+    boundingBox = BoundingBox();
+    for (const auto& v : all_vertices) boundingBox.expand(v);
+    triangleBvhDirty = true;
+}
+void Mesh::set_all_normals(const std::vector<glm::vec3>& normals) { all_normals.assign(normals.begin(), normals.end()); }
+void Mesh::set_all_texture_coords(const std::vector<glm::vec2>& textureCoords) { all_texture_coords.assign(textureCoords.begin(), textureCoords.end()); }
+void Mesh::set_face_vertices(const std::vector<std::vector<unsigned int>>& faces) {
+    // Ogni faccia usa la stessa memoria della mesh (costruzione uses-allocator di std::pmr)
+    face_vertices.clear();
+    face_vertices.reserve(faces.size());
+    for (const auto& face : faces) face_vertices.emplace_back(face.begin(), face.end());
+    triangleBvhDirty = true;
+}
 void Mesh::setMaterial(Material* material) { this->material = material; }
 
+void Mesh::setReflectionPlane(const glm::vec4& plane) {
+    reflectionPlane = plane;
+    reflector = true;
+}
+
+void Mesh::clearReflectionPlane() { reflector = false; }
+
 void Mesh::render() {
     // 1. Applica Materiale
+    // Ogni mesh imposta lo stato che le serve: la cache scarta le chiamate gia' in vigore
     if (material) {
         material->render(); // Attiva luci e setta i coefficienti kA, kD, kS
     }
     else {
-        glDisable(GL_LIGHTING);
-        glDisable(GL_TEXTURE_2D);
+        StateCache::disable(GL_LIGHTING);
+        StateCache::disable(GL_TEXTURE_2D);
         glColor3f(1.0f, 1.0f, 1.0f);
     }
 
     // 2. Disegna Geometria
+    renderGeometry();
+}
+
+void Mesh::renderGeometry() {
     if (!all_vertices.empty() && !face_vertices.empty()) {
         glBegin(GL_TRIANGLES);
 
@@ -60,7 +106,4 @@ void Mesh::render() {
 
         glEnd();
     }
-
-    // 3. Ripristina stato
-    if (!material) glEnable(GL_LIGHTING);
 }
\ No newline at end of file
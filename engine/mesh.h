@@ -5,7 +5,10 @@
 #pragma once
 #include "node.h"
 #include "material.h"
+#include "boundingBox.h"
+#include "triangleBvh.h"
 #include <vector>
+#include <memory_resource>
 #include <glm/glm.hpp>
 #include "libConfig.h"
 
@@ -19,8 +22,9 @@ class ENG_API Mesh : public Node {
 public:
       /**
       * @brief Inizializza una mesh vuota con il nome specificato.
+      * @param resource Memoria da cui allocare vertici e facce (es. l'arena di una Scene).
       */
-    Mesh(const std::string& name);
+    Mesh(std::string_view name, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Inizializza una mesh completa di geometria e materiale.
@@ -28,36 +32,69 @@ public:
      * @param faces Numero totale di facce.
      * @param vertices Numero totale di vertici.
      * @param material Puntatore al materiale da applicare.
+     * @param resource Memoria da cui allocare vertici e facce (es. l'arena di una Scene).
      */
-    Mesh(const std::string& name, glm::mat4 matrix, unsigned int faces, unsigned int vertices, Material* material);
+    Mesh(std::string_view name, glm::mat4 matrix, unsigned int faces, unsigned int vertices, Material* material,
+         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Getters
 
     /**
      * @brief Restituisce l'elenco dei vertici della mesh.
      */
-    const std::vector<glm::vec3>& get_all_vertices() const;
+    const std::pmr::vector<glm::vec3>& get_all_vertices() const;
 
     /**
      * @brief Restituisce l'elenco delle normali calcolate per i vertici.
      */
-    const std::vector<glm::vec3>& get_all_normals() const;
+    const std::pmr::vector<glm::vec3>& get_all_normals() const;
 
     /**
      * @brief Restituisce le coordinate texture (UV) associate ai vertici.
      */
-    const std::vector<glm::vec2>& get_all_texture_coords() const;
+    const std::pmr::vector<glm::vec2>& get_all_texture_coords() const;
 
     /**
      * @brief Restituisce la struttura degli indici che definiscono le facce.
      */
-    const std::vector<std::vector<unsigned int>>& get_face_vertices() const;
+    const std::pmr::vector<std::pmr::vector<unsigned int>>& get_face_vertices() const;
 
     /**
      * @brief Restituisce il puntatore al materiale corrente.
      */
     Material* getMaterial() const;
 
+    /**
+     * @brief Restituisce la scatola di contenimento dei vertici nello spazio locale.
+     */
+    const BoundingBox& getBoundingBox() const;
+
+    /**
+     * @brief Restituisce la BVH dei triangoli nello spazio locale, costruendola alla prima richiesta.
+     */
+    const TriangleBvh& getTriangleBvh() const;
+
+    /**
+     * @brief Interseca un raggio nello spazio mondo con i triangoli della mesh.
+     * @param origin Origine del raggio.
+     * @param direction Direzione del raggio (le distanze sono in multipli della sua lunghezza).
+     * @param maxDistance Distanza massima considerata.
+     * @param distance Distanza del punto colpito.
+     * @param face Indice della faccia colpita.
+     * @return True se un triangolo e' stato colpito entro maxDistance.
+     */
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& distance, unsigned int& face) const;
+
+    /**
+     * @brief Indica se la mesh e' una superficie riflettente (specchio planare).
+     */
+    bool isReflector() const;
+
+    /**
+     * @brief Restituisce il piano di riflessione nello spazio locale della mesh.
+     */
+    const glm::vec4& getReflectionPlane() const;
+
     // Setters
     /**
      * @brief Imposta i vertici che definiscono la geometria della mesh.
@@ -84,18 +121,43 @@ public:
      */
     void setMaterial(Material* material);
 
+    /**
+     * @brief Dichiara la mesh come superficie riflettente.
+     *
+     * Gli oggetti della lista di rendering che si trovano interamente dal lato della normale
+     * vengono ridisegnati specchiati rispetto al piano (vedi List::renderReflections()).
+     * @param plane Piano (a, b, c, d) nello spazio locale della mesh, con a*x + b*y + c*z + d = 0.
+     */
+    void setReflectionPlane(const glm::vec4& plane);
+
+    /**
+     * @brief Rimuove il comportamento riflettente della mesh.
+     */
+    void clearReflectionPlane();
+
     /**
      * @brief Esegue il rendering della geometria.
      */
     void render() override;
 
+    /**
+     * @brief Invia a OpenGL i soli triangoli della mesh, senza toccare materiale e stato.
+     * Usato dai passaggi che scrivono solo depth o stencil.
+     */
+    void renderGeometry();
+
 protected:
-   std::vector<glm::vec3> all_vertices;        /**< Vettore contenente le posizioni di tutti i vertici. */
-   std::vector<glm::vec3> all_normals;         /**< Vettore delle normali per vertice. */
-   std::vector<glm::vec2> all_texture_coords;  /**< Vettore delle coordinate texture UV. */
-   std::vector<std::vector<unsigned int>> face_vertices; /**< Lista di indici che compongono le facce poligonali. */
+   std::pmr::vector<glm::vec3> all_vertices;        /**< Vettore contenente le posizioni di tutti i vertici. */
+   std::pmr::vector<glm::vec3> all_normals;         /**< Vettore delle normali per vertice. */
+   std::pmr::vector<glm::vec2> all_texture_coords;  /**< Vettore delle coordinate texture UV. */
+   std::pmr::vector<std::pmr::vector<unsigned int>> face_vertices; /**< Lista di indici che compongono le facce poligonali. */
    unsigned int numFaces;      /**< Conteggio totale delle facce. */
    unsigned int numVertices;   /**< Conteggio totale dei vertici. */
    Material* material;         /**< Puntatore al materiale associato alla mesh. */
+   BoundingBox boundingBox;    /**< Scatola di contenimento locale, aggiornata da set_all_vertices(). */
+   bool reflector = false;     /**< True se la mesh riflette la scena come uno specchio planare. */
+   glm::vec4 reflectionPlane{ 0.0f, 1.0f, 0.0f, 0.0f }; /**< Piano di riflessione nello spazio locale. */
    glm::mat4 matrix;           /**< Matrice di trasformazione locale specifica della mesh. */
+   mutable TriangleBvh triangleBvh; /**< Gerarchia sui triangoli per il picking, costruita su richiesta. */
+   mutable bool triangleBvhDirty = true; /**< True se vertici o facce sono cambiati dall'ultima costruzione. */
 };
@@ -0,0 +1,121 @@
+#include "nameIndex.h"
+#include "node.h"
+#include <algorithm>
+
+/**
+ * @file nameIndex.cpp
+ * @brief Implementazione della classe NameIndex.
+ */
+
+NameIndex::NameIndex() {}
+
+NameIndex::~NameIndex() { clear(); }
+
+void NameIndex::build(Node* root) {
+   clear();
+   if (root) insertSubtree(root);
+}
+
+void NameIndex::clear() {
+   for (auto& entry : byName)
+      for (Node* node : entry.second) node->nameIndex = nullptr;
+   byName.clear();
+   sortedNames.clear();
+   sortedDirty = false;
+   count = 0;
+}
+
+void NameIndex::insertSubtree(Node* node) {
+   if (node->nameIndex != this) {
+      if (node->nameIndex) node->nameIndex->erase(node);
+
+      std::vector<Node*>& bucket = byName[node->getNameId()];
+      if (bucket.empty()) sortedDirty = true;
+      bucket.push_back(node);
+      node->nameIndex = this;
+      count++;
+   }
+   for (unsigned int i = 0; i < node->getNumChildren(); i++)
+      insertSubtree(node->getChild(i));
+}
+
+void NameIndex::eraseSubtree(Node* node) {
+   if (node->nameIndex == this) erase(node);
+   for (unsigned int i = 0; i < node->getNumChildren(); i++)
+      eraseSubtree(node->getChild(i));
+}
+
+void NameIndex::erase(Node* node) {
+   auto it = byName.find(node->getNameId());
+   if (it != byName.end()) {
+      std::vector<Node*>& bucket = it->second;
+      auto pos = std::find(bucket.begin(), bucket.end(), node);
+      if (pos != bucket.end()) {
+         bucket.erase(pos);
+         count--;
+      }
+      if (bucket.empty()) {
+         byName.erase(it);
+         sortedDirty = true;
+      }
+   }
+   node->nameIndex = nullptr;
+}
+
+const std::vector<Node*>* NameIndex::find(std::string_view name) const {
+   // Un nome mai internato non puo' appartenere ad alcun nodo
+   NameTable::Id id = NameTable::find(name);
+   if (id == NameTable::INVALID) return nullptr;
+   auto it = byName.find(id);
+   return it != byName.end() ? &it->second : nullptr;
+}
+
+void NameIndex::findMatching(std::string_view pattern, std::vector<Node*>& out) const {
+   if (sortedDirty) {
+      sortedNames.clear();
+      sortedNames.reserve(byName.size());
+      for (const auto& entry : byName) sortedNames.push_back(entry.first);
+      std::sort(sortedNames.begin(), sortedNames.end(),
+         [](NameTable::Id a, NameTable::Id b) { return NameTable::view(a) < NameTable::view(b); });
+      sortedDirty = false;
+   }
+
+   // Solo i nomi che iniziano con la parte fissa del pattern possono corrispondere
+   const std::string_view prefix = pattern.substr(0, pattern.find_first_of("*?"));
+   auto first = std::lower_bound(sortedNames.begin(), sortedNames.end(), prefix,
+      [](NameTable::Id id, std::string_view value) { return NameTable::view(id) < value; });
+   for (auto it = first; it != sortedNames.end(); ++it) {
+      const std::string_view name = NameTable::view(*it);
+      if (name.substr(0, prefix.size()) != prefix) break;
+      if (!matches(pattern, name)) continue;
+      const std::vector<Node*>& bucket = byName.find(*it)->second;
+      out.insert(out.end(), bucket.begin(), bucket.end());
+   }
+}
+
+unsigned int NameIndex::getNumNodes() const { return count; }
+
+bool NameIndex::matches(std::string_view pattern, std::string_view name) {
+   // Confronto con backtracking sull'ultimo '*' incontrato
+   size_t p = 0, n = 0;
+   size_t starP = std::string_view::npos, starN = 0;
+   while (n < name.size()) {
+      if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+         p++;
+         n++;
+      }
+      else if (p < pattern.size() && pattern[p] == '*') {
+         starP = p++;
+         starN = n;
+      }
+      else if (starP != std::string_view::npos) {
+         p = starP + 1;
+         n = ++starN;
+      }
+      else {
+         return false;
+      }
+   }
+   while (p < pattern.size() && pattern[p] == '*') p++;
+   return p == pattern.size();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file nameIndex.h
+ * @brief Indice dei nodi di una scena per nome.
+ */
+#pragma once
+#include "libConfig.h"
+#include "nameTable.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Node;
+
+/**
+ * @class NameIndex
+ * @brief Associa a ogni nome i nodi di un sottoalbero che lo portano, per ricerche in tempo costante.
+ *
+ * Viene creato dalla radice della scena con Node::buildNameIndex() (l'importer lo fa al termine del
+ * caricamento) e resta allineato al grafo: Node::addChild() e Node::removeChild() aggiungono e tolgono
+ * interi sottoalberi, mentre un nodo distrutto si rimuove da solo. Lo stesso nome puo' appartenere a
+ * piu' nodi; a parita' di nome l'ordine e' quello di registrazione (pre-ordine per il sottoalbero iniziale).
+ *
+ * Le ricerche per pattern accettano i caratteri jolly '*' (qualsiasi sequenza) e '?' (un carattere):
+ * la parte che precede il primo jolly limita la scansione ai nomi con quel prefisso.
+ */
+class ENG_API NameIndex {
+public:
+   /**
+    * @brief Costruisce un indice vuoto.
+    */
+   NameIndex();
+
+   /**
+    * @brief Distruttore: scollega i nodi ancora registrati.
+    */
+   ~NameIndex();
+
+   NameIndex(const NameIndex&) = delete;
+   NameIndex& operator=(const NameIndex&) = delete;
+
+   /**
+    * @brief Registra tutti i nodi del sottoalbero con radice indicata (sostituendo il contenuto precedente).
+    * @param root Radice del sottoalbero.
+    */
+   void build(Node* root);
+
+   /**
+    * @brief Scollega tutti i nodi e svuota l'indice.
+    */
+   void clear();
+
+   /**
+    * @brief Restituisce i nodi registrati con un nome, in ordine di registrazione.
+    * @param name Nome esatto.
+    * @return Puntatore al vettore dei nodi, o nullptr se il nome non e' presente.
+    */
+   const std::vector<Node*>* find(std::string_view name) const;
+
+   /**
+    * @brief Aggiunge a out i nodi il cui nome soddisfa il pattern, ordinati per nome.
+    * @param pattern Pattern con jolly '*' e '?'.
+    * @param out Vettore a cui accodare i risultati.
+    */
+   void findMatching(std::string_view pattern, std::vector<Node*>& out) const;
+
+   /**
+    * @brief Restituisce il numero di nodi registrati.
+    */
+   unsigned int getNumNodes() const;
+
+   /**
+    * @brief Verifica se un nome soddisfa un pattern con jolly '*' e '?'.
+    */
+   static bool matches(std::string_view pattern, std::string_view name);
+
+private:
+   friend class Node;
+
+   /** @brief Registra un sottoalbero, togliendolo dall'eventuale indice precedente. */
+   void insertSubtree(Node* node);
+   /** @brief Toglie un sottoalbero dall'indice. */
+   void eraseSubtree(Node* node);
+   /** @brief Toglie un singolo nodo dall'indice. */
+   void erase(Node* node);
+
+   /** @brief Nodi registrati per identificativo del nome. */
+   std::unordered_map<NameTable::Id, std::vector<Node*>> byName;
+   /** @brief Nomi presenti in ordine alfabetico, per le ricerche per prefisso (valido se sortedDirty e' false). */
+   mutable std::vector<NameTable::Id> sortedNames;
+   /** @brief True se l'insieme dei nomi e' cambiato dall'ultimo ordinamento. */
+   mutable bool sortedDirty = false;
+   /** @brief Numero di nodi registrati. */
+   unsigned int count = 0;
+};
@@ -0,0 +1,78 @@
+#include "nameTable.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file nameTable.cpp
+ * @brief Implementazione della classe NameTable.
+ */
+
+namespace {
+
+   // Le viste sono raccolte in blocchi di dimensione fissa: un blocco non si sposta mai,
+   // quindi view() puo' leggere senza lock mentre intern() ne aggiunge di nuovi
+   constexpr unsigned int CHUNK_BITS = 10;
+   constexpr unsigned int CHUNK_SIZE = 1u << CHUNK_BITS;
+   constexpr unsigned int MAX_CHUNKS = 4096;
+
+   struct Storage {
+      std::mutex mutex;
+      /** @brief Testo dei nomi: gli elementi di una deque non si spostano quando se ne aggiungono altri. */
+      std::deque<std::string> texts;
+      /** @brief Nome -> identificativo; le chiavi puntano al testo in texts. */
+      std::unordered_map<std::string_view, NameTable::Id> ids;
+      /** @brief Blocchi di viste indicizzati dall'identificativo. */
+      std::atomic<std::string_view*> chunks[MAX_CHUNKS] = {};
+      std::atomic<unsigned int> count{ 0 };
+
+      ~Storage() {
+         for (auto& chunk : chunks) delete[] chunk.load();
+      }
+   };
+
+   Storage& storage() {
+      static Storage instance;
+      return instance;
+   }
+
+}
+
+NameTable::Id NameTable::intern(std::string_view name) {
+   Storage& s = storage();
+   std::lock_guard<std::mutex> lock(s.mutex);
+
+   auto it = s.ids.find(name);
+   if (it != s.ids.end()) return it->second;
+
+   Id id = s.count.load(std::memory_order_relaxed);
+   unsigned int chunk = id >> CHUNK_BITS;
+   if (chunk >= MAX_CHUNKS) return INVALID;
+   if (!s.chunks[chunk].load(std::memory_order_relaxed))
+      s.chunks[chunk].store(new std::string_view[CHUNK_SIZE], std::memory_order_release);
+
+   s.texts.emplace_back(name);
+   std::string_view stored = s.texts.back();
+   s.chunks[chunk].load(std::memory_order_relaxed)[id & (CHUNK_SIZE - 1)] = stored;
+   s.ids.emplace(stored, id);
+   s.count.store(id + 1, std::memory_order_release);
+   return id;
+}
+
+NameTable::Id NameTable::find(std::string_view name) {
+   Storage& s = storage();
+   std::lock_guard<std::mutex> lock(s.mutex);
+   auto it = s.ids.find(name);
+   return it != s.ids.end() ? it->second : INVALID;
+}
+
+std::string_view NameTable::view(Id id) {
+   if (id >= storage().count.load(std::memory_order_acquire)) return std::string_view();
+   return storage().chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+}
+
+unsigned int NameTable::getNumNames() {
+   return storage().count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file nameTable.h
+ * @brief Tabella globale dei nomi internati.
+ */
+#pragma once
+#include "libConfig.h"
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @class NameTable
+ * @brief Conserva una sola copia di ogni nome usato dal motore e lo identifica con un intero.
+ *
+ * Gli oggetti memorizzano solo l'identificativo: due nomi sono uguali se e solo se hanno lo stesso
+ * identificativo, quindi i confronti costano quanto un confronto tra interi. I nomi non vengono
+ * mai rimossi, per cui le string_view restituite restano valide fino alla chiusura del programma.
+ *
+ * @note intern() e find() sono protetti da un mutex; view() non prende lock e puo' essere chiamato
+ * da piu' thread per identificativi gia' restituiti da intern().
+ */
+class ENG_API NameTable {
+public:
+   /** @brief Identificativo di un nome internato. */
+   using Id = uint32_t;
+
+   /** @brief Valore restituito da find() per un nome mai internato. */
+   static constexpr Id INVALID = 0xFFFFFFFFu;
+
+   /**
+    * @brief Restituisce l'identificativo del nome, aggiungendolo alla tabella se non presente.
+    * @param name Nome da internare.
+    */
+   static Id intern(std::string_view name);
+
+   /**
+    * @brief Cerca un nome senza aggiungerlo.
+    * @param name Nome da cercare.
+    * @return Identificativo del nome, o INVALID se nessun oggetto lo ha mai usato.
+    */
+   static Id find(std::string_view name);
+
+   /**
+    * @brief Restituisce il testo associato a un identificativo.
+    * @param id Identificativo restituito da intern().
+    */
+   static std::string_view view(Id id);
+
+   /**
+    * @brief Restituisce il numero di nomi distinti internati.
+    */
+   static unsigned int getNumNames();
+};
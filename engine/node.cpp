@@ -1,39 +1,71 @@
 #include "node.h"
+#include "transformHierarchy.h"
+#include "nameIndex.h"
 #include <algorithm> // Necessario per std::remove
 
-ENG_API Node::Node(const std::string& name)
-   : Object( name), parent(nullptr), transformationMatrix(glm::mat4(1.0f))
+ENG_API Node::Node(std::string_view name)
+   : Object( name), transformationMatrix(glm::mat4(1.0f)), parent(nullptr), worldMatrix(glm::mat4(1.0f))
 {
 }
 
+ENG_API Node::~Node() {
+   if (hierarchy) hierarchy->detachNode(this);
+   if (nameIndex) nameIndex->erase(this);
+   delete ownedNameIndex;
+}
+
 glm::mat4 Node::getM() const {
    return transformationMatrix;
 }
 
 void Node::setM(const glm::mat4& newMatrix) {
    transformationMatrix = newMatrix;
+   markWorldDirty();
 }
 
 // Trasformazioni (aggiornano la matrice locale)
 void Node::rotate(float angle, const glm::vec3& axis) {
    transformationMatrix = glm::rotate(transformationMatrix, glm::radians(angle), axis);
+   markWorldDirty();
 }
 
 void Node::scale(const glm::vec3& factor) {
    transformationMatrix = glm::scale(transformationMatrix, factor);
+   markWorldDirty();
 }
 
 void Node::translate(const glm::vec3& translation) {
    transformationMatrix = glm::translate(transformationMatrix, translation);
+   markWorldDirty();
 }
 
-// Calcolo ricorsivo della matrice mondo (World Matrix)
+void Node::markWorldDirty() {
+   if (hierarchy) {
+      // La gerarchia propaga la modifica ai discendenti collegati durante update()
+      hierarchy->setLocal(transformIndex, transformationMatrix);
+      for (Node* child : children)
+         if (!child->hierarchy) child->markWorldDirty();
+      return;
+   }
+   // Un nodo gia' sporco ha gia' tutti i discendenti sporchi: la propagazione si ferma qui
+   if (worldDirty) return;
+   worldDirty = true;
+   for (Node* child : children) child->markWorldDirty();
+}
+
+// Matrice mondo (World Matrix): ricalcolata solo lungo il tratto di catena invalidato
 glm::mat4 Node::getWorldFinalMatrix() const {
-   if (parent) {
+   if (hierarchy) {
+      // update() puo' ricostruire gli array (e scollegare il nodo): l'indice va letto dopo
+      hierarchy->update();
+      if (hierarchy) return hierarchy->worldAt(transformIndex);
+   }
+   if (worldDirty) {
       // Moltiplica la matrice del genitore per quella locale
-      return parent->getWorldFinalMatrix() * transformationMatrix;
+      worldMatrix = parent ? parent->getWorldFinalMatrix() * transformationMatrix : transformationMatrix;
+      worldDirty = false;
    }
-   return transformationMatrix;
+   return worldMatrix;
 }
 
 void Node::render() {
@@ -44,12 +76,19 @@ void Node::render() {
 
 Node* Node::getParent() const { return parent; }
 
-void Node::setParent(Node* newParent) { parent = newParent; }
+void Node::setParent(Node* newParent) {
+   parent = newParent;
+   // Per la radice della gerarchia il genitore e' esterno: cambia solo la matrice mondo
+   if (hierarchy && hierarchy->getRoot() != this) hierarchy->invalidateStructure();
+   markWorldDirty();
+}
 
 void Node::addChild(Node* child) {
    if (child) {
       child->setParent(this);
       children.push_back(child);
+      if (hierarchy) hierarchy->invalidateStructure();
+      if (nameIndex) nameIndex->insertSubtree(child);
    }
 }
 
@@ -59,6 +98,12 @@ void Node::removeChild(Node* child) {
    if (it != children.end()) {
       child->setParent(nullptr);
       children.erase(it, children.end());
+      if (hierarchy) hierarchy->invalidateStructure();
+      if (nameIndex && child->nameIndex == nameIndex) {
+         nameIndex->eraseSubtree(child);
+         // Una scena importata con il proprio indice lo ritrova quando viene staccata
+         if (child->ownedNameIndex) child->ownedNameIndex->insertSubtree(child);
+      }
    }
 }
 
@@ -72,13 +117,84 @@ unsigned int Node::getNumChildren() const {
    return (unsigned int)children.size();
 }
 
-// Ricerca ricorsiva per nome
-Node* Node::findByName(const std::string& nodeName) {
-   if (this->name == nodeName) return this;
+bool Node::isInSubtree(const Node* node) const {
+   for (; node; node = node->parent)
+      if (node == this) return true;
+   return false;
+}
+
+// Ricerca per nome: tramite l'indice se presente, altrimenti ricorsiva
+Node* Node::findByName(std::string_view nodeName) {
+   if (nameIndex) {
+      const std::vector<Node*>* matches = nameIndex->find(nodeName);
+      if (matches)
+         for (Node* node : *matches)
+            if (isInSubtree(node)) return node;
+      return nullptr;
+   }
+
+   // Senza indice: il nome viene risolto una volta sola, poi si confrontano identificativi
+   NameTable::Id id = NameTable::find(nodeName);
+   return id != NameTable::INVALID ? findById(id) : nullptr;
+}
+
+Node* Node::findById(NameTable::Id id) {
+   if (this->nameId == id) return this;
 
    for (auto* child : children) {
-      Node* res = child->findByName(nodeName);
+      Node* res = child->findById(id);
       if (res) return res;
    }
    return nullptr;
-}
\ No newline at end of file
+}
+
+std::vector<Node*> Node::findAllByName(std::string_view nodeName) {
+   std::vector<Node*> result;
+   if (nameIndex) {
+      const std::vector<Node*>* matches = nameIndex->find(nodeName);
+      if (matches)
+         for (Node* node : *matches)
+            if (isInSubtree(node)) result.push_back(node);
+      return result;
+   }
+
+   NameTable::Id id = NameTable::find(nodeName);
+   if (id == NameTable::INVALID) return result;
+   std::vector<Node*> stack{ this };
+   while (!stack.empty()) {
+      Node* node = stack.back();
+      stack.pop_back();
+      if (node->nameId == id) result.push_back(node);
+      for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) stack.push_back(*it);
+   }
+   return result;
+}
+
+std::vector<Node*> Node::findMatching(std::string_view pattern) {
+   std::vector<Node*> result;
+   if (nameIndex) {
+      std::vector<Node*> matches;
+      nameIndex->findMatching(pattern, matches);
+      for (Node* node : matches)
+         if (isInSubtree(node)) result.push_back(node);
+      return result;
+   }
+
+   // Senza indice: visita in pre-ordine, poi stesso ordinamento per nome della versione indicizzata
+   std::vector<Node*> stack{ this };
+   while (!stack.empty()) {
+      Node* node = stack.back();
+      stack.pop_back();
+      if (NameIndex::matches(pattern, node->getName())) result.push_back(node);
+      for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) stack.push_back(*it);
+   }
+   std::stable_sort(result.begin(), result.end(), [](const Node* a, const Node* b) { return a->getName() < b->getName(); });
+   return result;
+}
+
+void Node::buildNameIndex() {
+   if (!ownedNameIndex) ownedNameIndex = new NameIndex();
+   ownedNameIndex->build(this);
+}
+
+NameIndex* Node::getNameIndex() const { return nameIndex; }
@@ -9,6 +9,9 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "libConfig.h"
 
+class TransformHierarchy;
+class NameIndex;
+
 /**
  * @brief Rappresenta un nodo nel grafo della scena, gestisce trasformazioni e gerarchia.
  */
@@ -19,12 +22,12 @@ public:
    * @class Node
    * @brief Rappresenta un nodo nel grafo della scena, gestendo le trasformazioni locali e la gerarchia padre-figlio.
    */
-   Node(const std::string& name);
+   Node(std::string_view name);
 
    /**
-   * @brief Distruttore virtuale di default.
+   * @brief Distruttore virtuale: se il nodo e' collegato a una TransformHierarchy o a un NameIndex, ne viene rimosso.
    */
-   virtual ~Node() = default;
+   virtual ~Node();
 
    // Transformation matrix accessors
 
@@ -63,6 +66,10 @@ public:
    // World matrix computation
    /**
      * @brief Calcola la matrice di trasformazione globale moltiplicando la matrice locale con quelle dei nodi genitori.
+     * Il risultato resta in cache finche' non cambia la trasformazione locale del nodo, di un suo antenato
+     * o il genitore: se nulla si e' mosso la chiamata costa O(1). Se il nodo e' collegato a una
+     * TransformHierarchy la matrice viene letta dagli array della gerarchia, aggiornati in blocco.
+     * @note La cache viene aggiornata anche da questo metodo const: non chiamarlo da piu' thread su nodi modificati.
      * @return Matrice che rappresenta la trasformazione del nodo nello spazio mondo (World Space).
      */
    glm::mat4 getWorldFinalMatrix() const;
@@ -110,10 +117,35 @@ public:
 
    // Tree search
    /**
-     * @brief Cerca ricorsivamente un nodo nella gerarchia tramite il suo nome.
+     * @brief Cerca un nodo nel sottoalbero tramite il suo nome.
+     * Se il nodo appartiene a un NameIndex la ricerca costa O(1) (piu' la verifica degli omonimi),
+     * altrimenti visita ricorsivamente i figli.
      * @return Puntatore al nodo trovato o nullptr se non esiste.
      */
-   Node* findByName(const std::string& nodeName);
+   Node* findByName(std::string_view nodeName);
+
+   /**
+     * @brief Restituisce tutti i nodi del sottoalbero con il nome indicato.
+     * @param nodeName Nome esatto.
+     */
+   std::vector<Node*> findAllByName(std::string_view nodeName);
+
+   /**
+     * @brief Restituisce i nodi del sottoalbero il cui nome soddisfa un pattern (es. "Disco*"), ordinati per nome.
+     * @param pattern Pattern con jolly '*' (qualsiasi sequenza) e '?' (un carattere).
+     */
+   std::vector<Node*> findMatching(std::string_view pattern);
+
+   /**
+     * @brief Crea (o ricostruisce) l'indice dei nomi del sottoalbero che ha questo nodo come radice.
+     * L'indice appartiene al nodo e viene distrutto con esso.
+     */
+   void buildNameIndex();
+
+   /**
+     * @brief Restituisce l'indice dei nomi a cui il nodo appartiene (nullptr se nessuno).
+     */
+   NameIndex* getNameIndex() const;
 
 private:
    /** @brief Matrice che definisce le trasformazioni geometriche locali rispetto al padre. */
@@ -122,4 +154,36 @@ private:
    std::vector<Node*> children;
    /** @brief Riferimento al nodo genitore nella struttura gerarchica. */
    Node* parent;
+
+   /** @brief Ultima matrice mondo calcolata (valida se worldDirty e' false). */
+   mutable glm::mat4 worldMatrix;
+   /** @brief True se la matrice mondo va ricalcolata. Se un nodo e' sporco lo sono anche tutti i suoi discendenti. */
+   mutable bool worldDirty = true;
+
+   friend class TransformHierarchy;
+   /** @brief Gerarchia piatta a cui il nodo e' collegato (nullptr = matrice mondo gestita dal nodo). */
+   TransformHierarchy* hierarchy = nullptr;
+   /** @brief Indice del nodo negli array della gerarchia. */
+   int transformIndex = -1;
+
+   friend class NameIndex;
+   /** @brief Indice dei nomi in cui il nodo e' registrato. */
+   NameIndex* nameIndex = nullptr;
+   /** @brief Indice creato da buildNameIndex() e posseduto dal nodo. */
+   NameIndex* ownedNameIndex = nullptr;
+
+   /**
+    * @brief Verifica se un nodo appartiene al sottoalbero di questo nodo (incluso il nodo stesso).
+    */
+   bool isInSubtree(const Node* node) const;
+
+   /**
+    * @brief Ricerca ricorsiva (pre-ordine) del primo nodo con il nome indicato.
+    */
+   Node* findById(NameTable::Id id);
+
+   /**
+    * @brief Invalida la matrice mondo del nodo e dei suoi discendenti.
+    */
+   void markWorldDirty();
 };
\ No newline at end of file
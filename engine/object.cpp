@@ -1,17 +1,41 @@
 #include "object.h"
+#include "objectRegistry.h"
 
 // Inizializzazione
 std::atomic<unsigned int> Object::nextId{0};
 
-ENG_API Object::Object(const std::string& name)
-   : name(name)
+ENG_API Object::Object(std::string_view name)
+   : nameId(NameTable::intern(name)), handleIndex(ObjectRegistry::add(this))
 {
    // Assegna il valore corrente e poi lo incrementa per il prossimo oggetto
    this->uid = nextId++;
 }
 
-std::string Object::getName() const {
-   return this->name;
+ENG_API Object::Object(const Object& other)
+   : nameId(other.nameId), handleIndex(ObjectRegistry::add(this))
+{
+   this->uid = nextId++;
+}
+
+Object& Object::operator=(const Object& other) {
+   nameId = other.nameId;
+   return *this;
+}
+
+ENG_API Object::~Object() {
+   ObjectRegistry::remove(handleIndex);
+}
+
+uint32_t Object::getHandleIndex() const {
+   return this->handleIndex;
+}
+
+std::string_view Object::getName() const {
+   return NameTable::view(this->nameId);
+}
+
+NameTable::Id Object::getNameId() const {
+   return this->nameId;
 }
 
 unsigned int Object::getId() const {
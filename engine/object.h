@@ -5,9 +5,12 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <memory>
 #include <atomic>
 #include "libConfig.h"
+#include "nameTable.h"
+#include <cstdint>
 
  /**
   * @class Object
@@ -23,7 +26,17 @@ public:
     * @brief Costruttore che inizializza l'oggetto con un nome e gli assegna un ID univoco.
     * @param name Nome identificativo da assegnare all'oggetto.
     */
-   Object(const std::string& name);
+   Object(std::string_view name);
+
+   /**
+    * @brief Costruttore di copia: la copia e' un oggetto distinto, con un proprio ID e un proprio slot nell'ObjectRegistry.
+    */
+   Object(const Object& other);
+
+   /**
+    * @brief Assegnamento: copia il nome, mantenendo ID e slot dell'oggetto di destinazione.
+    */
+   Object& operator=(const Object& other);
 
    /**
     * @brief Metodo puramente virtuale per il rendering dell'oggetto.
@@ -32,9 +45,15 @@ public:
    virtual void render() = 0;
 
    /**
-    * @brief Restituisce il nome assegnato all'oggetto.
+    * @brief Restituisce il nome assegnato all'oggetto, senza copiarlo.
+    * La vista punta alla NameTable e resta valida per tutta la durata del programma.
     */
-   virtual std::string getName() const;
+   virtual std::string_view getName() const;
+
+   /**
+    * @brief Restituisce l'identificativo del nome nella NameTable: nomi uguali hanno lo stesso identificativo.
+    */
+   NameTable::Id getNameId() const;
 
    /**
     * @brief Restituisce l'identificativo numerico univoco dell'oggetto.
@@ -42,13 +61,20 @@ public:
    virtual unsigned int getId() const;
 
    /**
-    * @brief Distruttore virtuale di default.
+    * @brief Restituisce lo slot dell'oggetto nell'ObjectRegistry (usato da Handle).
+    */
+   uint32_t getHandleIndex() const;
+
+   /**
+    * @brief Distruttore virtuale: libera lo slot nell'ObjectRegistry, invalidando gli Handle verso l'oggetto.
     */
-   virtual ~Object() = default;
+   virtual ~Object();
 
 protected:
    /** @brief Identificativo numerico univoco dell'istanza. */
    unsigned int uid;
-   /** @brief Nome identificativo dell'oggetto. */
-   std::string name;
+   /** @brief Nome identificativo dell'oggetto, internato nella NameTable. */
+   NameTable::Id nameId;
+   /** @brief Slot nell'ObjectRegistry. */
+   uint32_t handleIndex;
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "objectRegistry.h"
+
+/**
+ * @file objectRegistry.cpp
+ * @brief Implementazione della classe ObjectRegistry.
+ */
+
+namespace {
+
+   struct Slot {
+      /** @brief Oggetto nello slot (nullptr se libero). */
+      Object* object;
+      /** @brief Incrementata a ogni liberazione dello slot. */
+      uint32_t generation;
+      /** @brief Posizione nell'array denso se occupato, prossimo slot libero altrimenti. */
+      uint32_t link;
+   };
+
+   struct Storage {
+      std::vector<Slot> slots;
+      std::vector<Object*> dense;
+      std::vector<uint32_t> denseSlot;
+      uint32_t freeHead = ObjectRegistry::INVALID_INDEX;
+   };
+
+   Storage& storage() {
+      // Mai distrutto: gli oggetti globali possono morire dopo la fine del main
+      static Storage* instance = new Storage();
+      return *instance;
+   }
+
+}
+
+uint32_t ObjectRegistry::add(Object* object) {
+   Storage& s = storage();
+   uint32_t index;
+   if (s.freeHead != INVALID_INDEX) {
+      index = s.freeHead;
+      s.freeHead = s.slots[index].link;
+   }
+   else {
+      index = (uint32_t)s.slots.size();
+      s.slots.push_back({ nullptr, 1, INVALID_INDEX });
+   }
+
+   Slot& slot = s.slots[index];
+   slot.object = object;
+   slot.link = (uint32_t)s.dense.size();
+   s.dense.push_back(object);
+   s.denseSlot.push_back(index);
+   return index;
+}
+
+void ObjectRegistry::remove(uint32_t index) {
+   Storage& s = storage();
+   if (index >= s.slots.size() || !s.slots[index].object) return;
+   Slot& slot = s.slots[index];
+
+   // Rimozione dall'array denso spostando l'ultimo elemento nel buco
+   uint32_t denseIndex = slot.link;
+   uint32_t lastSlot = s.denseSlot.back();
+   s.dense[denseIndex] = s.dense.back();
+   s.denseSlot[denseIndex] = lastSlot;
+   s.slots[lastSlot].link = denseIndex;
+   s.dense.pop_back();
+   s.denseSlot.pop_back();
+
+   slot.object = nullptr;
+   // La generazione 0 non viene mai assegnata: un handle di default non puo' risolversi
+   if (++slot.generation == 0) slot.generation = 1;
+   slot.link = s.freeHead;
+   s.freeHead = index;
+}
+
+Object* ObjectRegistry::resolve(uint32_t index, uint32_t generation) {
+   Storage& s = storage();
+   if (index >= s.slots.size()) return nullptr;
+   const Slot& slot = s.slots[index];
+   return slot.generation == generation ? slot.object : nullptr;
+}
+
+uint32_t ObjectRegistry::getGeneration(uint32_t index) {
+   Storage& s = storage();
+   return index < s.slots.size() ? s.slots[index].generation : 0;
+}
+
+const std::vector<Object*>& ObjectRegistry::getObjects() { return storage().dense; }
+
+unsigned int ObjectRegistry::getNumObjects() { return (unsigned int)storage().dense.size(); }
@@ -0,0 +1,57 @@
+/**
+ * @file objectRegistry.h
+ * @brief Slot map di tutti gli oggetti vivi del motore.
+ */
+#pragma once
+#include "libConfig.h"
+#include <cstdint>
+#include <vector>
+
+class Object;
+
+/**
+ * @class ObjectRegistry
+ * @brief Assegna a ogni Object uno slot con un contatore di generazione, su cui si basano gli Handle.
+ *
+ * Ogni oggetto si registra alla costruzione e si rimuove alla distruzione; uno slot liberato viene
+ * riutilizzato con una generazione diversa, quindi un handle verso un oggetto distrutto viene
+ * riconosciuto confrontando la generazione, in tempo costante. Gli oggetti vivi sono tenuti anche
+ * in un array denso, per poterli scorrere senza buchi.
+ *
+ * @note Non thread-safe: gli oggetti vanno creati e distrutti dal thread che usa gli handle.
+ */
+class ENG_API ObjectRegistry {
+public:
+   /** @brief Indice di slot non valido. */
+   static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+   /**
+    * @brief Restituisce l'oggetto nello slot se la generazione coincide, altrimenti nullptr.
+    * @param index Indice dello slot.
+    * @param generation Generazione attesa.
+    */
+   static Object* resolve(uint32_t index, uint32_t generation);
+
+   /**
+    * @brief Restituisce la generazione corrente di uno slot.
+    */
+   static uint32_t getGeneration(uint32_t index);
+
+   /**
+    * @brief Restituisce gli oggetti vivi in un array denso (l'ordine cambia quando un oggetto viene distrutto).
+    */
+   static const std::vector<Object*>& getObjects();
+
+   /**
+    * @brief Restituisce il numero di oggetti vivi.
+    */
+   static unsigned int getNumObjects();
+
+private:
+   friend class Object;
+
+   /** @brief Registra un oggetto e restituisce il suo slot. */
+   static uint32_t add(Object* object);
+   /** @brief Libera lo slot di un oggetto distrutto, invalidandone gli handle. */
+   static void remove(uint32_t index);
+};
@@ -0,0 +1,232 @@
+#include "offscreenContext.h"
+#include "FreeImage.h"
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#endif
+
+/**
+ * @file offscreenContext.cpp
+ * @brief Implementazione della classe OffscreenContext.
+ */
+
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_DEPTH_STENCIL_ATTACHMENT
+#define GL_DEPTH_STENCIL_ATTACHMENT 0x821A
+#endif
+#ifndef GL_DEPTH24_STENCIL8
+#define GL_DEPTH24_STENCIL8 0x88F0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_BGR
+#define GL_BGR 0x80E0
+#endif
+
+namespace {
+
+   using GenObjectsProc = void (APIENTRY*)(GLsizei, GLuint*);
+   using DeleteObjectsProc = void (APIENTRY*)(GLsizei, const GLuint*);
+   using BindObjectProc = void (APIENTRY*)(GLenum, GLuint);
+   using RenderbufferStorageProc = void (APIENTRY*)(GLenum, GLenum, GLsizei, GLsizei);
+   using FramebufferRenderbufferProc = void (APIENTRY*)(GLenum, GLenum, GLenum, GLuint);
+   using CheckFramebufferStatusProc = GLenum (APIENTRY*)(GLenum);
+
+   template <class Proc>
+   bool load(Proc& proc, const char* name) {
+      proc = reinterpret_cast<Proc>(OffscreenContext::getProcLoader()(name));
+      return proc != nullptr;
+   }
+
+#ifndef _WIN32
+   void* eglLoader(const char* name) { return reinterpret_cast<void*>(eglGetProcAddress(name)); }
+#else
+   void* noLoader(const char*) { return nullptr; }
+#endif
+
+}
+
+struct OffscreenContext::Reserved {
+#ifndef _WIN32
+   EGLDisplay display = EGL_NO_DISPLAY;
+   EGLContext context = EGL_NO_CONTEXT;
+#endif
+   GenObjectsProc genFramebuffers = nullptr;
+   DeleteObjectsProc deleteFramebuffers = nullptr;
+   BindObjectProc bindFramebuffer = nullptr;
+   GenObjectsProc genRenderbuffers = nullptr;
+   DeleteObjectsProc deleteRenderbuffers = nullptr;
+   BindObjectProc bindRenderbuffer = nullptr;
+   RenderbufferStorageProc renderbufferStorage = nullptr;
+   FramebufferRenderbufferProc framebufferRenderbuffer = nullptr;
+   CheckFramebufferStatusProc checkFramebufferStatus = nullptr;
+
+   GLuint framebuffer = 0;
+   GLuint colorBuffer = 0;
+   GLuint depthStencilBuffer = 0;
+   int width = 0;
+   int height = 0;
+   bool valid = false;
+
+   bool createContext() {
+#ifdef _WIN32
+      return false;
+#else
+      // Piattaforma surfaceless di Mesa: nessun server grafico; altrimenti il display predefinito
+      auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+      if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+      if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+      if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+         display = EGL_NO_DISPLAY;
+         return false;
+      }
+      if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+      // Si disegna solo nel framebuffer object: nessuna superficie e, se possibile, nessuna configurazione
+      EGLConfig config = nullptr;
+      EGLint numConfigs = 0;
+      const EGLint attributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+      eglChooseConfig(display, attributes, &config, 1, &numConfigs);
+      context = eglCreateContext(display, numConfigs > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, nullptr);
+      if (context == EGL_NO_CONTEXT) return false;
+      return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+#endif
+   }
+
+   bool loadFunctions() {
+      return load(genFramebuffers, "glGenFramebuffers") && load(deleteFramebuffers, "glDeleteFramebuffers") &&
+             load(bindFramebuffer, "glBindFramebuffer") && load(genRenderbuffers, "glGenRenderbuffers") &&
+             load(deleteRenderbuffers, "glDeleteRenderbuffers") && load(bindRenderbuffer, "glBindRenderbuffer") &&
+             load(renderbufferStorage, "glRenderbufferStorage") &&
+             load(framebufferRenderbuffer, "glFramebufferRenderbuffer") &&
+             load(checkFramebufferStatus, "glCheckFramebufferStatus");
+   }
+
+   bool createFramebuffer() {
+      genRenderbuffers(1, &colorBuffer);
+      genRenderbuffers(1, &depthStencilBuffer);
+      bindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+      renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+      bindRenderbuffer(GL_RENDERBUFFER, depthStencilBuffer);
+      renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+      bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+      genFramebuffers(1, &framebuffer);
+      bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+      framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+      framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthStencilBuffer);
+      return checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+   }
+};
+
+OffscreenContext::OffscreenContext() : reserved(std::make_unique<Reserved>()) {}
+
+OffscreenContext::~OffscreenContext() { destroy(); }
+
+bool OffscreenContext::create(int width, int height) {
+   destroy();
+   Reserved& r = *reserved;
+   r.width = width > 0 ? width : 1;
+   r.height = height > 0 ? height : 1;
+
+   if (!r.createContext()) {
+      std::cout << "[Offscreen] Contesto EGL non disponibile" << std::endl;
+      destroy();
+      return false;
+   }
+   if (!r.loadFunctions() || !r.createFramebuffer()) {
+      std::cout << "[Offscreen] Framebuffer object non disponibile" << std::endl;
+      destroy();
+      return false;
+   }
+
+   glViewport(0, 0, r.width, r.height);
+   r.valid = true;
+   return true;
+}
+
+void OffscreenContext::destroy() {
+   Reserved& r = *reserved;
+#ifndef _WIN32
+   if (r.context != EGL_NO_CONTEXT) {
+      if (r.framebuffer) {
+         r.bindFramebuffer(GL_FRAMEBUFFER, 0);
+         r.deleteFramebuffers(1, &r.framebuffer);
+      }
+      if (r.colorBuffer) r.deleteRenderbuffers(1, &r.colorBuffer);
+      if (r.depthStencilBuffer) r.deleteRenderbuffers(1, &r.depthStencilBuffer);
+      eglMakeCurrent(r.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+      eglDestroyContext(r.display, r.context);
+   }
+   if (r.display != EGL_NO_DISPLAY) eglTerminate(r.display);
+   r.display = EGL_NO_DISPLAY;
+   r.context = EGL_NO_CONTEXT;
+#endif
+   r.framebuffer = r.colorBuffer = r.depthStencilBuffer = 0;
+   r.valid = false;
+}
+
+bool OffscreenContext::isValid() const { return reserved->valid; }
+
+int OffscreenContext::getWidth() const { return reserved->width; }
+
+int OffscreenContext::getHeight() const { return reserved->height; }
+
+std::string OffscreenContext::getRenderer() const {
+   if (!reserved->valid) return std::string();
+   const GLubyte* renderer = glGetString(GL_RENDERER);
+   return renderer ? std::string(reinterpret_cast<const char*>(renderer)) : std::string();
+}
+
+bool OffscreenContext::readPixels(std::vector<uint8_t>& pixels) const {
+   const Reserved& r = *reserved;
+   if (!r.valid) return false;
+   pixels.resize((size_t)r.width * r.height * 4);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glReadPixels(0, 0, r.width, r.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+   return true;
+}
+
+bool OffscreenContext::saveImage(const std::string& path) const {
+   const Reserved& r = *reserved;
+   if (!r.valid) return false;
+
+   FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename(path.c_str());
+   if (format == FIF_UNKNOWN) return false;
+
+   // Righe BGR allineate a 4 byte, dal basso: il layout dei bitmap a 24 bit di FreeImage
+   int pitch = (r.width * 3 + 3) & ~3;
+   std::vector<BYTE> pixels((size_t)pitch * r.height);
+   glPixelStorei(GL_PACK_ALIGNMENT, 4);
+   glReadPixels(0, 0, r.width, r.height, GL_BGR, GL_UNSIGNED_BYTE, pixels.data());
+
+   FIBITMAP* bitmap = FreeImage_ConvertFromRawBits(pixels.data(), r.width, r.height, pitch, 24,
+                                                   FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, FALSE);
+   if (!bitmap) return false;
+   bool saved = FreeImage_Save(format, bitmap, path.c_str()) == TRUE;
+   FreeImage_Unload(bitmap);
+   return saved;
+}
+
+OffscreenContext::ProcLoader OffscreenContext::getProcLoader() {
+#ifdef _WIN32
+   return noLoader;
+#else
+   return eglLoader;
+#endif
+}
@@ -0,0 +1,90 @@
+/**
+ * @file offscreenContext.h
+ * @brief Contesto OpenGL senza finestra per il rendering headless.
+ */
+#pragma once
+#include "libConfig.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class OffscreenContext
+ * @brief Contesto OpenGL creato senza server grafico ne' GPU, con un framebuffer object come destinazione.
+ *
+ * Su Linux usa EGL con la piattaforma surfaceless di Mesa (in alternativa il display predefinito):
+ * con llvmpipe funziona anche su macchine di build senza X server. Il contesto e' di compatibilita',
+ * quindi il pipeline fixed-function del motore funziona invariato; il disegno avviene in un framebuffer
+ * object RGBA8 con depth e stencil della risoluzione richiesta, che resta collegato finche' il contesto vive.
+ *
+ * @note Su Windows il backend non e' disponibile e create() restituisce false.
+ */
+class ENG_API OffscreenContext {
+public:
+   /** @brief Funzione che restituisce l'indirizzo di una funzione OpenGL dato il nome. */
+   using ProcLoader = void* (*)(const char* name);
+
+   OffscreenContext();
+   ~OffscreenContext();
+
+   OffscreenContext(const OffscreenContext&) = delete;
+   OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+   /**
+    * @brief Crea il contesto, lo rende corrente e vi collega un framebuffer della risoluzione richiesta.
+    * @param width Larghezza in pixel.
+    * @param height Altezza in pixel.
+    * @return False se EGL, il contesto OpenGL o il framebuffer non sono disponibili.
+    */
+   bool create(int width, int height);
+
+   /**
+    * @brief Libera framebuffer e contesto.
+    */
+   void destroy();
+
+   /**
+    * @brief Indica se create() e' riuscita.
+    */
+   bool isValid() const;
+
+   /**
+    * @brief Restituisce la larghezza del framebuffer.
+    */
+   int getWidth() const;
+
+   /**
+    * @brief Restituisce l'altezza del framebuffer.
+    */
+   int getHeight() const;
+
+   /**
+    * @brief Descrizione del renderer (GL_RENDERER), vuota se il contesto non e' valido.
+    */
+   std::string getRenderer() const;
+
+   /**
+    * @brief Attende la fine del disegno e legge il framebuffer.
+    * @param pixels Riceve width * height pixel RGBA8, dalla riga in basso (ordine di OpenGL).
+    * @return False se il contesto non e' valido.
+    */
+   bool readPixels(std::vector<uint8_t>& pixels) const;
+
+   /**
+    * @brief Salva il framebuffer su file con FreeImage (formato dedotto dall'estensione, es. .png).
+    * @param path Percorso del file.
+    * @return False se la lettura o il salvataggio falliscono.
+    */
+   bool saveImage(const std::string& path) const;
+
+   /**
+    * @brief Caricatore delle funzioni OpenGL del contesto (eglGetProcAddress), utilizzabile senza GLUT.
+    */
+   static ProcLoader getProcLoader();
+
+private:
+   /** @brief Oggetti EGL e OpenGL (nascosti agli utenti dell'header). */
+   struct Reserved;
+   std::unique_ptr<Reserved> reserved;
+};
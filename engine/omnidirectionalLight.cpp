@@ -6,7 +6,7 @@ OmnidirectionalLight::OmnidirectionalLight() : Light()
 {
 }
 
-OmnidirectionalLight::OmnidirectionalLight(const std::string& name, const glm::mat4& matrix,
+OmnidirectionalLight::OmnidirectionalLight(std::string_view name, const glm::mat4& matrix,
     const glm::vec3& ambient, const glm::vec3& diffuse,
     const glm::vec3& specular)
     : Light(name, matrix)
@@ -29,21 +29,14 @@ float OmnidirectionalLight::getCutoff() const
     return cutoff;
 }
 
-void OmnidirectionalLight::render()
+Light::Parameters OmnidirectionalLight::getParameters() const
 {
-    Light::render();
-    
+    Parameters parameters = Light::getParameters();
 
     // Usiamo (0,0,0,1) perch la ModelView Matrix (caricata dalla List)
     // ha gi spostato il "cursore" nel punto esatto della luce.
-    // se usassimo glm::value_ptr(position) posizione sarebbe currentMatrix * position
-    GLfloat zeroPos[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-    glLightfv(lightContextID, GL_POSITION, zeroPos);
-
-    glLightf(lightContextID, GL_SPOT_CUTOFF, cutoff); // 180.0 per omni
-
-    // Attenuazione standard
-    glLightf(lightContextID, GL_CONSTANT_ATTENUATION, 1.0f);
-    glLightf(lightContextID, GL_LINEAR_ATTENUATION, 0.0f);
-    glLightf(lightContextID, GL_QUADRATIC_ATTENUATION, 0.0f);
+    // se usassimo position la posizione sarebbe currentMatrix * position
+    parameters.position = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    parameters.spotCutoff = cutoff; // 180.0 per omni
+    return parameters;
 }
\ No newline at end of file
@@ -21,7 +21,7 @@ public:
    /**
     * @brief Inizializza una luce omnidirezionale con le propriet luminose specificate.
     */
-   OmnidirectionalLight(const std::string& name, const glm::mat4& matrix,
+   OmnidirectionalLight(std::string_view name, const glm::mat4& matrix,
       const glm::vec3& ambient, const glm::vec3& diffuse,
       const glm::vec3& specular);
 
@@ -37,9 +37,9 @@ public:
    float getCutoff() const;
 
    /**
-    * @brief Esegue il rendering della luce nella scena.
+    * @brief Aggiunge ai parametri comuni quelli specifici di questo tipo di luce.
     */
-   void render() override;
+   Parameters getParameters() const override;
 
 private:
    /** @brief Angolo massimo di illuminazione (180 indica copertura sferica completa). */
@@ -4,7 +4,7 @@
  * @brief Implementazione delle classe orthographicCamera.
  */
 
-OrthographicCamera::OrthographicCamera(const std::string& name, float left, float right, float bottom, float top, float near, float far)
+OrthographicCamera::OrthographicCamera(std::string_view name, float left, float right, float bottom, float top, float near, float far)
     : Camera(name), left(left), right(right), bottom(bottom), top(top), zNear(near), zFar(far)
 {
     updateProjection();
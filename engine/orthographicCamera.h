@@ -9,7 +9,7 @@ public:
     /**
      * @brief Costruttore per la camera ortografica.
      */
-    OrthographicCamera(const std::string& name, float left, float right, float bottom, float top, float near, float far);
+    OrthographicCamera(std::string_view name, float left, float right, float bottom, float top, float near, float far);
 
     /**
      * @brief Aggiorna le dimensioni del frustum ortografico.
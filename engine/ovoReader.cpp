@@ -20,7 +20,27 @@ using namespace std;
 // CLASSES //
 /////////////
 
+Scene ENG_API* OvoReader::loadScene(const char* file_path, const char* texture_dir) {
+    Scene* scene = new Scene();
+    m_scene = scene;
+    Node* root = readFile(file_path, texture_dir);
+    m_scene = nullptr;
+
+    if (!root) {
+        // Rilascia anche gli oggetti creati prima dell'errore
+        delete scene;
+        return nullptr;
+    }
+    scene->setRoot(root);
+    std::cout << "[OvoReader] Scene memory: " << scene->getArena().getBytesUsed() << " bytes in "
+              << scene->getArena().getNumBlocks() << " blocks, " << scene->getArena().getNumObjects() << " objects" << std::endl;
+    return scene;
+}
+
 Node ENG_API* OvoReader::readFile(const char* file_path, const char* texture_dir) {
+    // I materiali di un caricamento precedente possono essere gia' stati distrutti con la loro scena
+    m_materials.clear();
+
     FILE* dat = fopen(file_path, "rb");
 
     //Open File:
@@ -69,7 +89,7 @@ Node ENG_API* OvoReader::readFile(const char* file_path, const char* texture_dir
 
         case OvObject::Type::MATERIAL:
             material = parse_material(data, position, texture_dir);
-            m_materials.insert(make_pair(material->getName(), material));
+            m_materials.insert(make_pair(material->getNameId(), material));
             break;
 
         case OvObject::Type::NODE:
@@ -102,6 +122,9 @@ Node ENG_API* OvoReader::readFile(const char* file_path, const char* texture_dir
 
     Node* root = recursive_load(dat, file_path);
     fclose(dat);
+
+    // Le ricerche per nome del client passano dall'indice invece di visitare l'albero
+    if (root) root->buildNameIndex();
     std::cout << "\nFile OVO parsed" << std::endl;
 
     return root;
@@ -178,11 +201,17 @@ void ENG_API OvoReader::parse_object(char* data, unsigned int& position)
     position += sizeof(unsigned int);
 }
 
+std::string_view OvoReader::read_string(const char* data, unsigned int& position)
+{
+    // La stringa resta nel buffer del chunk: il nome viene copiato una sola volta, quando l'oggetto lo interna
+    std::string_view value{ data + position };
+    position += (unsigned int)value.size() + 1;
+    return value;
+}
+
 Material ENG_API* OvoReader::parse_material(char* data, unsigned int& position, const char* texture_dir)
 {
-   char materialName[FILENAME_MAX];
-   strcpy(materialName, data + position);
-   position += strlen(materialName) + 1;
+   std::string_view materialName = read_string(data, position);
 
 
    glm::vec3 emission, albedo;
@@ -203,25 +232,15 @@ Material ENG_API* OvoReader::parse_material(char* data, unsigned int& position,
    std::cout << "[OvoReader] Parsing Material: '" << materialName << "' " << transparency<< std::endl; // <--- LOG
 
    // Texture filenames
-   char albedoTexture[FILENAME_MAX];
-   strcpy(albedoTexture, data + position);
-   position += (unsigned int)strlen(albedoTexture) + 1;
+   std::string_view albedoTexture = read_string(data, position);
 
-   char normalMapTexture[FILENAME_MAX];
-   strcpy(normalMapTexture, data + position);
-   position += (unsigned int)strlen(normalMapTexture) + 1;
+   [[maybe_unused]] std::string_view normalMapTexture = read_string(data, position);
 
-   char heightMapTexture[FILENAME_MAX];
-   strcpy(heightMapTexture, data + position);
-   position += (unsigned int)strlen(heightMapTexture) + 1;
+   [[maybe_unused]] std::string_view heightMapTexture = read_string(data, position);
 
-   char roughnessTexture[FILENAME_MAX];
-   strcpy(roughnessTexture, data + position);
-   position += (unsigned int)strlen(roughnessTexture) + 1;
+   [[maybe_unused]] std::string_view roughnessTexture = read_string(data, position);
 
-   char metalnessTexture[FILENAME_MAX];
-   strcpy(metalnessTexture, data + position);
-   position += (unsigned int)strlen(metalnessTexture) + 1;
+   [[maybe_unused]] std::string_view metalnessTexture = read_string(data, position);
 
    // Crea Materiale
    float shininess = pow(1.0f - roughness, 4) * 128.0f;
@@ -229,10 +248,10 @@ Material ENG_API* OvoReader::parse_material(char* data, unsigned int& position,
    glm::vec4 emission4 = glm::vec4(emission, 0.0f);
    glm::vec4 albedo4 = glm::vec4(albedo, 0.0f);
 
-   Material* material = new Material(materialName, emission4, albedo4 * 0.1f, albedo4, specular4, shininess, transparency);
+   Material* material = create<Material>(materialName, emission4, albedo4 * 0.1f, albedo4, specular4, shininess, transparency);
 
    // Gestione Texture (con fix percorso)
-   if (std::string{ albedoTexture } != "[none]") {
+   if (albedoTexture != "[none]") {
       std::string path = texture_dir;
       // Fix slash
       if (!path.empty() && path.back() != '/' && path.back() != '\\') {
@@ -242,7 +261,7 @@ Material ENG_API* OvoReader::parse_material(char* data, unsigned int& position,
 
       std::cout << "   [Texture] Loading Albedo: " << path << std::endl; // <--- LOG
 
-      Texture* t = new Texture{ albedoTexture, path };
+      Texture* t = create<Texture>(albedoTexture, path);
       material->setTexture(t);
    }
 
@@ -252,10 +271,7 @@ Material ENG_API* OvoReader::parse_material(char* data, unsigned int& position,
 Node ENG_API* OvoReader::parse_node(char* data, unsigned int& position, unsigned int* n_children)
 {
 
-   char nodeName[FILENAME_MAX];
-   strncpy(nodeName, data + position, FILENAME_MAX - 1);
-   nodeName[FILENAME_MAX - 1] = '\0';
-   position += (unsigned int)strlen(nodeName) + 1;
+   std::string_view nodeName = read_string(data, position);
 
    std::cout << "[OvoReader] Node found: '" << nodeName << "'" << std::endl; // <--- LOG
 
@@ -268,11 +284,9 @@ Node ENG_API* OvoReader::parse_node(char* data, unsigned int& position, unsigned
    *n_children = children;
    position += sizeof(unsigned int);
 
-   char targetName[FILENAME_MAX];
-   strcpy(targetName, data + position);
-   position += (unsigned int)strlen(targetName) + 1;
+   [[maybe_unused]] std::string_view targetName = read_string(data, position);
 
-   Node* node = new Node{ nodeName };
+   Node* node = create<Node>(nodeName);
    node->setM(matrix);
    return node;
 }
@@ -280,9 +294,7 @@ Node ENG_API* OvoReader::parse_node(char* data, unsigned int& position, unsigned
 Mesh ENG_API* OvoReader::parse_mesh(char* data, unsigned int& position, unsigned int* n_children)
 {
     // Mesh name (optional for reference, not stored)
-    char meshName[FILENAME_MAX];
-    strcpy(meshName, data + position);
-    position += (unsigned int)strlen(meshName) + 1;
+    std::string_view meshName = read_string(data, position);
     // Mesh matrix
     glm::mat4 matrix;
     memcpy(&matrix, data + position, sizeof(glm::mat4));
@@ -296,28 +308,24 @@ Mesh ENG_API* OvoReader::parse_mesh(char* data, unsigned int& position, unsigned
     position += sizeof(unsigned int);
 
     // Optional target node, or [none] if not used:
-    char targetName[FILENAME_MAX];
-    strcpy(targetName, data + position);
-    position += (unsigned int)strlen(targetName) + 1;
+    [[maybe_unused]] std::string_view targetName = read_string(data, position);
 
     // Mesh subtype
     unsigned char subtype;
     memcpy(&subtype, data + position, sizeof(unsigned char));
-    char subtypeName[FILENAME_MAX];
+    [[maybe_unused]] const char* subtypeName;
     switch ((OvMesh::Subtype)subtype)
     {
-    case OvMesh::Subtype::DEFAULT: strcpy(subtypeName, "standard"); break;
-    case OvMesh::Subtype::NORMALMAPPED: strcpy(subtypeName, "normal-mapped"); break;
-    case OvMesh::Subtype::TESSELLATED: strcpy(subtypeName, "tessellated"); break;
-    default: strcpy(subtypeName, "UNDEFINED");
+    case OvMesh::Subtype::DEFAULT: subtypeName = "standard"; break;
+    case OvMesh::Subtype::NORMALMAPPED: subtypeName = "normal-mapped"; break;
+    case OvMesh::Subtype::TESSELLATED: subtypeName = "tessellated"; break;
+    default: subtypeName = "UNDEFINED";
     }
     position += sizeof(unsigned char);
 
 
     // Material name
-    char materialName[FILENAME_MAX];
-    strcpy(materialName, data + position);
-    position += (unsigned int)strlen(materialName) + 1;
+    std::string_view materialName = read_string(data, position);
 
     // --- LOG ---
     std::cout << "[OvoReader] Mesh found: '" << meshName
@@ -471,13 +479,14 @@ Mesh ENG_API* OvoReader::parse_mesh(char* data, unsigned int& position, unsigned
     }
 
 
-    auto material = m_materials.find(materialName);
+    auto material = m_materials.find(NameTable::find(materialName));
     if (material == m_materials.end()) {
         std::cout << "ERROR: material '" << materialName << "' doesn't exists in file" << std::endl;
         return nullptr;
     }
 
-    Mesh* mesh = new Mesh{ meshName, matrix, faces, vertices, material->second };
+    Mesh* mesh = create<Mesh>(meshName, matrix, faces, vertices, material->second,
+        m_scene ? static_cast<std::pmr::memory_resource*>(&m_scene->getArena()) : std::pmr::get_default_resource());
     mesh->set_all_vertices(vertexData);
     mesh->set_all_normals(normals);
     mesh->set_all_texture_coords(textureCoords);
@@ -492,9 +501,7 @@ Light ENG_API* OvoReader::parse_light(char* data, unsigned int& position, unsign
 {
    
     // Nome della luce
-    char lightName[FILENAME_MAX];
-    strcpy(lightName, data + position);
-    position += (unsigned int)strlen(lightName) + 1;
+    std::string_view lightName = read_string(data, position);
 
     glm::mat4 matrix;
     memcpy(&matrix, data + position, sizeof(glm::mat4));
@@ -507,20 +514,18 @@ Light ENG_API* OvoReader::parse_light(char* data, unsigned int& position, unsign
     position += sizeof(unsigned int);
 
     // Target node (non usato direttamente in questo caso)
-    char targetName[FILENAME_MAX];
-    strcpy(targetName, data + position);
-    position += (unsigned int)strlen(targetName) + 1;
+    [[maybe_unused]] std::string_view targetName = read_string(data, position);
 
     // Subtipo della luce (0 = omni, 1 = directional, 2 = spot)
     unsigned char subtype;
     memcpy(&subtype, data + position, sizeof(unsigned char));
-    char subtypeName[FILENAME_MAX];
+    const char* subtypeName;
     switch ((OvLight::Subtype)subtype)
     {
-    case OvLight::Subtype::DIRECTIONAL: strcpy(subtypeName, "directional"); break;
-    case OvLight::Subtype::OMNI: strcpy(subtypeName, "omni"); break;
-    case OvLight::Subtype::SPOT: strcpy(subtypeName, "spot"); break;
-    default: strcpy(subtypeName, "UNDEFINED");
+    case OvLight::Subtype::DIRECTIONAL: subtypeName = "directional"; break;
+    case OvLight::Subtype::OMNI: subtypeName = "omni"; break;
+    case OvLight::Subtype::SPOT: subtypeName = "spot"; break;
+    default: subtypeName = "UNDEFINED";
     }
     position += sizeof(unsigned char);
 
@@ -564,30 +569,31 @@ Light ENG_API* OvoReader::parse_light(char* data, unsigned int& position, unsign
 
     // Crea l'oggetto di tipo appropriato in base al tipo di luce
     Light* light = nullptr;
-    float attenuation;
 
     if ((OvLight::Subtype)subtype == OvLight::Subtype::OMNI) { // OmniDirectionalLight
-        attenuation = glm::clamp(1.0f / radius, 0.0f, 1.0f);
-        OmnidirectionalLight* omniLight = new OmnidirectionalLight(
+        OmnidirectionalLight* omniLight = create<OmnidirectionalLight>(
             lightName, matrix, color, color, color
             //,constantAttenuation, linearAttenuation, quadraticAttenuation
         );
         light = omniLight;
     }
     else if ((OvLight::Subtype)subtype == OvLight::Subtype::DIRECTIONAL) { // DirectionalLight
-        InfiniteLight* infiniteLight = new InfiniteLight(
+        InfiniteLight* infiniteLight = create<InfiniteLight>(
             lightName, matrix, color, color, color, direction
         );  // Le luci direzionali non hanno attenuazione, quindi non servono questi parametri
         light = infiniteLight;
     }
     else if ((OvLight::Subtype)subtype == OvLight::Subtype::SPOT) { // SpotLight
-        attenuation = glm::clamp(10.0f / radius, 0.0f, 1.0f);
-        SpotLight* spotLight = new SpotLight(
+        SpotLight* spotLight = create<SpotLight>(
             lightName, matrix, color, color, color, direction, cutoff, spotExponent
             //, constantAttenuation,linearAttenuation, quadraticAttenuation
         );
         light = spotLight;
     }
 
+    // Il raggio serve al LightManager per scegliere le luci piu' influenti per ogni oggetto
+    if (light && (OvLight::Subtype)subtype != OvLight::Subtype::DIRECTIONAL)
+        light->setRadius(radius);
+
     return light;
 }
\ No newline at end of file
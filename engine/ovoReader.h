@@ -34,6 +34,8 @@
 
 #include "texture.h"
 
+#include "scene.h"
+
 
 
 
@@ -148,14 +150,44 @@ public:
      */
     Node* readFile(const char* file_path, const char* texture_dir);
 
+    /**
+     * @brief Reads an OVO file into a Scene that owns every node, material, texture and vertex array it creates.
+     * Deleting the returned scene releases the whole load at once.
+     * @param file_path Path to the OVO file.
+     * @param texture_dir Directory containing textures.
+     * @return Pointer to the loaded Scene (owned by the caller), or nullptr if an error occurs.
+     */
+    Scene* loadScene(const char* file_path, const char* texture_dir);
+
 protected:
     /**
      * @brief A map that stores materials parsed from the OVO file.
      *
-     * The key is the material's name (as a string), and the value is a pointer to the corresponding Material object.
+     * The key is the material's interned name (see NameTable), and the value is a pointer to the corresponding Material object.
      * This map is used to manage and reference materials during the parsing process.
      */
-    std::map<std::string, Material*> m_materials;
+    std::map<NameTable::Id, Material*> m_materials;
+
+    /**
+     * @brief Scene receiving the parsed objects while loadScene() runs (nullptr: objects are allocated with new).
+     */
+    Scene* m_scene = nullptr;
+
+    /**
+     * @brief Allocates a parsed object in the current scene, or on the heap when reading with readFile().
+     */
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        return m_scene ? m_scene->create<T>(std::forward<Args>(args)...) : new T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Reads a null-terminated string from the chunk without copying it.
+     * @param data Pointer to the chunk data.
+     * @param position Current read position in the data, moved past the terminator.
+     * @return View on the string inside the chunk (valid while the chunk is alive).
+     */
+    static std::string_view read_string(const char* data, unsigned int& position);
 
     /**
      * @brief Recursively loads nodes and their children from the file.
@@ -4,7 +4,7 @@
  * @brief Implementazione delle classe perspectiveCamera.
  */
 
-PerspectiveCamera::PerspectiveCamera(const std::string& name, float fovY, float aspect, float near, float far)
+PerspectiveCamera::PerspectiveCamera(std::string_view name, float fovY, float aspect, float near, float far)
     : Camera(name), fovY(fovY), aspect(aspect), zNear(near), zFar(far)
 {
     updateProjection();
@@ -11,7 +11,7 @@ public:
     /**
      * @brief Costruttore per la camera prospettica.
      */
-    PerspectiveCamera(const std::string& name, float fovY, float aspect, float near, float far);
+    PerspectiveCamera(std::string_view name, float fovY, float aspect, float near, float far);
 
     /**
      * @brief Aggiorna il Field of View (FOV).
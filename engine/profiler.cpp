@@ -0,0 +1,298 @@
+#include "profiler.h"
+#include <GL/freeglut.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+/**
+ * @file profiler.cpp
+ * @brief Implementazione del profiler di frame.
+ */
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+namespace {
+
+   constexpr uint64_t MASK = Profiler::CAPACITY - 1;
+   /** @brief Timer query disponibili: bastano per qualche frame di ritardo della GPU. */
+   constexpr int QUERY_POOL = 64;
+
+   // --- RING BUFFER ---
+
+   /**
+    * Slot del ring buffer: sequence vale indice + 1 quando il campione e' pubblicato e 0 durante la
+    * scrittura; un lettore accetta la copia solo se la sequenza e' la stessa prima e dopo (seqlock).
+    */
+   struct Slot {
+      std::atomic<uint64_t> sequence{ 0 };
+      Profiler::Sample sample;
+   };
+
+   Slot ring[Profiler::CAPACITY];
+   std::atomic<uint64_t> head{ 0 };
+   std::atomic<uint32_t> currentFrame{ 0 };
+   std::atomic<bool> enabled{ false };
+   std::atomic<uint32_t> nextThread{ 1 };
+   const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+   /** @brief Copia il campione di indice assoluto index; false se e' in scrittura o gia' sovrascritto. */
+   bool readSlot(uint64_t index, Profiler::Sample& out) {
+      const Slot& slot = ring[index & MASK];
+      if (slot.sequence.load(std::memory_order_acquire) != index + 1) return false;
+      out = slot.sample;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+   }
+
+   uint32_t threadIndex() {
+      thread_local uint32_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+      return index;
+   }
+
+   // --- RIEPILOGO (solo thread di rendering) ---
+   std::vector<Profiler::Entry> breakdown;
+   /** @brief Ultimo tempo GPU letto per ogni sezione. */
+   std::vector<std::pair<const char*, double>> lastGpu;
+
+   Profiler::Entry& entryFor(std::vector<Profiler::Entry>& entries, const char* name) {
+      for (auto& entry : entries)
+         if (entry.name == name || std::strcmp(entry.name, name) == 0) return entry;
+      entries.push_back(Profiler::Entry());
+      entries.back().name = name;
+      return entries.back();
+   }
+
+   // --- TIMER QUERY (solo thread di rendering) ---
+   using GenQueriesProc = void (APIENTRY*)(GLsizei, GLuint*);
+   using DeleteQueriesProc = void (APIENTRY*)(GLsizei, const GLuint*);
+   using BeginQueryProc = void (APIENTRY*)(GLenum, GLuint);
+   using EndQueryProc = void (APIENTRY*)(GLenum);
+   using GetQueryObjectivProc = void (APIENTRY*)(GLuint, GLenum, GLint*);
+   using GetQueryObjectui64vProc = void (APIENTRY*)(GLuint, GLenum, uint64_t*);
+
+   struct GpuTimers {
+      bool supported = false;
+      GenQueriesProc genQueries = nullptr;
+      DeleteQueriesProc deleteQueries = nullptr;
+      BeginQueryProc beginQuery = nullptr;
+      EndQueryProc endQuery = nullptr;
+      GetQueryObjectivProc getQueryObjectiv = nullptr;
+      GetQueryObjectui64vProc getQueryObjectui64v = nullptr;
+
+      GLuint queries[QUERY_POOL] = {};
+      const char* names[QUERY_POOL] = {};
+      uint64_t starts[QUERY_POOL] = {};
+      uint32_t frames[QUERY_POOL] = {};
+      std::vector<int> available;
+      /** @brief Query concluse in attesa del risultato, in ordine di emissione. */
+      std::vector<int> pending;
+      bool active = false;
+   } gpu;
+
+   void* glutLoader(const char* name) { return reinterpret_cast<void*>(glutGetProcAddress(name)); }
+
+   template <class Proc>
+   bool load(OffscreenContext::ProcLoader loader, Proc& proc, const char* name) {
+      proc = reinterpret_cast<Proc>(loader(name));
+      return proc != nullptr;
+   }
+
+}
+
+// --- SCOPE ---
+
+Profiler::Scope::Scope(const char* name) : name(nullptr), start(0), frame(0) {
+   if (!enabled.load(std::memory_order_relaxed)) return;
+   this->name = name;
+   frame = getFrame();
+   start = now();
+}
+
+Profiler::Scope::~Scope() {
+   if (name) record(name, start, now() - start, frame, false);
+}
+
+Profiler::GpuScope::GpuScope(const char* name) : slot(-1) {
+   if (!enabled.load(std::memory_order_relaxed) || !gpu.supported || gpu.active || gpu.available.empty()) return;
+   slot = gpu.available.back();
+   gpu.available.pop_back();
+   gpu.names[slot] = name;
+   gpu.starts[slot] = now();
+   gpu.frames[slot] = getFrame();
+   gpu.beginQuery(GL_TIME_ELAPSED, gpu.queries[slot]);
+   gpu.active = true;
+}
+
+Profiler::GpuScope::~GpuScope() {
+   if (slot < 0) return;
+   gpu.endQuery(GL_TIME_ELAPSED);
+   gpu.active = false;
+   gpu.pending.push_back(slot);
+}
+
+// --- PROFILER ---
+
+void Profiler::setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+bool Profiler::isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+bool Profiler::initGpu(OffscreenContext::ProcLoader loader) {
+   if (gpu.supported) return true;
+   if (!loader) loader = glutLoader;
+   bool ok = load(loader, gpu.genQueries, "glGenQueries") && load(loader, gpu.deleteQueries, "glDeleteQueries") &&
+             load(loader, gpu.beginQuery, "glBeginQuery") && load(loader, gpu.endQuery, "glEndQuery") &&
+             load(loader, gpu.getQueryObjectiv, "glGetQueryObjectiv") &&
+             load(loader, gpu.getQueryObjectui64v, "glGetQueryObjectui64v");
+   if (!ok) return false;
+
+   gpu.genQueries(QUERY_POOL, gpu.queries);
+   gpu.available.clear();
+   gpu.pending.clear();
+   for (int i = QUERY_POOL - 1; i >= 0; i--) gpu.available.push_back(i);
+   gpu.active = false;
+   gpu.supported = true;
+   return true;
+}
+
+void Profiler::freeGpu() {
+   if (!gpu.supported) return;
+   gpu.deleteQueries(QUERY_POOL, gpu.queries);
+   gpu.available.clear();
+   gpu.pending.clear();
+   gpu.supported = false;
+}
+
+bool Profiler::isGpuSupported() { return gpu.supported; }
+
+void Profiler::endFrame() {
+   uint32_t frame = currentFrame.load(std::memory_order_relaxed);
+
+   // Timer query pronti, in ordine: il primo non pronto ferma la lettura senza attese
+   size_t resolved = 0;
+   for (; resolved < gpu.pending.size(); resolved++) {
+      int slot = gpu.pending[resolved];
+      GLint ready = 0;
+      gpu.getQueryObjectiv(gpu.queries[slot], GL_QUERY_RESULT_AVAILABLE, &ready);
+      if (!ready) break;
+      uint64_t elapsed = 0;
+      gpu.getQueryObjectui64v(gpu.queries[slot], GL_QUERY_RESULT, &elapsed);
+      record(gpu.names[slot], gpu.starts[slot], elapsed, gpu.frames[slot], true);
+
+      bool found = false;
+      for (auto& last : lastGpu) {
+         if (last.first == gpu.names[slot] || std::strcmp(last.first, gpu.names[slot]) == 0) {
+            last.second = elapsed / 1e6;
+            found = true;
+         }
+      }
+      if (!found) lastGpu.push_back({ gpu.names[slot], elapsed / 1e6 });
+      gpu.available.push_back(slot);
+   }
+   gpu.pending.erase(gpu.pending.begin(), gpu.pending.begin() + resolved);
+
+   if (isEnabled()) {
+      // Campioni CPU del frame appena chiuso: si risale dalla testa del ring fino al primo campione
+      // CPU di un frame precedente, senza copiare l'intero buffer
+      uint64_t end = head.load(std::memory_order_acquire);
+      uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+      uint64_t first = end;
+      while (first > begin) {
+         Sample sample;
+         if (readSlot(first - 1, sample) && !sample.gpu && sample.frame < frame) break;
+         first--;
+      }
+      std::vector<Entry> entries;
+      for (uint64_t i = first; i < end; i++) {
+         Sample sample;
+         if (!readSlot(i, sample) || sample.gpu || sample.frame != frame) continue;
+         Entry& entry = entryFor(entries, sample.name);
+         entry.cpuMs += sample.duration / 1e6;
+         entry.calls++;
+      }
+      for (const auto& last : lastGpu) entryFor(entries, last.first).gpuMs = last.second;
+      breakdown = std::move(entries);
+   }
+
+   currentFrame.store(frame + 1, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::getFrame() { return currentFrame.load(std::memory_order_relaxed); }
+
+uint64_t Profiler::now() {
+   return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t duration, uint32_t frame, bool isGpu) {
+   uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+   Slot& slot = ring[index & MASK];
+   slot.sequence.store(0, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+   slot.sample.name = name;
+   slot.sample.start = start;
+   slot.sample.duration = duration;
+   slot.sample.frame = frame;
+   slot.sample.thread = isGpu ? 0 : threadIndex();
+   slot.sample.gpu = isGpu;
+   slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::getSamples(std::vector<Sample>& out) {
+   out.clear();
+   uint64_t end = head.load(std::memory_order_acquire);
+   uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+   out.reserve((size_t)(end - begin));
+   for (uint64_t i = begin; i < end; i++) {
+      Sample copy;
+      if (readSlot(i, copy)) out.push_back(copy);
+   }
+}
+
+std::vector<Profiler::Entry> Profiler::getLastFrameBreakdown() { return breakdown; }
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+   std::ofstream file(path);
+   if (!file) return false;
+
+   std::vector<Sample> samples;
+   getSamples(samples);
+
+   auto writeName = [&file](const char* name) {
+      file << '"';
+      for (const char* c = name; *c; c++) {
+         if (*c == '"' || *c == '\\') file << '\\';
+         file << *c;
+      }
+      file << '"';
+   };
+
+   // Tempi in microsecondi; la GPU ha un proprio thread nella visualizzazione
+   file << std::fixed << std::setprecision(3);
+   file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+   for (const Sample& sample : samples) {
+      file << ",\n{\"name\":";
+      writeName(sample.name);
+      file << ",\"cat\":\"" << (sample.gpu ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"ts\":" << sample.start / 1e3
+           << ",\"dur\":" << sample.duration / 1e3 << ",\"pid\":1,\"tid\":" << sample.thread
+           << ",\"args\":{\"frame\":" << sample.frame << "}}";
+   }
+   file << "\n]}\n";
+   return (bool)file;
+}
+
+void Profiler::clear() {
+   // Gli slot restano con la sequenza vecchia: ripartendo da un indice successivo non vengono piu' letti
+   head.store(head.load(std::memory_order_relaxed) + CAPACITY, std::memory_order_relaxed);
+   breakdown.clear();
+   lastGpu.clear();
+}
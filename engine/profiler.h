@@ -0,0 +1,160 @@
+/**
+ * @file profiler.h
+ * @brief Profiler di frame per CPU e GPU con esportazione nel formato Chrome trace.
+ */
+#pragma once
+#include "libConfig.h"
+#include "offscreenContext.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class Profiler
+ * @brief Raccoglie la durata di sezioni marcate del frame, sulla CPU e (con i timer query) sulla GPU.
+ *
+ * Le sezioni si marcano con oggetti Scope (CPU, da qualunque thread) e GpuScope (GPU, solo dal thread
+ * di rendering). I campioni finiscono in un ring buffer di dimensione fissa senza lock: ogni scrittore
+ * riserva uno slot con un incremento atomico e lo pubblica con un numero di sequenza, quindi i thread
+ * di List::passParallel() possono registrare senza contendersi un mutex; i campioni piu' vecchi vengono
+ * sovrascritti. I timer query della GPU si leggono senza attese qualche frame dopo, quando sono pronti.
+ *
+ * A fine frame viene calcolato il riepilogo per sezione (getLastFrameBreakdown()) mostrato a schermo da
+ * Eng::Base; writeChromeTrace() salva l'intero buffer per chrome://tracing o Perfetto.
+ *
+ * @note I nomi delle sezioni non vengono copiati: devono essere stringhe letterali o comunque durare
+ * quanto il profiler. Con il profiler disattivato uno Scope costa un solo controllo.
+ */
+class ENG_API Profiler {
+public:
+   /** @brief Numero di campioni conservati (potenza di due). */
+   static constexpr unsigned int CAPACITY = 1u << 16;
+
+   /**
+    * @struct Sample
+    * @brief Una sezione misurata; i tempi sono in nanosecondi dall'avvio del profiler.
+    */
+   struct Sample {
+      const char* name = nullptr;
+      uint64_t start = 0;
+      uint64_t duration = 0;
+      /** @brief Frame di appartenenza (getFrame() al momento dell'inizio). */
+      uint32_t frame = 0;
+      /** @brief Indice del thread (1 = primo thread che ha registrato), 0 per la GPU. */
+      uint32_t thread = 0;
+      bool gpu = false;
+   };
+
+   /**
+    * @struct Entry
+    * @brief Tempo totale di una sezione in un frame.
+    */
+   struct Entry {
+      const char* name = nullptr;
+      double cpuMs = 0.0;
+      /** @brief Ultimo tempo GPU noto (i risultati arrivano con qualche frame di ritardo), negativo se assente. */
+      double gpuMs = -1.0;
+      unsigned int calls = 0;
+   };
+
+   /**
+    * @class Scope
+    * @brief Misura la CPU dalla costruzione alla distruzione.
+    */
+   class ENG_API Scope {
+   public:
+      explicit Scope(const char* name);
+      ~Scope();
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+   private:
+      const char* name;
+      uint64_t start;
+      uint32_t frame;
+   };
+
+   /**
+    * @class GpuScope
+    * @brief Misura la GPU dalla costruzione alla distruzione con un timer query (GL_TIME_ELAPSED).
+    * @note I timer query non si annidano: dentro un altro GpuScope attivo non misura nulla.
+    */
+   class ENG_API GpuScope {
+   public:
+      explicit GpuScope(const char* name);
+      ~GpuScope();
+      GpuScope(const GpuScope&) = delete;
+      GpuScope& operator=(const GpuScope&) = delete;
+   private:
+      int slot;
+   };
+
+   /**
+    * @brief Attiva o disattiva la raccolta.
+    */
+   static void setEnabled(bool enabled);
+
+   /**
+    * @brief Indica se la raccolta e' attiva.
+    */
+   static bool isEnabled();
+
+   /**
+    * @brief Prepara i timer query della GPU (richiede un contesto attivo).
+    * @param loader Caricatore delle funzioni; nullptr usa glutGetProcAddress() (finestra GLUT).
+    * @return False se i timer query non sono disponibili (si misura solo la CPU).
+    */
+   static bool initGpu(OffscreenContext::ProcLoader loader = nullptr);
+
+   /**
+    * @brief Libera i timer query (richiede il contesto ancora attivo).
+    */
+   static void freeGpu();
+
+   /**
+    * @brief Indica se i timer query della GPU sono disponibili.
+    */
+   static bool isGpuSupported();
+
+   /**
+    * @brief Chiude il frame corrente: raccoglie i timer query pronti, calcola il riepilogo e passa al frame successivo.
+    */
+   static void endFrame();
+
+   /**
+    * @brief Restituisce il numero del frame corrente.
+    */
+   static uint32_t getFrame();
+
+   /**
+    * @brief Nanosecondi trascorsi dall'avvio del profiler.
+    */
+   static uint64_t now();
+
+   /**
+    * @brief Registra un campione gia' misurato (usato da Scope e GpuScope).
+    */
+   static void record(const char* name, uint64_t start, uint64_t duration, uint32_t frame, bool gpu);
+
+   /**
+    * @brief Copia i campioni presenti nel buffer, dal piu' vecchio.
+    * @param out Riceve i campioni.
+    */
+   static void getSamples(std::vector<Sample>& out);
+
+   /**
+    * @brief Riepilogo per sezione dell'ultimo frame chiuso, nell'ordine di prima apparizione.
+    */
+   static std::vector<Entry> getLastFrameBreakdown();
+
+   /**
+    * @brief Salva i campioni nel formato JSON Chrome trace (eventi completi "X", un thread per la GPU).
+    * @param path Percorso del file.
+    * @return False se il file non puo' essere scritto.
+    */
+   static bool writeChromeTrace(const std::string& path);
+
+   /**
+    * @brief Svuota il buffer e il riepilogo.
+    */
+   static void clear();
+};
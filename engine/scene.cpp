@@ -0,0 +1,33 @@
+#include "scene.h"
+#include "node.h"
+#include <vector>
+
+/**
+ * @file scene.cpp
+ * @brief Implementazione della classe Scene.
+ */
+
+Scene::Scene() : arena(256 * 1024) {}
+
+Scene::~Scene() {
+   if (root) detachForeign(root);
+   arena.release();
+}
+
+void Scene::detachForeign(Node* node) {
+   std::vector<Node*> foreign;
+   for (unsigned int i = 0; i < node->getNumChildren(); i++) {
+      Node* child = node->getChild(i);
+      if (arena.owns(child)) detachForeign(child);
+      else foreign.push_back(child);
+   }
+   for (Node* child : foreign) node->removeChild(child);
+}
+
+Arena& Scene::getArena() { return arena; }
+
+Node* Scene::getRoot() const { return root; }
+
+void Scene::setRoot(Node* newRoot) { root = newRoot; }
+
+bool Scene::owns(const void* object) const { return arena.owns(object); }
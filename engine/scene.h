@@ -0,0 +1,73 @@
+/**
+ * @file scene.h
+ * @brief Grafo di scena che possiede tutti i propri oggetti.
+ */
+#pragma once
+#include "libConfig.h"
+#include "arena.h"
+#include <utility>
+
+class Node;
+
+/**
+ * @class Scene
+ * @brief Contenitore di una scena caricata: nodi, mesh, luci, materiali, texture e vertici vivono nella sua arena.
+ *
+ * Distruggere la scena distrugge tutti i suoi oggetti e ne libera la memoria in blocco, senza dover
+ * visitare il grafo. I nodi esterni agganciati alla scena (es. la camera del client) non vengono
+ * distrutti: prima del rilascio sono staccati dal loro genitore.
+ *
+ * @note Gli oggetti della scena non vanno mai cancellati con delete.
+ */
+class ENG_API Scene {
+public:
+   /**
+    * @brief Costruisce una scena vuota.
+    */
+   Scene();
+
+   /**
+    * @brief Distruttore: stacca i nodi esterni e rilascia l'arena.
+    */
+   ~Scene();
+
+   Scene(const Scene&) = delete;
+   Scene& operator=(const Scene&) = delete;
+
+   /**
+    * @brief Costruisce un oggetto posseduto dalla scena.
+    */
+   template <class T, class... Args>
+   T* create(Args&&... args) {
+      return arena.create<T>(std::forward<Args>(args)...);
+   }
+
+   /**
+    * @brief Restituisce l'arena della scena (usabile come std::pmr::memory_resource).
+    */
+   Arena& getArena();
+
+   /**
+    * @brief Restituisce la radice del grafo.
+    */
+   Node* getRoot() const;
+
+   /**
+    * @brief Imposta la radice del grafo.
+    */
+   void setRoot(Node* root);
+
+   /**
+    * @brief Verifica se un oggetto e' posseduto dalla scena.
+    */
+   bool owns(const void* object) const;
+
+private:
+   /** @brief Stacca ricorsivamente i figli non posseduti dalla scena. */
+   void detachForeign(Node* node);
+
+   /** @brief Memoria di tutti gli oggetti della scena. */
+   Arena arena;
+   /** @brief Radice del grafo. */
+   Node* root = nullptr;
+};
@@ -0,0 +1,59 @@
+#include "simulationClock.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file simulationClock.cpp
+ * @brief Implementazione della classe SimulationClock.
+ */
+
+SimulationClock::SimulationClock(double step, int maxStepsPerFrame, double maxFrameTime) {
+   configure(step, maxStepsPerFrame, maxFrameTime);
+}
+
+void SimulationClock::configure(double step, int maxStepsPerFrame, double maxFrameTime) {
+   this->step = std::max(step, 1e-6);
+   this->maxStepsPerFrame = std::max(maxStepsPerFrame, 1);
+   this->maxFrameTime = std::max(maxFrameTime, this->step);
+}
+
+int SimulationClock::advance(double frameTime, const StepCallback& callback) {
+   frameTime = std::max(frameTime, 0.0);
+   if (frameTime > maxFrameTime) {
+      dropped += frameTime - maxFrameTime;
+      frameTime = maxFrameTime;
+   }
+   accumulator += frameTime;
+
+   int executed = 0;
+   while (accumulator >= step && executed < maxStepsPerFrame) {
+      if (callback) callback(step);
+      accumulator -= step;
+      executed++;
+   }
+   steps += executed;
+
+   // Il ritardo oltre il limite di passi si scarta: resta solo la frazione di passo
+   if (accumulator >= step) {
+      double excess = accumulator - std::fmod(accumulator, step);
+      dropped += excess;
+      accumulator -= excess;
+   }
+   return executed;
+}
+
+double SimulationClock::getAlpha() const { return accumulator / step; }
+
+double SimulationClock::getTime() const { return steps * step; }
+
+unsigned long long SimulationClock::getStepCount() const { return steps; }
+
+double SimulationClock::getDroppedTime() const { return dropped; }
+
+double SimulationClock::getStep() const { return step; }
+
+void SimulationClock::reset() {
+   accumulator = 0.0;
+   dropped = 0.0;
+   steps = 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file simulationClock.h
+ * @brief Orologio a passo fisso per la simulazione, indipendente dalla cadenza dei frame.
+ */
+#pragma once
+#include "libConfig.h"
+#include <functional>
+
+/**
+ * @class SimulationClock
+ * @brief Accumula il tempo reale dei frame e lo consuma in passi di durata fissa.
+ *
+ * Ogni frame advance() esegue tanti passi quanti ne entrano nel tempo accumulato: la simulazione
+ * avanza alla stessa velocita' a 30 o a 300 FPS e ogni passo costa sempre lo stesso. Il resto che non
+ * basta per un passo diventa getAlpha(), la frazione da usare per interpolare tra gli ultimi due stati
+ * quando si disegna. Se i frame rallentano troppo, due limiti evitano la spirale in cui recuperare il
+ * ritardo costa piu' del tempo disponibile: la durata massima considerata per un frame e il numero
+ * massimo di passi per frame; il tempo eccedente viene scartato (la simulazione rallenta).
+ */
+class ENG_API SimulationClock {
+public:
+   /** @brief Callback di un passo di simulazione. */
+   using StepCallback = std::function<void(double step)>;
+
+   /**
+    * @brief Crea un orologio.
+    * @param step Durata di un passo in secondi (predefinito 1/60).
+    * @param maxStepsPerFrame Passi massimi eseguiti in un solo advance().
+    * @param maxFrameTime Durata massima in secondi considerata per un singolo frame.
+    */
+   explicit SimulationClock(double step = 1.0 / 60.0, int maxStepsPerFrame = 5, double maxFrameTime = 0.25);
+
+   /**
+    * @brief Cambia passo e limiti di recupero (il tempo accumulato non viene perso).
+    */
+   void configure(double step, int maxStepsPerFrame, double maxFrameTime);
+
+   /**
+    * @brief Aggiunge il tempo di un frame ed esegue i passi dovuti.
+    * @param frameTime Tempo reale trascorso dal frame precedente, in secondi.
+    * @param callback Invocata una volta per passo con la durata del passo.
+    * @return Numero di passi eseguiti.
+    */
+   int advance(double frameTime, const StepCallback& callback);
+
+   /**
+    * @brief Frazione di passo accumulata e non ancora simulata, in [0, 1).
+    */
+   double getAlpha() const;
+
+   /**
+    * @brief Tempo simulato in secondi (passi eseguiti per la durata del passo).
+    */
+   double getTime() const;
+
+   /**
+    * @brief Numero totale di passi eseguiti.
+    */
+   unsigned long long getStepCount() const;
+
+   /**
+    * @brief Tempo scartato dai limiti di recupero dall'ultimo reset(), in secondi.
+    */
+   double getDroppedTime() const;
+
+   /**
+    * @brief Restituisce la durata di un passo.
+    */
+   double getStep() const;
+
+   /**
+    * @brief Azzera tempo accumulato, passi e contatori.
+    */
+   void reset();
+
+private:
+   double step;
+   int maxStepsPerFrame;
+   double maxFrameTime;
+   double accumulator = 0.0;
+   double dropped = 0.0;
+   unsigned long long steps = 0;
+};
@@ -6,7 +6,7 @@ SpotLight::SpotLight() : Light(), spotExponent(0.0f)
 {
 }
 
-SpotLight::SpotLight(const std::string& name, const glm::mat4& matrix,
+SpotLight::SpotLight(std::string_view name, const glm::mat4& matrix,
    const glm::vec3& ambient, const glm::vec3& diffuse,
    const glm::vec3& specular, const glm::vec3& dir,
    float cutoff, float exponent) 
@@ -59,27 +59,17 @@ float SpotLight::getSpotExponent() const
     return spotExponent;
 }
 
-void SpotLight::render()
+Light::Parameters SpotLight::getParameters() const
 {
-   Light::render();
+   Parameters parameters = Light::getParameters();
 
    // Usiamo (0,0,0,1) perch la ModelView Matrix (caricata dalla List)
    // ha gi spostato il "cursore" nel punto esatto della luce.
-   // se usassimo glm::value_ptr(position) sarebbe pi in alto
-   GLfloat zeroPos[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-   glLightfv(lightContextID, GL_POSITION, zeroPos);
-
-   
-   
-   glLightfv(lightContextID, GL_SPOT_DIRECTION, glm::value_ptr(direction));
+   parameters.position = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
    // Parametri Spot
-   glLightf(lightContextID, GL_SPOT_CUTOFF, cutoff);
-
-   glLightf(lightContextID, GL_SPOT_EXPONENT, 0.0f);
-
-   // Attenuazione (standard)
-   glLightf(lightContextID, GL_CONSTANT_ATTENUATION, 1.0f);
-   glLightf(lightContextID, GL_LINEAR_ATTENUATION, 0.0f);
-   glLightf(lightContextID, GL_QUADRATIC_ATTENUATION, 0.0f);
+   parameters.spotDirection = direction;
+   parameters.spotCutoff = cutoff;
+   parameters.spotExponent = 0.0f;
+   return parameters;
 }
\ No newline at end of file
@@ -23,7 +23,7 @@ public:
      * @param cutoff Angolo di apertura del cono di luce.
      * @param exponent Fattore di attenuazione angolare della luce all'interno del cono.
      */
-    SpotLight(const std::string& name, const glm::mat4& matrix,
+    SpotLight(std::string_view name, const glm::mat4& matrix,
        const glm::vec3& ambient, const glm::vec3& diffuse,
        const glm::vec3& specular, const glm::vec3& direction,
        float cutoff, float exponent);
@@ -65,9 +65,9 @@ public:
     float getSpotExponent() const;
 
     /**
-     * @brief Esegue il rendering della luce spot nella scena.
+     * @brief Aggiunge ai parametri comuni quelli specifici di questo tipo di luce.
      */
-    void render() override;
+    Parameters getParameters() const override;
 
 private:
    /** @brief Angolo che definisce l'ampiezza massima del cono di luce. */
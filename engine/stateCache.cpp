@@ -0,0 +1,258 @@
+#include "stateCache.h"
+#include <GL/freeglut.h>
+#include <glm/gtc/type_ptr.hpp>
+
+/**
+ * @file stateCache.cpp
+ * @brief Implementazione della cache dello stato OpenGL.
+ */
+
+namespace {
+   // Valore tri-stato: lo stato iniziale e' sconosciuto finche' non viene impostato dal motore
+   enum class Known : signed char { UNKNOWN = -1, OFF = 0, ON = 1 };
+
+   /** @brief Numero massimo di capability tracciate (le altre vengono sempre inoltrate). */
+   constexpr int MAX_CAPS = 32;
+
+   struct CapEntry {
+      unsigned int cap;
+      Known state;
+   };
+
+   struct CacheState {
+      CapEntry caps[MAX_CAPS];
+      int numCaps = 0;
+
+      bool textureKnown = false;
+      unsigned int boundTexture = 0;
+
+      // GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_EMISSION
+      bool materialKnown[4] = { false, false, false, false };
+      glm::vec4 material[4];
+      bool shininessKnown = false;
+      float shininess = 0.0f;
+
+      bool texEnvKnown = false;
+      int texEnv = 0;
+
+      Known depthMask = Known::UNKNOWN;
+
+      bool blendKnown = false;
+      unsigned int blendSrc = 0, blendDst = 0;
+
+      bool frontFaceKnown = false;
+      unsigned int frontFace = 0;
+
+      Known colorMask = Known::UNKNOWN;
+
+      bool stencilFuncKnown = false;
+      unsigned int stencilFunc = 0, stencilMask = 0;
+      int stencilRef = 0;
+
+      bool stencilOpKnown = false;
+      unsigned int stencilOp[3] = { 0, 0, 0 };
+
+      StateCache::Stats current;
+      StateCache::Stats last;
+   };
+
+   CacheState& state() {
+      static CacheState s;
+      return s;
+   }
+
+   CapEntry* findCap(unsigned int cap) {
+      CacheState& s = state();
+      for (int i = 0; i < s.numCaps; i++)
+         if (s.caps[i].cap == cap) return &s.caps[i];
+      if (s.numCaps < MAX_CAPS) {
+         s.caps[s.numCaps] = { cap, Known::UNKNOWN };
+         return &s.caps[s.numCaps++];
+      }
+      return nullptr;
+   }
+
+   int materialSlot(unsigned int pname) {
+      switch (pname) {
+      case GL_AMBIENT:  return 0;
+      case GL_DIFFUSE:  return 1;
+      case GL_SPECULAR: return 2;
+      case GL_EMISSION: return 3;
+      default:          return -1;
+      }
+   }
+
+   inline void skip() { state().current.skipped++; }
+   inline void issue() { state().current.issued++; }
+}
+
+void StateCache::set(unsigned int cap, bool enabled) {
+   CapEntry* entry = findCap(cap);
+   Known wanted = enabled ? Known::ON : Known::OFF;
+   if (entry && entry->state == wanted) {
+      skip();
+      return;
+   }
+   if (enabled) glEnable(cap);
+   else         glDisable(cap);
+   if (entry) entry->state = wanted;
+   issue();
+}
+
+void StateCache::enable(unsigned int cap) { set(cap, true); }
+void StateCache::disable(unsigned int cap) { set(cap, false); }
+
+void StateCache::bindTexture2D(unsigned int textureId) {
+   CacheState& s = state();
+   if (s.textureKnown && s.boundTexture == textureId) {
+      skip();
+      return;
+   }
+   glBindTexture(GL_TEXTURE_2D, textureId);
+   s.textureKnown = true;
+   s.boundTexture = textureId;
+   issue();
+}
+
+void StateCache::forgetTexture(unsigned int textureId) {
+   CacheState& s = state();
+   // glDeleteTextures riporta a 0 il binding se la texture era attiva
+   if (s.textureKnown && s.boundTexture == textureId)
+      s.boundTexture = 0;
+}
+
+void StateCache::material(unsigned int pname, const glm::vec4& value) {
+   CacheState& s = state();
+   int slot = materialSlot(pname);
+   if (slot >= 0 && s.materialKnown[slot] && s.material[slot] == value) {
+      skip();
+      return;
+   }
+   glMaterialfv(GL_FRONT_AND_BACK, pname, glm::value_ptr(value));
+   if (slot >= 0) {
+      s.materialKnown[slot] = true;
+      s.material[slot] = value;
+   }
+   issue();
+}
+
+void StateCache::materialShininess(float shininess) {
+   CacheState& s = state();
+   if (s.shininessKnown && s.shininess == shininess) {
+      skip();
+      return;
+   }
+   glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, shininess);
+   s.shininessKnown = true;
+   s.shininess = shininess;
+   issue();
+}
+
+void StateCache::texEnvMode(int mode) {
+   CacheState& s = state();
+   if (s.texEnvKnown && s.texEnv == mode) {
+      skip();
+      return;
+   }
+   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, mode);
+   s.texEnvKnown = true;
+   s.texEnv = mode;
+   issue();
+}
+
+void StateCache::depthMask(bool enabled) {
+   CacheState& s = state();
+   Known wanted = enabled ? Known::ON : Known::OFF;
+   if (s.depthMask == wanted) {
+      skip();
+      return;
+   }
+   glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+   s.depthMask = wanted;
+   issue();
+}
+
+void StateCache::blendFunc(unsigned int src, unsigned int dst) {
+   CacheState& s = state();
+   if (s.blendKnown && s.blendSrc == src && s.blendDst == dst) {
+      skip();
+      return;
+   }
+   glBlendFunc(src, dst);
+   s.blendKnown = true;
+   s.blendSrc = src;
+   s.blendDst = dst;
+   issue();
+}
+
+void StateCache::frontFace(unsigned int mode) {
+   CacheState& s = state();
+   if (s.frontFaceKnown && s.frontFace == mode) {
+      skip();
+      return;
+   }
+   glFrontFace(mode);
+   s.frontFaceKnown = true;
+   s.frontFace = mode;
+   issue();
+}
+
+void StateCache::colorMask(bool enabled) {
+   CacheState& s = state();
+   Known wanted = enabled ? Known::ON : Known::OFF;
+   if (s.colorMask == wanted) {
+      skip();
+      return;
+   }
+   GLboolean flag = enabled ? GL_TRUE : GL_FALSE;
+   glColorMask(flag, flag, flag, flag);
+   s.colorMask = wanted;
+   issue();
+}
+
+void StateCache::stencilFunc(unsigned int func, int ref, unsigned int mask) {
+   CacheState& s = state();
+   if (s.stencilFuncKnown && s.stencilFunc == func && s.stencilRef == ref && s.stencilMask == mask) {
+      skip();
+      return;
+   }
+   glStencilFunc(func, ref, mask);
+   s.stencilFuncKnown = true;
+   s.stencilFunc = func;
+   s.stencilRef = ref;
+   s.stencilMask = mask;
+   issue();
+}
+
+void StateCache::stencilOp(unsigned int sfail, unsigned int dpfail, unsigned int dppass) {
+   CacheState& s = state();
+   if (s.stencilOpKnown && s.stencilOp[0] == sfail && s.stencilOp[1] == dpfail && s.stencilOp[2] == dppass) {
+      skip();
+      return;
+   }
+   glStencilOp(sfail, dpfail, dppass);
+   s.stencilOpKnown = true;
+   s.stencilOp[0] = sfail;
+   s.stencilOp[1] = dpfail;
+   s.stencilOp[2] = dppass;
+   issue();
+}
+
+void StateCache::invalidate() {
+   CacheState& s = state();
+   Stats current = s.current;
+   Stats last = s.last;
+   s = CacheState();
+   // I contatori sopravvivono all'invalidazione
+   s.current = current;
+   s.last = last;
+}
+
+void StateCache::endFrame() {
+   CacheState& s = state();
+   s.last = s.current;
+   s.current = Stats();
+}
+
+StateCache::Stats StateCache::getFrameStats() { return state().current; }
+StateCache::Stats StateCache::getLastFrameStats() { return state().last; }
@@ -0,0 +1,141 @@
+/**
+ * @file stateCache.h
+ * @brief Cache dello stato OpenGL fixed-function condivisa da tutto il motore.
+ */
+#pragma once
+#include "libConfig.h"
+#include <glm/glm.hpp>
+
+/**
+ * @class StateCache
+ * @brief Filtra le chiamate di stato OpenGL ridondanti (glEnable/glDisable, glBindTexture, glMaterial...).
+ *
+ * Tutti i metodi di rendering del motore passano da questa classe invece di chiamare OpenGL direttamente:
+ * la chiamata viene emessa solo se il valore richiesto differisce da quello gia' impostato.
+ * Per ogni frame vengono contate le chiamate emesse e quelle scartate.
+ * Se il client modifica lo stato OpenGL direttamente deve invocare invalidate().
+ */
+class ENG_API StateCache {
+public:
+   /**
+    * @struct Stats
+    * @brief Contatori delle chiamate di stato di un frame.
+    */
+   struct Stats {
+      /** @brief Chiamate effettivamente inoltrate a OpenGL. */
+      unsigned int issued = 0;
+      /** @brief Chiamate scartate perche' ridondanti. */
+      unsigned int skipped = 0;
+   };
+
+   /**
+    * @brief Abilita una capability OpenGL (glEnable) se non e' gia' attiva.
+    * @param cap Capability da abilitare (es. GL_LIGHTING).
+    */
+   static void enable(unsigned int cap);
+
+   /**
+    * @brief Disabilita una capability OpenGL (glDisable) se non e' gia' disattiva.
+    * @param cap Capability da disabilitare.
+    */
+   static void disable(unsigned int cap);
+
+   /**
+    * @brief Imposta una capability allo stato richiesto.
+    * @param cap Capability da modificare.
+    * @param enabled True per abilitarla, False per disabilitarla.
+    */
+   static void set(unsigned int cap, bool enabled);
+
+   /**
+    * @brief Collega una texture 2D (glBindTexture) se non e' gia' quella attiva.
+    * @param textureId Identificativo OpenGL della texture (0 per nessuna).
+    */
+   static void bindTexture2D(unsigned int textureId);
+
+   /**
+    * @brief Segnala che una texture e' stata distrutta (OpenGL torna al binding 0 se era attiva).
+    * @param textureId Identificativo della texture eliminata.
+    */
+   static void forgetTexture(unsigned int textureId);
+
+   /**
+    * @brief Imposta un parametro vettoriale del materiale per entrambe le facce (glMaterialfv).
+    * @param pname Parametro: GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR o GL_EMISSION.
+    * @param value Valore RGBA.
+    */
+   static void material(unsigned int pname, const glm::vec4& value);
+
+   /**
+    * @brief Imposta la brillantezza del materiale per entrambe le facce (glMaterialf GL_SHININESS).
+    * @param shininess Esponente speculare.
+    */
+   static void materialShininess(float shininess);
+
+   /**
+    * @brief Imposta la modalita' di combinazione della texture (GL_TEXTURE_ENV_MODE).
+    * @param mode Modalita' (es. GL_MODULATE).
+    */
+   static void texEnvMode(int mode);
+
+   /**
+    * @brief Abilita o disabilita la scrittura nel depth buffer (glDepthMask).
+    * @param enabled True per abilitare la scrittura.
+    */
+   static void depthMask(bool enabled);
+
+   /**
+    * @brief Imposta la funzione di blending (glBlendFunc).
+    * @param src Fattore sorgente.
+    * @param dst Fattore destinazione.
+    */
+   static void blendFunc(unsigned int src, unsigned int dst);
+
+   /**
+    * @brief Imposta l'orientamento delle facce frontali (glFrontFace).
+    * @param mode GL_CCW oppure GL_CW.
+    */
+   static void frontFace(unsigned int mode);
+
+   /**
+    * @brief Abilita o disabilita la scrittura di tutti i canali colore (glColorMask).
+    * @param enabled True per scrivere il colore.
+    */
+   static void colorMask(bool enabled);
+
+   /**
+    * @brief Imposta il test dello stencil (glStencilFunc).
+    * @param func Funzione di confronto (GL_ALWAYS, GL_EQUAL...).
+    * @param ref Valore di riferimento.
+    * @param mask Maschera applicata a riferimento e valore memorizzato.
+    */
+   static void stencilFunc(unsigned int func, int ref, unsigned int mask);
+
+   /**
+    * @brief Imposta le operazioni sullo stencil buffer (glStencilOp).
+    * @param sfail Azione se fallisce il test dello stencil.
+    * @param dpfail Azione se fallisce il test di profondita'.
+    * @param dppass Azione se passano entrambi i test.
+    */
+   static void stencilOp(unsigned int sfail, unsigned int dpfail, unsigned int dppass);
+
+   /**
+    * @brief Dimentica tutto lo stato conosciuto: la chiamata successiva di ogni tipo verra' sempre emessa.
+    */
+   static void invalidate();
+
+   /**
+    * @brief Chiude il frame corrente: salva i contatori e li azzera.
+    */
+   static void endFrame();
+
+   /**
+    * @brief Restituisce i contatori del frame in corso.
+    */
+   static Stats getFrameStats();
+
+   /**
+    * @brief Restituisce i contatori dell'ultimo frame completato.
+    */
+   static Stats getLastFrameStats();
+};
@@ -0,0 +1,164 @@
+#include "textRenderer.h"
+#include "stateCache.h"
+#include <GL/freeglut.h>
+#include <algorithm>
+
+/**
+ * @file textRenderer.cpp
+ * @brief Implementazione del testo con atlante di glifi.
+ */
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+namespace {
+   /** @brief Texel vuoti tra glifi vicini. */
+   constexpr int PADDING = 1;
+}
+
+TextRenderer::TextRenderer() : atlasHeight(0), atlasId(0) { layout(); }
+
+TextRenderer::~TextRenderer() {
+   // Il contesto potrebbe non esistere piu': la texture va liberata con free()
+}
+
+const BitmapFont& TextRenderer::getFont(Font font) {
+   return font == Font::TIMES_ROMAN_24 ? BitmapFont::timesRoman24() : BitmapFont::fixed8x13();
+}
+
+int TextRenderer::getTextWidth(Font font, const std::string& text) { return getFont(font).getTextWidth(text); }
+
+void TextRenderer::layout() {
+   // Righe alte quanto il font, riempite da sinistra: le posizioni non dipendono dal contesto
+   int x = 0, y = 0, rowHeight = 0;
+   for (int f = 0; f < NUM_FONTS; f++) {
+      const BitmapFont& font = getFont((Font)f);
+      for (int i = 0; i < BitmapFont::NUM_CHARS; i++) {
+         int width = font.getAdvance((unsigned char)(BitmapFont::FIRST_CHAR + i));
+         if (x + width > ATLAS_WIDTH) {
+            x = 0;
+            y += rowHeight + PADDING;
+            rowHeight = 0;
+         }
+         glyphs[f][i].x = x;
+         glyphs[f][i].y = y;
+         x += width + PADDING;
+         rowHeight = std::max(rowHeight, font.getHeight());
+      }
+   }
+   atlasHeight = 1;
+   while (atlasHeight < y + rowHeight) atlasHeight *= 2;
+}
+
+bool TextRenderer::init() {
+   if (atlasId) return true;
+
+   std::vector<unsigned char> texels((size_t)ATLAS_WIDTH * atlasHeight, 0);
+   for (int f = 0; f < NUM_FONTS; f++) {
+      const BitmapFont& font = getFont((Font)f);
+      for (int i = 0; i < BitmapFont::NUM_CHARS; i++) {
+         unsigned char c = (unsigned char)(BitmapFont::FIRST_CHAR + i);
+         for (int y = 0; y < font.getHeight(); y++)
+            for (int x = 0; x < font.getAdvance(c); x++)
+               if (font.getPixel(c, x, y)) texels[(size_t)(glyphs[f][i].y + y) * ATLAS_WIDTH + glyphs[f][i].x + x] = 255;
+      }
+   }
+
+   glGenTextures(1, &atlasId);
+   if (!atlasId) return false;
+   StateCache::bindTexture2D(atlasId);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_WIDTH, atlasHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, texels.data());
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+   StateCache::bindTexture2D(0);
+   return true;
+}
+
+void TextRenderer::free() {
+   if (!atlasId) return;
+   glDeleteTextures(1, &atlasId);
+   StateCache::forgetTexture(atlasId);
+   atlasId = 0;
+}
+
+bool TextRenderer::isReady() const { return atlasId != 0; }
+
+void TextRenderer::add(Font font, float x, float y, const std::string& text, const glm::vec4& color) {
+   append(font, x, y, text, color, vertices);
+}
+
+void TextRenderer::append(Font font, float x, float y, const std::string& text, const glm::vec4& color, std::vector<float>& out) const {
+   const BitmapFont& data = getFont(font);
+   const Glyph* fontGlyphs = glyphs[(int)font];
+   float height = (float)data.getHeight();
+   float penX = x - data.getOriginX();
+   float bottom = y - data.getOriginY();
+
+   for (unsigned char c : text) {
+      if (!data.hasGlyph(c)) continue;
+      const Glyph& glyph = fontGlyphs[c - BitmapFont::FIRST_CHAR];
+      float width = (float)data.getAdvance(c);
+
+      float u0 = (float)glyph.x / ATLAS_WIDTH;
+      float u1 = (glyph.x + width) / ATLAS_WIDTH;
+      float v0 = (float)glyph.y / atlasHeight;
+      float v1 = (glyph.y + height) / atlasHeight;
+      const float quad[4][4] = {
+         { penX,         bottom,          u0, v0 },
+         { penX + width, bottom,          u1, v0 },
+         { penX + width, bottom + height, u1, v1 },
+         { penX,         bottom + height, u0, v1 },
+      };
+      for (const auto& corner : quad) {
+         out.insert(out.end(), corner, corner + 4);
+         out.insert(out.end(), { color.r, color.g, color.b, color.a });
+      }
+      penX += width;
+   }
+}
+
+unsigned int TextRenderer::getQuadCount() const { return (unsigned int)(vertices.size() / (FLOATS_PER_VERTEX * 4)); }
+
+void TextRenderer::draw() {
+   draw(vertices);
+   vertices.clear();
+}
+
+void TextRenderer::draw(const std::vector<float>& batch) const {
+   if (!atlasId || batch.empty()) return;
+
+   StateCache::enable(GL_TEXTURE_2D);
+   StateCache::bindTexture2D(atlasId);
+   StateCache::texEnvMode(GL_MODULATE);
+   StateCache::enable(GL_ALPHA_TEST);
+   glAlphaFunc(GL_GREATER, 0.5f);
+
+   const GLsizei stride = FLOATS_PER_VERTEX * sizeof(float);
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, stride, batch.data());
+   glTexCoordPointer(2, GL_FLOAT, stride, batch.data() + 2);
+   glColorPointer(4, GL_FLOAT, stride, batch.data() + 4);
+   glDrawArrays(GL_QUADS, 0, (GLsizei)(batch.size() / FLOATS_PER_VERTEX));
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+
+   // Dopo un array di colori il colore corrente non e' definito
+   glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+   StateCache::disable(GL_ALPHA_TEST);
+   StateCache::disable(GL_TEXTURE_2D);
+}
+
+void TextRenderer::clear() { vertices.clear(); }
+
+unsigned int TextRenderer::getAtlasId() const { return atlasId; }
+
+int TextRenderer::getAtlasHeight() const { return atlasHeight; }
@@ -0,0 +1,139 @@
+/**
+ * @file textRenderer.h
+ * @brief Testo a schermo da un atlante di glifi, disegnato con una sola chiamata per frame.
+ */
+#pragma once
+#include "libConfig.h"
+#include "bitmapFont.h"
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class TextRenderer
+ * @brief Accumula il testo di un frame come quadrilateri texturizzati e lo disegna in un'unica draw call.
+ *
+ * glutBitmapString() esegue un glBitmap() per ogni carattere, molto lento soprattutto con i driver
+ * software. Qui i font vengono rasterizzati una volta sola in un atlante (texture GL_ALPHA) e ogni
+ * carattere diventa un quadrilatero con le coordinate del proprio glifo: tutto il testo del frame,
+ * di qualunque font e colore, parte con un solo glDrawArrays(). Il filtro GL_NEAREST e l'alpha test
+ * riproducono esattamente i pixel di glBitmap() in una proiezione ortogonale a pixel interi.
+ *
+ * @note Le coordinate sono quelle della proiezione corrente (in Eng::Base la camera UI, in pixel con
+ * l'origine in basso a sinistra); (x, y) e' la linea di base all'inizio della stringa, come per
+ * glRasterPos2f(). add() e getTextWidth() non richiedono un contesto OpenGL.
+ */
+class ENG_API TextRenderer {
+public:
+   /**
+    * @brief Font disponibili.
+    */
+   enum class Font {
+      FIXED_8_BY_13,  ///< Spaziatura fissa 8x13 (menu, statistiche).
+      TIMES_ROMAN_24  ///< Proporzionale Times Roman 24 (messaggi).
+   };
+
+   /** @brief Valori float per vertice (posizione, coordinate nell'atlante, colore). */
+   static constexpr int FLOATS_PER_VERTEX = 8;
+   /** @brief Numero di font nell'atlante. */
+   static constexpr int NUM_FONTS = 2;
+   /** @brief Larghezza dell'atlante in texel. */
+   static constexpr int ATLAS_WIDTH = 256;
+
+   TextRenderer();
+   ~TextRenderer();
+   TextRenderer(const TextRenderer&) = delete;
+   TextRenderer& operator=(const TextRenderer&) = delete;
+
+   /**
+    * @brief Rasterizza i font nell'atlante e crea la texture (richiede un contesto attivo).
+    * @return False se la texture non puo' essere creata.
+    */
+   bool init();
+
+   /**
+    * @brief Elimina la texture (richiede il contesto ancora attivo).
+    */
+   void free();
+
+   /**
+    * @brief Indica se l'atlante e' pronto.
+    */
+   bool isReady() const;
+
+   /**
+    * @brief Restituisce i dati di un font.
+    */
+   static const BitmapFont& getFont(Font font);
+
+   /**
+    * @brief Larghezza in pixel di una stringa, dalle metriche dei glifi.
+    */
+   static int getTextWidth(Font font, const std::string& text);
+
+   /**
+    * @brief Accoda una stringa al lotto del frame.
+    * @param font Font da usare.
+    * @param x Inizio della linea di base.
+    * @param y Linea di base.
+    * @param text Testo (i caratteri senza glifo vengono ignorati).
+    * @param color Colore RGBA.
+    */
+   void add(Font font, float x, float y, const std::string& text, const glm::vec4& color);
+
+   /**
+    * @brief Come add(), ma scrive i vertici in un array esterno (geometria conservata tra i frame, es. Hud).
+    * @param out Riceve i vertici in coda: x, y, u, v, r, g, b, a per ogni vertice, 4 vertici per carattere.
+    */
+   void append(Font font, float x, float y, const std::string& text, const glm::vec4& color, std::vector<float>& out) const;
+
+   /**
+    * @brief Numero di caratteri accodati.
+    */
+   unsigned int getQuadCount() const;
+
+   /**
+    * @brief Disegna il lotto con una sola draw call e lo svuota.
+    *
+    * Usa la texture 2D con GL_MODULATE e l'alpha test; illuminazione e profondita' vanno disattivate
+    * dal chiamante. Lascia GL_TEXTURE_2D e GL_ALPHA_TEST disattivati.
+    */
+   void draw();
+
+   /**
+    * @brief Disegna con una sola draw call vertici preparati con append(), senza modificarli.
+    * @param batch Vertici da disegnare.
+    */
+   void draw(const std::vector<float>& batch) const;
+
+   /**
+    * @brief Svuota il lotto senza disegnarlo.
+    */
+   void clear();
+
+   /**
+    * @brief Identificativo OpenGL dell'atlante (0 prima di init()).
+    */
+   unsigned int getAtlasId() const;
+
+   /**
+    * @brief Altezza dell'atlante in texel (potenza di due).
+    */
+   int getAtlasHeight() const;
+
+private:
+   /** @brief Posizione di un glifo nell'atlante, in texel. */
+   struct Glyph {
+      int x = 0;
+      int y = 0;
+   };
+
+   /** @brief Dispone i glifi su righe dell'atlante e ne calcola l'altezza. */
+   void layout();
+
+   Glyph glyphs[NUM_FONTS][BitmapFont::NUM_CHARS];
+   int atlasHeight;
+   unsigned int atlasId;
+   /** @brief Vertici del lotto: x, y, u, v, r, g, b, a. */
+   std::vector<float> vertices;
+};
@@ -1,14 +1,15 @@
 #include "texture.h"
 #include <GL/freeglut.h>
 #include "FreeImage.h"
+#include "stateCache.h"
 #include <iostream>
 
-Texture::Texture(const std::string& name, const std::string& filepath)
+Texture::Texture(std::string_view name, const std::string& filepath)
    : Object(name), m_filepath(filepath), m_texId(0)
 {
    // 1. Genera un ID texture OpenGL
    glGenTextures(1, &m_texId);
-   glBindTexture(GL_TEXTURE_2D, m_texId);
+   StateCache::bindTexture2D(m_texId);
 
    // 2. Carica l'immagine con FreeImage
    // Determina il formato (JPEG, PNG, BMP...)
@@ -63,13 +64,19 @@ Texture::Texture(const std::string& name, const std::string& filepath)
    }
 
    // Slega la texture
-   glBindTexture(GL_TEXTURE_2D, 0);
+   StateCache::bindTexture2D(0);
 }
 Texture::~Texture() {
-	if (m_texId != 0)
+	if (m_texId != 0) {
 		glDeleteTextures(1, &m_texId);
+		StateCache::forgetTexture(m_texId);
+	}
 }
+unsigned int Texture::getTexId() const { return m_texId; }
+
+const std::string& Texture::getFilePath() const { return m_filepath; }
+
 void Texture::render() {
 	if (m_texId != 0)
-		glBindTexture(GL_TEXTURE_2D, m_texId);
+		StateCache::bindTexture2D(m_texId);
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ public:
 	 * @brief Carica e inizializza una texture da file.
 	 * @param filepath Percorso del file immagine da caricare.
 	 */
-	Texture(const std::string& name, const std::string& filepath); // Updated constructor to take filepath
+	Texture(std::string_view name, const std::string& filepath); // Updated constructor to take filepath
 
 	/**
 	 * @brief Distruttore della classe.
@@ -28,6 +28,16 @@ public:
 	 * @brief Attiva la texture per l'uso nel rendering corrente.
 	 */
 	void render() override;
+
+	/**
+	 * @brief Restituisce l'identificativo OpenGL della texture (0 se il caricamento e' fallito).
+	 */
+	unsigned int getTexId() const;
+
+	/**
+	 * @brief Restituisce il percorso del file da cui e' stata caricata la texture.
+	 */
+	const std::string& getFilePath() const;
 private:
 	/** @brief Percorso del file sorgente dell'immagine. */
 	std::string m_filepath;
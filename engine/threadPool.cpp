@@ -0,0 +1,71 @@
+#include "threadPool.h"
+#include <algorithm>
+
+/**
+ * @file threadPool.cpp
+ * @brief Implementazione del pool di thread persistenti.
+ */
+
+ThreadPool::ThreadPool() {}
+
+ThreadPool::~ThreadPool() {
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+   }
+   wake.notify_all();
+   for (std::thread& worker : workers) worker.join();
+}
+
+unsigned int ThreadPool::run(unsigned int numThreads, const std::function<void()>& job) {
+   if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+   if (numThreads == 1) {
+      job();
+      return 1;
+   }
+
+   std::lock_guard<std::mutex> runLock(runMutex);
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (workers.size() < numThreads - 1) {
+         unsigned int index = (unsigned int)workers.size();
+         workers.emplace_back([this, index]() { workerLoop(index); });
+      }
+      task = &job;
+      participants = numThreads - 1;
+      pending = participants;
+      generation++;
+   }
+   wake.notify_all();
+
+   job();
+
+   std::unique_lock<std::mutex> lock(mutex);
+   done.wait(lock, [this]() { return pending == 0; });
+   task = nullptr;
+   return numThreads;
+}
+
+void ThreadPool::workerLoop(unsigned int index) {
+   uint64_t seen = 0;
+   std::unique_lock<std::mutex> lock(mutex);
+   while (true) {
+      wake.wait(lock, [&]() { return stopping || generation != seen; });
+      if (stopping) return;
+      seen = generation;
+      if (index >= participants) continue;
+
+      const std::function<void()>* job = task;
+      lock.unlock();
+      (*job)();
+      lock.lock();
+      if (--pending == 0) done.notify_one();
+   }
+}
+
+unsigned int ThreadPool::getNumWorkers() const { return (unsigned int)workers.size(); }
+
+ThreadPool& ThreadPool::getShared() {
+   static ThreadPool pool;
+   return pool;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file threadPool.h
+ * @brief Thread di lavoro persistenti per le elaborazioni parallele del frame.
+ */
+#pragma once
+#include "libConfig.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Insieme di thread creati una volta e riusati a ogni frame, invece di crearne di nuovi a ogni chiamata.
+ *
+ * run() esegue la stessa funzione su piu' thread contemporaneamente (il chiamante compreso) e
+ * ritorna quando tutti hanno finito; la suddivisione del lavoro spetta alla funzione, di solito con
+ * un contatore atomico da cui ogni thread prende l'unita' successiva finche' ce ne sono. I thread
+ * mancanti vengono creati alla prima richiesta e poi restano in attesa su una variabile di condizione.
+ *
+ * @note Le chiamate a run() da thread diversi vengono eseguite una alla volta; la funzione non deve
+ * chiamare run() sullo stesso pool.
+ */
+class ENG_API ThreadPool {
+public:
+   /**
+    * @brief Crea un pool vuoto: i thread nascono con la prima run() che li richiede.
+    */
+   ThreadPool();
+
+   /**
+    * @brief Ferma e attende tutti i thread.
+    */
+   ~ThreadPool();
+
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   /**
+    * @brief Esegue @p task su @p numThreads thread, compreso il chiamante, e attende che finiscano.
+    * @param numThreads Thread da usare (0 = tutti i core disponibili).
+    * @param task Funzione eseguita una volta da ogni thread.
+    * @return Numero di thread usati.
+    */
+   unsigned int run(unsigned int numThreads, const std::function<void()>& task);
+
+   /**
+    * @brief Numero di thread di lavoro creati finora (escluso il chiamante).
+    */
+   unsigned int getNumWorkers() const;
+
+   /**
+    * @brief Pool condiviso dal motore (List::passParallel() e simili).
+    */
+   static ThreadPool& getShared();
+
+private:
+   void workerLoop(unsigned int index);
+
+   std::vector<std::thread> workers;
+   /** @brief Serializza le chiamate a run(). */
+   std::mutex runMutex;
+   std::mutex mutex;
+   std::condition_variable wake;
+   std::condition_variable done;
+   /** @brief Incrementata a ogni run(): i thread in attesa riconoscono il nuovo lavoro. */
+   uint64_t generation = 0;
+   /** @brief Thread di lavoro che partecipano alla run() corrente (quelli con indice minore). */
+   unsigned int participants = 0;
+   /** @brief Partecipanti che non hanno ancora finito. */
+   unsigned int pending = 0;
+   const std::function<void()>* task = nullptr;
+   bool stopping = false;
+};
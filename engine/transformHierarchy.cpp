@@ -0,0 +1,158 @@
+#include "transformHierarchy.h"
+#include "node.h"
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ENG_TRANSFORM_SSE 1
+#endif
+
+/**
+ * @file transformHierarchy.cpp
+ * @brief Implementazione della classe TransformHierarchy.
+ */
+
+TransformHierarchy::TransformHierarchy() {}
+
+TransformHierarchy::~TransformHierarchy() { clear(); }
+
+void TransformHierarchy::multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+#ifdef ENG_TRANSFORM_SSE
+   // Matrici column-major: ogni colonna del risultato e' una combinazione delle colonne di a
+   const float* pa = &a[0][0];
+   const float* pb = &b[0][0];
+   float* po = &out[0][0];
+   __m128 a0 = _mm_loadu_ps(pa);
+   __m128 a1 = _mm_loadu_ps(pa + 4);
+   __m128 a2 = _mm_loadu_ps(pa + 8);
+   __m128 a3 = _mm_loadu_ps(pa + 12);
+   for (int col = 0; col < 4; col++) {
+      const float* bc = pb + col * 4;
+      __m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+      r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+      r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+      r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+      _mm_storeu_ps(po + col * 4, r);
+   }
+#else
+   out = a * b;
+#endif
+}
+
+void TransformHierarchy::build(Node* newRoot) {
+   clear();
+   if (!newRoot) return;
+
+   root = newRoot;
+   append(newRoot, -1);
+
+   world.resize(local.size());
+   dirty.assign(local.size(), 1);
+   firstDirty = 0;
+   pending = true;
+   structureDirty = false;
+}
+
+void TransformHierarchy::append(Node* node, int32_t parentIndex) {
+   int32_t index = (int32_t)local.size();
+   node->hierarchy = this;
+   node->transformIndex = index;
+
+   local.push_back(node->getM());
+   parent.push_back(parentIndex);
+   nodes.push_back(node);
+
+   for (unsigned int i = 0; i < node->getNumChildren(); i++)
+      append(node->getChild(i), index);
+}
+
+void TransformHierarchy::unbindAll() {
+   for (Node* node : nodes) {
+      if (!node) continue;
+      node->hierarchy = nullptr;
+      node->transformIndex = -1;
+      node->worldDirty = true;
+   }
+   local.clear();
+   world.clear();
+   parent.clear();
+   dirty.clear();
+   nodes.clear();
+   pending = false;
+   firstDirty = 0;
+}
+
+void TransformHierarchy::clear() {
+   unbindAll();
+   root = nullptr;
+   structureDirty = false;
+}
+
+void TransformHierarchy::update() {
+   if (structureDirty) build(root);
+   lastUpdateCount = 0;
+   if (!pending) return;
+
+   const size_t count = local.size();
+   for (size_t i = firstDirty; i < count; i++) {
+      int32_t p = parent[i];
+      if (p < 0) {
+         if (!dirty[i]) continue;
+         // Radice: il genitore (se c'e') e' esterno alla gerarchia
+         Node* outer = nodes[i] ? nodes[i]->getParent() : nullptr;
+         if (outer) multiply(outer->getWorldFinalMatrix(), local[i], world[i]);
+         else world[i] = local[i];
+         lastUpdateCount++;
+         continue;
+      }
+      // Il genitore precede sempre il figlio: la modifica si propaga nella stessa passata
+      if (dirty[p]) dirty[i] = 1;
+      if (dirty[i]) {
+         multiply(world[p], local[i], world[i]);
+         lastUpdateCount++;
+      }
+   }
+
+   std::fill(dirty.begin() + firstDirty, dirty.end(), (uint8_t)0);
+   firstDirty = count;
+   pending = false;
+}
+
+const std::vector<Node*>& TransformHierarchy::getNodes() const { return nodes; }
+
+const std::vector<glm::mat4>& TransformHierarchy::getWorldMatrices() const { return world; }
+
+void TransformHierarchy::setLocal(int index, const glm::mat4& matrix) {
+   local[index] = matrix;
+   markDirty(index);
+}
+
+void TransformHierarchy::markDirty(int index) {
+   dirty[index] = 1;
+   if (!pending || (size_t)index < firstDirty) firstDirty = index;
+   pending = true;
+}
+
+void TransformHierarchy::invalidateStructure() { structureDirty = true; }
+
+void TransformHierarchy::detachNode(Node* node) {
+   if (node->transformIndex >= 0 && (size_t)node->transformIndex < nodes.size())
+      nodes[node->transformIndex] = nullptr;
+   node->hierarchy = nullptr;
+   node->transformIndex = -1;
+
+   if (node == root) {
+      // Senza radice la gerarchia non ha piu' senso: i nodi rimasti tornano indipendenti
+      clear();
+      return;
+   }
+   invalidateStructure();
+}
+
+const glm::mat4& TransformHierarchy::worldAt(int index) { return world[index]; }
+
+unsigned int TransformHierarchy::getNumNodes() const { return (unsigned int)local.size(); }
+
+Node* TransformHierarchy::getRoot() const { return root; }
+
+unsigned int TransformHierarchy::getLastUpdateCount() const { return lastUpdateCount; }
@@ -0,0 +1,131 @@
+/**
+ * @file transformHierarchy.h
+ * @brief Gerarchia di trasformazioni in array contigui, aggiornata con un'unica passata lineare.
+ */
+#pragma once
+#include "libConfig.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Node;
+
+/**
+ * @class TransformHierarchy
+ * @brief Copia le matrici locali di un sottoalbero di nodi in array piatti ordinati in pre-ordine
+ * (ogni genitore precede i propri figli) e ne calcola le matrici mondo in una sola passata.
+ *
+ * Dopo build() i nodi restano l'interfaccia verso la scena: Node::setM(), translate() e simili
+ * aggiornano la copia nella gerarchia e segnano la voce come modificata, mentre
+ * Node::getWorldFinalMatrix() legge la matrice mondo dall'array, eseguendo prima update() se
+ * qualcosa e' cambiato. Durante update() vengono ricalcolate solo le voci modificate e i loro
+ * discendenti, senza seguire i puntatori dei nodi. Aggiungere o rimuovere figli a un nodo della
+ * gerarchia fa ricostruire gli array al successivo update().
+ *
+ * @note Non thread-safe: le interrogazioni possono aggiornare gli array.
+ */
+class ENG_API TransformHierarchy {
+public:
+   /**
+    * @brief Costruisce una gerarchia vuota.
+    */
+   TransformHierarchy();
+
+   /**
+    * @brief Distruttore: scollega tutti i nodi, che tornano a gestire da soli le proprie matrici.
+    */
+   ~TransformHierarchy();
+
+   TransformHierarchy(const TransformHierarchy&) = delete;
+   TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+   /**
+    * @brief Collega alla gerarchia il sottoalbero con radice indicata (sostituendo quello precedente).
+    * @param root Radice del sottoalbero; il suo eventuale genitore resta esterno alla gerarchia.
+    */
+   void build(Node* root);
+
+   /**
+    * @brief Scollega tutti i nodi e svuota la gerarchia.
+    */
+   void clear();
+
+   /**
+    * @brief Ricalcola le matrici mondo delle voci modificate (e ricostruisce gli array se la struttura e' cambiata).
+    */
+   void update();
+
+   /**
+    * @brief Restituisce il numero di nodi collegati.
+    */
+   unsigned int getNumNodes() const;
+
+   /**
+    * @brief Restituisce la radice del sottoalbero collegato (nullptr se vuota).
+    */
+   Node* getRoot() const;
+
+   /**
+    * @brief Restituisce quante matrici mondo sono state ricalcolate dall'ultimo update().
+    */
+   unsigned int getLastUpdateCount() const;
+
+   /**
+    * @brief Nodi collegati in pre-ordine (nullptr per quelli distrutti), paralleli a getWorldMatrices().
+    */
+   const std::vector<Node*>& getNodes() const;
+
+   /**
+    * @brief Matrici mondo in pre-ordine, aggiornate all'ultimo update().
+    */
+   const std::vector<glm::mat4>& getWorldMatrices() const;
+
+   /**
+    * @brief Prodotto tra matrici 4x4 (out = a * b), vettorizzato con SSE dove disponibile.
+    * @param a Matrice a sinistra.
+    * @param b Matrice a destra.
+    * @param out Risultato (non deve coincidere con a o b).
+    */
+   static void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out);
+
+private:
+   friend class Node;
+
+   /** @brief Visita in pre-ordine che assegna gli indici ai nodi. */
+   void append(Node* node, int32_t parentIndex);
+   /** @brief Scollega i nodi senza toccare la radice registrata. */
+   void unbindAll();
+   /** @brief Aggiorna la matrice locale di una voce e la segna come modificata. */
+   void setLocal(int index, const glm::mat4& matrix);
+   /** @brief Segna una voce come modificata (la matrice mondo del genitore esterno e' cambiata). */
+   void markDirty(int index);
+   /** @brief Richiede la ricostruzione degli array al prossimo update(). */
+   void invalidateStructure();
+   /** @brief Rimuove un nodo in distruzione. */
+   void detachNode(Node* node);
+   /** @brief Matrice mondo aggiornata di una voce. */
+   const glm::mat4& worldAt(int index);
+
+   /** @brief Radice del sottoalbero collegato. */
+   Node* root = nullptr;
+
+   /** @brief Matrici locali, in pre-ordine. */
+   std::vector<glm::mat4> local;
+   /** @brief Matrici mondo, in pre-ordine. */
+   std::vector<glm::mat4> world;
+   /** @brief Indice del genitore di ogni voce (-1 per la radice). */
+   std::vector<int32_t> parent;
+   /** @brief Voci modificate dall'ultimo update(). */
+   std::vector<uint8_t> dirty;
+   /** @brief Nodo associato a ogni voce (nullptr se distrutto). */
+   std::vector<Node*> nodes;
+
+   /** @brief Prima voce modificata: quelle precedenti non vanno ricalcolate. */
+   size_t firstDirty = 0;
+   /** @brief True se almeno una voce e' stata modificata. */
+   bool pending = false;
+   /** @brief True se gli array vanno ricostruiti. */
+   bool structureDirty = false;
+   /** @brief Matrici ricalcolate nell'ultimo update(). */
+   unsigned int lastUpdateCount = 0;
+};
@@ -0,0 +1,269 @@
+#include "triangleBvh.h"
+#include "boundingBox.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file triangleBvh.cpp
+ * @brief Implementazione della classe TriangleBvh.
+ */
+
+namespace {
+
+   /** @brief Intervalli per asse usati per valutare i piani di divisione. */
+   constexpr int NUM_BINS = 12;
+   /** @brief Profondita' oltre la quale un nodo diventa comunque foglia (limita lo stack di visita). */
+   constexpr unsigned int MAX_DEPTH = 64;
+   /** @brief Oltre questo numero di triangoli si divide anche se la SAH non lo consiglia. */
+   constexpr unsigned int MAX_UNSPLIT_TRIANGLES = 16;
+
+   struct Bounds {
+      glm::vec3 min{ std::numeric_limits<float>::max() };
+      glm::vec3 max{ -std::numeric_limits<float>::max() };
+
+      void expand(const glm::vec3& point) {
+         min = glm::min(min, point);
+         max = glm::max(max, point);
+      }
+      void expand(const Bounds& other) {
+         min = glm::min(min, other.min);
+         max = glm::max(max, other.max);
+      }
+      float area() const {
+         glm::vec3 size = glm::max(max - min, glm::vec3(0.0f));
+         return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+      }
+   };
+
+   /** @brief Distanza di ingresso in una scatola, o false se il raggio la manca entro maxDistance. */
+   inline bool slab(const glm::vec3& min, const glm::vec3& max, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                    float maxDistance, float& distance) {
+      glm::vec3 t0 = (min - origin) * inverseDirection;
+      glm::vec3 t1 = (max - origin) * inverseDirection;
+      glm::vec3 tNear = glm::min(t0, t1);
+      glm::vec3 tFar = glm::max(t0, t1);
+      float enter = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+      float exit = glm::min(glm::min(tFar.x, tFar.y), glm::min(tFar.z, maxDistance));
+      distance = enter;
+      return enter <= exit;
+   }
+
+}
+
+TriangleBvh::TriangleBvh(std::pmr::memory_resource* resource)
+   : nodes(resource), triangles(resource), faceOf(resource)
+{
+}
+
+void TriangleBvh::clear() {
+   nodes.clear();
+   nodes.shrink_to_fit();
+   triangles.clear();
+   triangles.shrink_to_fit();
+   faceOf.clear();
+   faceOf.shrink_to_fit();
+   depth = 0;
+}
+
+void TriangleBvh::build(const std::pmr::vector<glm::vec3>& vertices, const std::pmr::vector<std::pmr::vector<unsigned int>>& faces) {
+   clear();
+
+   // Triangoli a ventaglio per ogni faccia, con scatola e baricentro usati solo durante la costruzione
+   std::vector<Triangle> source;
+   std::vector<uint32_t> sourceFace;
+   std::vector<Bounds> boxes;
+   std::vector<glm::vec3> centroids;
+   const unsigned int numVertices = (unsigned int)vertices.size();
+   for (uint32_t f = 0; f < faces.size(); f++) {
+      const auto& face = faces[f];
+      for (size_t i = 2; i < face.size(); i++) {
+         if (face[0] >= numVertices || face[i - 1] >= numVertices || face[i] >= numVertices) continue;
+         const glm::vec3& a = vertices[face[0]];
+         const glm::vec3& b = vertices[face[i - 1]];
+         const glm::vec3& c = vertices[face[i]];
+         source.push_back({ a, b - a, c - a });
+         sourceFace.push_back(f);
+         Bounds box;
+         box.expand(a);
+         box.expand(b);
+         box.expand(c);
+         boxes.push_back(box);
+         centroids.push_back((a + b + c) / 3.0f);
+      }
+   }
+   const uint32_t count = (uint32_t)source.size();
+   if (count == 0) return;
+
+   std::vector<uint32_t> order(count);
+   for (uint32_t i = 0; i < count; i++) order[i] = i;
+
+   auto setBounds = [&](BvhNode& node) {
+      Bounds bounds;
+      for (uint32_t i = node.first; i < node.first + node.count; i++) bounds.expand(boxes[order[i]]);
+      node.min = bounds.min;
+      node.max = bounds.max;
+   };
+
+   // Un albero binario con foglie non vuote ha al massimo 2n - 1 nodi: nessuna riallocazione
+   nodes.reserve(2 * count - 1);
+   nodes.push_back({ glm::vec3(0.0f), 0, glm::vec3(0.0f), count });
+   setBounds(nodes[0]);
+
+   struct Task { uint32_t node; unsigned int depth; };
+   std::vector<Task> tasks{ { 0, 1 } };
+   while (!tasks.empty()) {
+      Task task = tasks.back();
+      tasks.pop_back();
+      depth = std::max(depth, task.depth);
+
+      const uint32_t first = nodes[task.node].first;
+      const uint32_t n = nodes[task.node].count;
+      if (n <= MAX_LEAF_TRIANGLES || task.depth >= MAX_DEPTH) continue;
+
+      Bounds centroidBounds;
+      for (uint32_t i = first; i < first + n; i++) centroidBounds.expand(centroids[order[i]]);
+
+      // SAH a intervalli: per ogni asse si valutano i NUM_BINS - 1 piani tra gli intervalli
+      float bestCost = std::numeric_limits<float>::max();
+      int bestAxis = -1;
+      int bestSplit = 0;
+      for (int axis = 0; axis < 3; axis++) {
+         float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+         if (extent <= 0.0f) continue;
+         float scale = NUM_BINS / extent;
+
+         Bounds binBounds[NUM_BINS];
+         uint32_t binCount[NUM_BINS] = {};
+         for (uint32_t i = first; i < first + n; i++) {
+            uint32_t t = order[i];
+            int bin = std::min(NUM_BINS - 1, (int)((centroids[t][axis] - centroidBounds.min[axis]) * scale));
+            binCount[bin]++;
+            binBounds[bin].expand(boxes[t]);
+         }
+
+         float leftArea[NUM_BINS - 1];
+         uint32_t leftCount[NUM_BINS - 1];
+         Bounds accumulated;
+         uint32_t accumulatedCount = 0;
+         for (int i = 0; i < NUM_BINS - 1; i++) {
+            accumulated.expand(binBounds[i]);
+            accumulatedCount += binCount[i];
+            leftArea[i] = accumulated.area();
+            leftCount[i] = accumulatedCount;
+         }
+         accumulated = Bounds();
+         accumulatedCount = 0;
+         for (int i = NUM_BINS - 1; i > 0; i--) {
+            accumulated.expand(binBounds[i]);
+            accumulatedCount += binCount[i];
+            float cost = leftCount[i - 1] * leftArea[i - 1] + accumulatedCount * accumulated.area();
+            if (leftCount[i - 1] > 0 && accumulatedCount > 0 && cost < bestCost) {
+               bestCost = cost;
+               bestAxis = axis;
+               bestSplit = i - 1;
+            }
+         }
+      }
+
+      if (bestAxis < 0) continue; // baricentri coincidenti: non divisibile
+      Bounds nodeBounds{ nodes[task.node].min, nodes[task.node].max };
+      if (bestCost >= n * nodeBounds.area() && n <= MAX_UNSPLIT_TRIANGLES) continue;
+
+      float minCentroid = centroidBounds.min[bestAxis];
+      float scale = NUM_BINS / (centroidBounds.max[bestAxis] - minCentroid);
+      uint32_t* middle = std::partition(order.data() + first, order.data() + first + n, [&](uint32_t t) {
+         return std::min(NUM_BINS - 1, (int)((centroids[t][bestAxis] - minCentroid) * scale)) <= bestSplit;
+      });
+      uint32_t leftCount = (uint32_t)(middle - (order.data() + first));
+
+      uint32_t left = (uint32_t)nodes.size();
+      nodes.push_back({ glm::vec3(0.0f), first, glm::vec3(0.0f), leftCount });
+      nodes.push_back({ glm::vec3(0.0f), first + leftCount, glm::vec3(0.0f), n - leftCount });
+      setBounds(nodes[left]);
+      setBounds(nodes[left + 1]);
+      nodes[task.node].first = left;
+      nodes[task.node].count = 0;
+      tasks.push_back({ left, task.depth + 1 });
+      tasks.push_back({ left + 1, task.depth + 1 });
+   }
+
+   // Triangoli nell'ordine delle foglie
+   triangles.reserve(count);
+   faceOf.reserve(count);
+   for (uint32_t t : order) {
+      triangles.push_back(source[t]);
+      faceOf.push_back(sourceFace[t]);
+   }
+}
+
+bool TriangleBvh::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                          float& distance, unsigned int& face) const {
+   if (nodes.empty()) return false;
+
+   const glm::vec3 inverseDirection = BoundingBox::inverseDirection(direction);
+   float best = maxDistance;
+   bool found = false;
+
+   float entry;
+   if (!slab(nodes[0].min, nodes[0].max, origin, inverseDirection, best, entry)) return false;
+
+   struct Entry { uint32_t node; float distance; };
+   Entry stack[MAX_DEPTH * 2];
+   int top = 0;
+   stack[top++] = { 0, entry };
+   while (top > 0) {
+      Entry current = stack[--top];
+      if (current.distance > best) continue;
+      const BvhNode& node = nodes[current.node];
+
+      if (node.count > 0) {
+         // Moller-Trumbore, senza scartare le facce posteriori
+         for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            const Triangle& tri = triangles[i];
+            glm::vec3 p = glm::cross(direction, tri.edge2);
+            float det = glm::dot(tri.edge1, p);
+            if (std::abs(det) < 1e-12f) continue;
+            float inverseDet = 1.0f / det;
+            glm::vec3 s = origin - tri.v0;
+            float u = glm::dot(s, p) * inverseDet;
+            if (u < 0.0f || u > 1.0f) continue;
+            glm::vec3 q = glm::cross(s, tri.edge1);
+            float v = glm::dot(direction, q) * inverseDet;
+            if (v < 0.0f || u + v > 1.0f) continue;
+            float t = glm::dot(tri.edge2, q) * inverseDet;
+            if (t >= 0.0f && t < best) {
+               best = t;
+               face = faceOf[i];
+               found = true;
+            }
+         }
+         continue;
+      }
+
+      float leftDistance, rightDistance;
+      bool hitLeft = slab(nodes[node.first].min, nodes[node.first].max, origin, inverseDirection, best, leftDistance);
+      bool hitRight = slab(nodes[node.first + 1].min, nodes[node.first + 1].max, origin, inverseDirection, best, rightDistance);
+      // Il piu' vicino va in cima allo stack
+      if (hitLeft && hitRight) {
+         if (leftDistance < rightDistance) {
+            stack[top++] = { node.first + 1, rightDistance };
+            stack[top++] = { node.first, leftDistance };
+         }
+         else {
+            stack[top++] = { node.first, leftDistance };
+            stack[top++] = { node.first + 1, rightDistance };
+         }
+      }
+      else if (hitLeft) stack[top++] = { node.first, leftDistance };
+      else if (hitRight) stack[top++] = { node.first + 1, rightDistance };
+   }
+
+   if (found) distance = best;
+   return found;
+}
+
+unsigned int TriangleBvh::getNumTriangles() const { return (unsigned int)triangles.size(); }
+
+unsigned int TriangleBvh::getNumNodes() const { return (unsigned int)nodes.size(); }
+
+unsigned int TriangleBvh::getDepth() const { return depth; }
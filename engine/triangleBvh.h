@@ -0,0 +1,101 @@
+/**
+ * @file triangleBvh.h
+ * @brief Gerarchia di volumi di contenimento sui triangoli di una mesh.
+ */
+#pragma once
+#include "libConfig.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class TriangleBvh
+ * @brief BVH statica sui triangoli di una mesh, nello spazio locale, per intersezioni raggio-triangolo.
+ *
+ * Costruita una volta con l'euristica dell'area superficiale (SAH) a intervalli: i nodi sono in un
+ * array piatto con i due figli adiacenti, e i triangoli sono riordinati in modo che ogni foglia ne
+ * copra un intervallo contiguo, gia' nella forma (vertice, spigolo, spigolo) usata dal test di
+ * Moller-Trumbore. Un raggio visita in media un numero di nodi logaritmico nei triangoli.
+ */
+class ENG_API TriangleBvh {
+public:
+   /** @brief Numero massimo di triangoli in una foglia. */
+   static constexpr unsigned int MAX_LEAF_TRIANGLES = 4;
+
+   /**
+    * @brief Costruisce una BVH vuota.
+    * @param resource Memoria da cui allocare nodi e triangoli (es. quella della mesh).
+    */
+   explicit TriangleBvh(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+   /**
+    * @brief Costruisce la gerarchia sui triangoli delle facce (i poligoni sono divisi a ventaglio).
+    * @param vertices Posizioni dei vertici.
+    * @param faces Indici dei vertici di ogni faccia (gli indici fuori intervallo sono ignorati).
+    */
+   void build(const std::pmr::vector<glm::vec3>& vertices, const std::pmr::vector<std::pmr::vector<unsigned int>>& faces);
+
+   /**
+    * @brief Libera nodi e triangoli.
+    */
+   void clear();
+
+   /**
+    * @brief Cerca il triangolo piu' vicino attraversato da un raggio.
+    * @param origin Origine del raggio.
+    * @param direction Direzione del raggio (le distanze sono in multipli della sua lunghezza).
+    * @param maxDistance Distanza massima considerata.
+    * @param distance Distanza del punto colpito.
+    * @param face Faccia a cui appartiene il triangolo colpito.
+    * @return True se un triangolo e' stato colpito entro maxDistance.
+    */
+   bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                float& distance, unsigned int& face) const;
+
+   /**
+    * @brief Restituisce il numero di triangoli.
+    */
+   unsigned int getNumTriangles() const;
+
+   /**
+    * @brief Restituisce il numero di nodi.
+    */
+   unsigned int getNumNodes() const;
+
+   /**
+    * @brief Restituisce la profondita' massima (1 per una sola foglia, 0 se vuota).
+    */
+   unsigned int getDepth() const;
+
+private:
+   /**
+    * @struct BvhNode
+    * @brief Nodo di 32 byte: scatola e intervallo di triangoli (foglia) o indice del primo figlio.
+    */
+   struct BvhNode {
+      glm::vec3 min;
+      /** @brief Primo triangolo (foglia) o figlio sinistro; il destro e' il successivo. */
+      uint32_t first;
+      glm::vec3 max;
+      /** @brief Numero di triangoli, 0 per i nodi interni. */
+      uint32_t count;
+   };
+
+   /**
+    * @struct Triangle
+    * @brief Triangolo pronto per l'intersezione: primo vertice e due spigoli.
+    */
+   struct Triangle {
+      glm::vec3 v0;
+      glm::vec3 edge1;
+      glm::vec3 edge2;
+   };
+
+   std::pmr::vector<BvhNode> nodes;
+   std::pmr::vector<Triangle> triangles;
+   /** @brief Faccia di origine di ogni triangolo. */
+   std::pmr::vector<uint32_t> faceOf;
+   unsigned int depth = 0;
+};
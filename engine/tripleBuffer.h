@@ -0,0 +1,66 @@
+/**
+ * @file tripleBuffer.h
+ * @brief Passaggio senza lock dell'ultimo dato prodotto da un thread a un altro.
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Tre copie di T: una scritta dal produttore, una letta dal consumatore e una in mezzo.
+ *
+ * Il produttore riempie getWriteBuffer() e lo pubblica con publish(), che lo scambia con la copia
+ * di mezzo con un solo exchange atomico; il consumatore con getReadBuffer() prende la copia di mezzo
+ * solo se e' stata pubblicata dopo l'ultima lettura. Nessuno dei due aspetta l'altro: il produttore
+ * non tocca mai la copia in lettura e il consumatore ottiene sempre l'ultima copia completa
+ * (quelle intermedie non lette vengono sovrascritte).
+ *
+ * @note Un solo produttore e un solo consumatore. Le copie vengono riutilizzate: chi scrive deve
+ * svuotare o sovrascrivere il contenuto precedente.
+ */
+template <class T>
+class TripleBuffer {
+public:
+   /**
+    * @brief Copia che il produttore sta scrivendo.
+    */
+   T& getWriteBuffer() { return buffers[back]; }
+
+   /**
+    * @brief Rende disponibile al consumatore la copia scritta e passa a scriverne un'altra.
+    */
+   void publish() {
+      // release: il contenuto scritto e' visibile a chi ottiene la copia con l'exchange del consumatore
+      uint8_t old = middle.exchange((uint8_t)(back | FRESH), std::memory_order_acq_rel);
+      back = old & INDEX;
+   }
+
+   /**
+    * @brief Ultima copia pubblicata (o la stessa della lettura precedente se non ce ne sono di nuove).
+    */
+   T& getReadBuffer() {
+      if (middle.load(std::memory_order_relaxed) & FRESH) {
+         uint8_t old = middle.exchange(front, std::memory_order_acq_rel);
+         front = old & INDEX;
+      }
+      return buffers[front];
+   }
+
+   /**
+    * @brief Indica se c'e' una copia pubblicata non ancora letta.
+    */
+   bool hasNew() const { return (middle.load(std::memory_order_acquire) & FRESH) != 0; }
+
+private:
+   static constexpr uint8_t INDEX = 0x3;
+   static constexpr uint8_t FRESH = 0x4;
+
+   T buffers[3];
+   /** @brief Indice della copia di mezzo, con FRESH se pubblicata e non ancora letta. */
+   std::atomic<uint8_t> middle{ 2 };
+   /** @brief Copia del produttore (usata solo dal suo thread). */
+   uint8_t back = 0;
+   /** @brief Copia del consumatore (usata solo dal suo thread). */
+   uint8_t front = 1;
+};